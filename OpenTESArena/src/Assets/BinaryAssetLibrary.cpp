@@ -1,4 +1,5 @@
 #include <cstdio>
+#include <future>
 
 #include "BinaryAssetLibrary.h"
 #include "MIFUtils.h"
@@ -345,13 +346,31 @@ bool BinaryAssetLibrary::init(bool floppyVersion)
 {
 	DebugLog("Initializing binary assets.");
 	bool success = this->initExecutableData(floppyVersion);
-	success &= this->initCityBlockMifs();
+
+	// Everything else only needs the executable data (if anything), so the larger file sets are read on
+	// worker threads while the smaller ones are read here.
+	std::future<bool> cityBlockMifsFuture = std::async(std::launch::async, [this]()
+	{
+		return this->initCityBlockMifs();
+	});
+
+	std::future<bool> wildernessChunksFuture = std::async(std::launch::async, [this]()
+	{
+		return this->initWildernessChunks();
+	});
+
+	std::future<bool> worldMapDefsFuture = std::async(std::launch::async, [this]()
+	{
+		return this->initWorldMapDefs();
+	});
+
 	success &= this->initClasses(this->exeData);
 	success &= this->initStandardSpells();
-	success &= this->initWildernessChunks();
-	success &= this->initWorldMapDefs();
 	success &= this->initWorldMapMasks();
 	success &= this->initWorldMapTerrain();
+	success &= cityBlockMifsFuture.get();
+	success &= wildernessChunksFuture.get();
+	success &= worldMapDefsFuture.get();
 	return true;
 }
 
@@ -12,8 +12,8 @@
 
 bool CFAFile::init(const char *filename)
 {
-	Buffer<std::byte> src;
-	if (!VFS::Manager::get().read(filename, &src))
+	VFS::FileView src;
+	if (!VFS::Manager::get().readView(filename, &src))
 	{
 		DebugLogError("Could not read \"" + std::string(filename) + "\".");
 		return false;
@@ -29,8 +29,8 @@ bool CIFFile::init(const char *filename)
 	// Some filenames (i.e., Arrows.cif) have different casing between the floppy version and
 	// CD version, so this needs to use the case-insensitive open() method for correct behavior
 	// on Unix-based systems.
-	Buffer<std::byte> src;
-	if (!VFS::Manager::get().readCaseInsensitive(filename, &src))
+	VFS::FileView src;
+	if (!VFS::Manager::get().readViewCaseInsensitive(filename, &src))
 	{
 		DebugLogError("Could not read \"" + std::string(filename) + "\".");
 		return false;
@@ -78,8 +78,8 @@ const CityDataFile::ProvinceData &CityDataFile::getProvinceData(int index) const
 
 bool CityDataFile::init(const char *filename)
 {
-	Buffer<std::byte> src;
-	if (!VFS::Manager::get().read(filename, &src))
+	VFS::FileView src;
+	if (!VFS::Manager::get().readView(filename, &src))
 	{
 		DebugLogError("Could not read \"" + std::string(filename) + "\".");
 		return false;
@@ -5,43 +5,31 @@
 
 void Compression::decodeRLE(const uint8_t *src, int stopCount, uint8_t *dst, int dstSize)
 {
-	// Adapted from WinArena.
-	int i = 0;
+	// Adapted from WinArena. Bounds are checked once per packet so each run can be copied in bulk.
 	int o = 0;
 
 	while (o < stopCount)
 	{
-		const uint8_t sample = src[i];
-		src++;
+		const uint8_t sample = *(src++);
 
 		// Is the selected byte part of a compressed packet?
 		if ((sample & 0x80) != 0)
 		{
-			const uint8_t value = src[i];
-			src++;
-
-			const uint32_t count = static_cast<uint32_t>(sample) - 0x7F;
+			const uint8_t value = *(src++);
+			const int count = static_cast<int>(sample) - 0x7F;
 
-			DebugAssert(o >= 0);
-			DebugAssert((o + static_cast<int>(count)) <= dstSize);
-			for (uint32_t j = 0; j < count; j++)
-			{
-				dst[o] = value;
-				o++;
-			}
+			DebugAssert((o + count) <= dstSize);
+			std::fill(dst + o, dst + o + count, value);
+			o += count;
 		}
 		else
 		{
-			const uint32_t count = static_cast<uint32_t>(sample) + 1;
+			const int count = static_cast<int>(sample) + 1;
 
-			DebugAssert(o >= 0);
-			DebugAssert((o + static_cast<int>(count)) <= dstSize);
-			for (uint32_t j = 0; j < count; j++)
-			{
-				dst[o] = src[i];
-				o++;
-				i++;
-			}
+			DebugAssert((o + count) <= dstSize);
+			std::copy(src, src + count, dst + o);
+			src += count;
+			o += count;
 		}
 	}
 }
@@ -51,6 +39,8 @@ void Compression::decodeRLEWords(const uint8_t *src, int stopCount,
 {
 	int i = 0;
 	int o = 0;
+	uint8_t *dst = out.data();
+	const int dstWordCount = static_cast<int>(out.size() / 2);
 
 	while (o < stopCount)
 	{
@@ -61,29 +51,32 @@ void Compression::decodeRLEWords(const uint8_t *src, int stopCount,
 		// repeat the next word "sample" times.
 		if (sample > 0)
 		{
-			for (int16_t j = 0; j < sample; j++)
-			{
-				const uint16_t value = Bytes::getLE16(src + i);
-				i += 2;
-
-				out.at(o * 2) = value & 0x00FF;
-				out.at((o * 2) + 1) = (value & 0xFF00) >> 8;
-				o++;
-			}
+			// Literal words are already little-endian in the source, so they can be copied as bytes.
+			const int count = sample;
+			DebugAssert((o + count) <= dstWordCount);
+			std::copy(src + i, src + i + (count * 2), dst + (o * 2));
+			i += count * 2;
+			o += count;
 		}
 		else
 		{
 			const uint16_t value = Bytes::getLE16(src + i);
 			i += 2;
 
-			const uint16_t count = -sample;
+			const uint8_t lowByte = value & 0x00FF;
+			const uint8_t highByte = (value & 0xFF00) >> 8;
+			const int count = static_cast<uint16_t>(-sample);
+			DebugAssert((o + count) <= dstWordCount);
 
-			for (uint16_t j = 0; j < count; j++)
+			uint8_t *dstPtr = dst + (o * 2);
+			for (int j = 0; j < count; j++)
 			{
-				out.at(o * 2) = value & 0x00FF;
-				out.at((o * 2) + 1) = (value & 0xFF00) >> 8;
-				o++;
+				dstPtr[0] = lowByte;
+				dstPtr[1] = highByte;
+				dstPtr += 2;
 			}
+
+			o += count;
 		}
 	}
 }
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <iterator>
 #include <numeric>
 #include <vector>
 
@@ -20,14 +21,45 @@ namespace Compression
 	// Uncompresses an RLE run of words. Used with .RMD files.
 	void decodeRLEWords(const uint8_t *src, int stopCount, std::vector<uint8_t> &out);
 
+	// Size of the sliding window that back-references in type 4 and type 8 data point into.
+	constexpr int HISTORY_SIZE = 4096;
+	constexpr int HISTORY_MASK = HISTORY_SIZE - 1;
+
+	// Copies a back-reference from the history window to the output, also appending it to the history.
+	// Copies in bulk when neither range wraps and the source isn't overwritten while copying.
+	inline void copyFromHistory(uint8_t *history, int copypos, int historypos, int count, uint8_t *dst)
+	{
+		const int copyStart = copypos & HISTORY_MASK;
+		const int historyStart = historypos & HISTORY_MASK;
+		const int distance = (historyStart - copyStart) & HISTORY_MASK;
+		const bool canCopyInBulk = ((distance == 0) || (distance >= count)) &&
+			((copyStart + count) <= HISTORY_SIZE) && ((historyStart + count) <= HISTORY_SIZE);
+
+		if (canCopyInBulk)
+		{
+			std::copy(history + copyStart, history + copyStart + count, dst);
+			std::copy(dst, dst + count, history + historyStart);
+		}
+		else
+		{
+			for (int i = 0; i < count; i++)
+			{
+				const uint8_t value = history[(copypos + i) & HISTORY_MASK];
+				dst[i] = value;
+				history[(historypos + i) & HISTORY_MASK] = value;
+			}
+		}
+	}
+
 	// Works with .IMG and .CIF type 4 files.
 	template <typename T>
 	void decodeType04(T src, T srcend, std::vector<uint8_t> &out)
 	{
-		auto dst = out.begin();
+		uint8_t *dst = out.data();
+		uint8_t *dstEnd = dst + out.size();
 
-		std::array<uint8_t, 4096> history;
-		history.fill(0x20);
+		uint8_t history[HISTORY_SIZE];
+		std::fill(std::begin(history), std::end(history), 0x20);
 		int historypos = 0;
 
 		// This appears to be some form of LZ compression. It starts with a 1-byte-
@@ -52,33 +84,33 @@ namespace Compression
 			if ((mask & 1))
 			{
 				DebugAssertMsg(src != srcend, "Unexpected end of image.");
-				DebugAssertMsg(dst != out.end(), "Decoded image overflow.");
+				DebugAssertMsg(dst != dstEnd, "Decoded image overflow.");
 
-				history[historypos++ & 0x0FFF] = *src;
-				*(dst++) = *(src++);
+				const uint8_t value = *(src++);
+				history[historypos++ & HISTORY_MASK] = value;
+				*(dst++) = value;
 			}
 			else
 			{
 				DebugAssertMsg(std::distance(src, srcend) >= 2, "Unexpected end of image.");
 
-				uint8_t byte1 = *(src++);
-				uint8_t byte2 = *(src++);
-				int tocopy = (byte2 & 0x0F) + 3;
-				int copypos = (((byte2 & 0xF0) << 4) | byte1) + 18;
+				const uint8_t byte1 = *(src++);
+				const uint8_t byte2 = *(src++);
+				const int tocopy = (byte2 & 0x0F) + 3;
+				const int copypos = (((byte2 & 0xF0) << 4) | byte1) + 18;
 
-				DebugAssertMsg(std::distance(dst, out.end()) >= tocopy, "Decoded image overflow.");
+				// Bounds are checked once per back-reference so the copy itself is unchecked.
+				DebugAssertMsg((dstEnd - dst) >= tocopy, "Decoded image overflow.");
 
-				for (int i = 0; i < tocopy; i++)
-				{
-					*dst = history[copypos++ & 0x0FFF];
-					history[historypos++ & 0x0FFF] = *(dst++);
-				}
+				copyFromHistory(history, copypos, historypos, tocopy, dst);
+				dst += tocopy;
+				historypos += tocopy;
 			}
 
 			bitcount--;
 		}
 
-		std::fill(dst, out.end(), 0);
+		std::fill(dst, dstEnd, 0);
 	}
 
 	// Works with type 8 .IMG and .CIF files, and voxel data in .MIF files.
@@ -125,31 +157,36 @@ namespace Compression
 			0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08
 		};
 
-		std::array<uint8_t, 4096> history;
-		history.fill(0x20);
+		uint8_t history[HISTORY_SIZE];
+		std::fill(std::begin(history), std::end(history), 0x20);
 		int historypos = 0;
 
-		std::array<uint16_t, 941> NodeIdxMap;
-		std::iota(NodeIdxMap.begin(), NodeIdxMap.begin() + 626, 0);
-		std::for_each(NodeIdxMap.begin(), NodeIdxMap.begin() + 626,
+		// Adaptive Huffman tree. Leaf nodes are >= 627, and every index below is in range by construction
+		// so the hot loops don't need bounds checks.
+		constexpr uint16_t leafStart = 627;
+		constexpr int nodeCount = 627;
+
+		uint16_t NodeIdxMap[941];
+		std::iota(NodeIdxMap, NodeIdxMap + 626, 0);
+		std::for_each(NodeIdxMap, NodeIdxMap + 626,
 			[](uint16_t &val) { val = (val >> 1) + 314; }
 		);
 
 		NodeIdxMap[626] = 0;
-		std::iota(NodeIdxMap.begin() + 627, NodeIdxMap.end(), 0);
+		std::iota(NodeIdxMap + 627, std::end(NodeIdxMap), 0);
 
-		std::array<uint16_t, 627> NodeTree;
-		std::iota(NodeTree.begin(), NodeTree.begin() + 314, 627);
-		std::iota(NodeTree.begin() + 314, NodeTree.end(), 0);
-		std::for_each(NodeTree.begin() + 314, NodeTree.end(),
+		uint16_t NodeTree[nodeCount];
+		std::iota(NodeTree, NodeTree + 314, 627);
+		std::iota(NodeTree + 314, std::end(NodeTree), 0);
+		std::for_each(NodeTree + 314, std::end(NodeTree),
 			[](uint16_t &val) { val *= 2; }
 		);
 
-		std::array<uint16_t, 627> NodeFreq;
-		std::fill(NodeFreq.begin(), NodeFreq.begin() + 314, 1);
+		uint16_t NodeFreq[nodeCount];
+		std::fill(NodeFreq, NodeFreq + 314, 1);
 		{
-			auto iter = NodeFreq.begin();
-			std::for_each(NodeFreq.begin() + 314, NodeFreq.begin() + 627,
+			const uint16_t *iter = NodeFreq;
+			std::for_each(NodeFreq + 314, std::end(NodeFreq),
 				[&iter](uint16_t &val)
 			{
 				val = *(iter++);
@@ -157,47 +194,54 @@ namespace Compression
 			});
 		}
 
-		uint16_t bitmask = 0;
-		uint8_t validbits = 0;
+		// Input bits are read MSB-first from the top of a 32-bit buffer that's refilled a byte at a time
+		// until at least 25 bits are available. Past the end of the input, zeros are shifted in.
+		uint32_t bitbuffer = 0;
+		int validbits = 0;
+		auto refillBits = [&src, &srcend, &bitbuffer, &validbits]()
+		{
+			while (validbits <= 24)
+			{
+				const uint32_t byte = (src != srcend) ? static_cast<uint8_t>(*(src++)) : 0;
+				bitbuffer |= byte << (24 - validbits);
+				validbits += 8;
+			}
+		};
 
 		// This feels like some form of adaptive Huffman coding, with a form of LZ
 		// compression. DEFLATE?
-		auto dst = out.begin();
-		while (dst != out.end())
+		uint8_t *dst = out.data();
+		uint8_t *dstEnd = dst + out.size();
+		while (dst != dstEnd)
 		{
 			// Starting with the root, append bits from the input while traversing
 			// the tree until a leaf node is found (indicated by being >= 627).
 			uint16_t node = NodeTree[626];
-			while (node < 627)
+			while (node < leafStart)
 			{
-				while (validbits < 9)
+				if (validbits == 0)
 				{
-					if (src != srcend)
-					{
-						bitmask |= *(src++) << (8 - validbits);
-					}
-
-					validbits += 8;
+					refillBits();
 				}
 
-				node = NodeTree.at(node + ((bitmask >> 15) & 1));
-				bitmask <<= 1;
+				node = NodeTree[node + (bitbuffer >> 31)];
+				bitbuffer <<= 1;
 				validbits--;
 			}
 
 			// Increment the use count (frequency) of this node, and ensure the
 			// tree remains sorted.
-			uint16_t freqidx = NodeIdxMap.at(node);
+			uint16_t freqidx = NodeIdxMap[node];
 			do {
-				NodeFreq.at(freqidx) += 1;
-				uint16_t freq = NodeFreq[freqidx];
+				NodeFreq[freqidx] += 1;
+				const uint16_t freq = NodeFreq[freqidx];
 				uint16_t nextidx = freqidx + 1;
-				if (nextidx < NodeFreq.size() && NodeFreq[nextidx] < freq)
+				if (nextidx < nodeCount && NodeFreq[nextidx] < freq)
 				{
 					// Find the next frequency count that's not greater than the new frequency.
 					do {
 						nextidx++;
-					} while (nextidx < NodeFreq.size() && NodeFreq[nextidx] < freq);
+					} while (nextidx < nodeCount && NodeFreq[nextidx] < freq);
 					nextidx--;
 
 					// Swap 'em, placing the new frequency just before the next
@@ -206,19 +250,19 @@ namespace Compression
 					NodeFreq[freqidx] = NodeFreq[nextidx];
 					NodeFreq[nextidx] = freq;
 
-					std::iter_swap(NodeTree.begin() + freqidx, NodeTree.begin() + nextidx);
+					std::swap(NodeTree[freqidx], NodeTree[nextidx]);
 
 					// Update the index mappings
 					uint16_t mapidx = NodeTree[nextidx];
-					NodeIdxMap.at(mapidx) = nextidx;
-					if (mapidx < 627)
+					NodeIdxMap[mapidx] = nextidx;
+					if (mapidx < leafStart)
 					{
 						NodeIdxMap[mapidx + 1] = nextidx;
 					}
 
 					mapidx = NodeTree[freqidx];
-					NodeIdxMap.at(mapidx) = freqidx;
-					if (mapidx < 627)
+					NodeIdxMap[mapidx] = freqidx;
+					if (mapidx < leafStart)
 					{
 						NodeIdxMap[mapidx + 1] = freqidx;
 					}
@@ -230,59 +274,40 @@ namespace Compression
 			} while (freqidx != 0);
 
 			// Get the value from the node. If it's less than 256, it's a direct pixel value.
-			uint16_t codeword = node - 627;
+			const uint16_t codeword = node - leafStart;
 			if (codeword < 256)
 			{
-				uint8_t codewordByte = static_cast<uint8_t>(codeword);
-				history[historypos++ & 0x0FFF] = codewordByte;
+				const uint8_t codewordByte = static_cast<uint8_t>(codeword);
+				history[historypos++ & HISTORY_MASK] = codewordByte;
 				*(dst++) = codewordByte;
 			}
 			else
 			{
 				// Otherwise, get the next 8 bits from input to construct the
 				// offset to previous pixels to repeat, with the count being
-				// derived from the node's value.
-				while (validbits < 9)
+				// derived from the node's value. At most 14 bits are needed.
+				if (validbits < 14)
 				{
-					if (src != srcend)
-					{
-						bitmask |= *(src++) << (8 - validbits);
-					}
-
-					validbits += 8;
+					refillBits();
 				}
 
-				uint8_t tableidx = bitmask >> 8;
-				bitmask <<= 8;
+				const uint8_t tableidx = static_cast<uint8_t>(bitbuffer >> 24);
+				bitbuffer <<= 8;
 				validbits -= 8;
 
-				uint16_t offsetHigh = highOffsetBits[tableidx] << 6;
-				uint16_t bitcount = lowOffsetBitCount[tableidx] - 2;
-				uint16_t offsetLow = tableidx;
-				for (uint16_t i = 0; i < bitcount; i++)
-				{
-					while (validbits < 9)
-					{
-						if (src != srcend)
-						{
-							bitmask |= *(src++) << (8 - validbits);
-						}
+				const int offsetHigh = highOffsetBits[tableidx] << 6;
+				const int bitcount = lowOffsetBitCount[tableidx] - 2;
+				const int offsetLow = (tableidx << bitcount) | static_cast<int>(bitbuffer >> (32 - bitcount));
+				bitbuffer <<= bitcount;
+				validbits -= bitcount;
 
-						validbits += 8;
-					}
+				const int copypos = historypos - (offsetHigh | (offsetLow & 0x003F)) - 1;
 
-					offsetLow = (offsetLow << 1) | ((bitmask >> 15) & 1);
-					bitmask <<= 1;
-					validbits--;
-				}
-
-				uint16_t copypos = historypos - (offsetHigh | (offsetLow & 0x003F)) - 1;
-				uint16_t tocopy = codeword - 256 + 3;
-				for (uint16_t i = 0; i < tocopy; i++)
-				{
-					*dst = history[copypos++ & 0x0FFF];
-					history[historypos++ & 0x0FFF] = *(dst++);
-				}
+				// Don't let a corrupt back-reference write past the end of the output.
+				const int tocopy = std::min<int>(codeword - 256 + 3, static_cast<int>(dstEnd - dst));
+				copyFromHistory(history, copypos, historypos, tocopy, dst);
+				dst += tocopy;
+				historypos += tocopy;
 			}
 		}
 	}
@@ -10,8 +10,8 @@
 
 bool DFAFile::init(const char *filename)
 {
-	Buffer<std::byte> src;
-	if (!VFS::Manager::get().read(filename, &src))
+	VFS::FileView src;
+	if (!VFS::Manager::get().readView(filename, &src))
 	{
 		DebugLogError("Could not read \"" + std::string(filename) + "\".");
 		return false;
@@ -979,13 +979,20 @@ bool ExeData::isFloppyVersion() const
 	return this->floppyVersion;
 }
 
+uint64_t ExeData::getSourceHash() const
+{
+	return this->sourceHash;
+}
+
 bool ExeData::init(bool floppyVersion)
 {
 	// Load executable.
 	const std::string &exeFilename = floppyVersion ?
 		ExeData::FLOPPY_VERSION_EXE_FILENAME : ExeData::CD_VERSION_EXE_FILENAME;
+	// The unpacked image is cached beside the options since decompressing is slow.
+	const std::string exeCacheFilename = Platform::getOptionsPath() + exeFilename + ".unpacked";
 	ExeUnpacker exe;
-	if (!exe.init(exeFilename.c_str()))
+	if (!exe.init(exeFilename.c_str(), exeCacheFilename))
 	{
 		DebugLogError("Couldn't init .EXE unpacker for \"" + exeFilename + "\".");
 		return false;
@@ -1029,6 +1036,7 @@ bool ExeData::init(bool floppyVersion)
 	}
 
 	this->floppyVersion = floppyVersion;
+	this->sourceHash = exe.getSourceHash();
 
 	return true;
 }
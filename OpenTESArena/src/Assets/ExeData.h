@@ -549,6 +549,7 @@ private:
 	static std::string readFixedString(const char *data, const std::pair<int, int> &pair);
 
 	bool floppyVersion;
+	uint64_t sourceHash;
 public:
 	static const std::string CD_VERSION_EXE_FILENAME;
 	static const std::string FLOPPY_VERSION_EXE_FILENAME;
@@ -573,6 +574,10 @@ public:
 
 	bool isFloppyVersion() const;
 
+	// Gets a hash of the original executable, for invalidating anything cached on disk that was generated
+	// from its data.
+	uint64_t getSourceHash() const;
+
 	// The floppy version boolean determines which strings file to use, and potentially
 	// how to interpret various data structures in the executable.
 	bool init(bool floppyVersion);
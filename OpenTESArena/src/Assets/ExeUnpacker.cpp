@@ -1,5 +1,7 @@
 #include <algorithm>
 #include <array>
+#include <cstdio>
+#include <fstream>
 #include <memory>
 #include <string>
 
@@ -7,11 +9,38 @@
 
 #include "components/debug/Debug.h"
 #include "components/utilities/Bytes.h"
+#include "components/utilities/Profiler.h"
 #include "components/utilities/String.h"
 #include "components/vfs/manager.hpp"
 
 namespace
 {
+	// Unpacked executable cache file header. The version must be bumped if the unpacker's output changes.
+	constexpr std::array<char, 4> CacheMagic = { 'O', 'T', 'A', 'X' };
+	constexpr uint32_t CacheVersion = 1;
+	constexpr int CacheHeaderSize = 4 + 4 + 4 + 8 + 4; // Magic, version, source size, source hash, image size.
+
+	// 64-bit FNV-1a hash of the compressed executable, for detecting a changed or different executable.
+	uint64_t GetExecutableHash(const uint8_t *data, int count)
+	{
+		uint64_t hash = 0xCBF29CE484222325;
+		for (int i = 0; i < count; i++)
+		{
+			hash ^= data[i];
+			hash *= 0x100000001B3;
+		}
+
+		return hash;
+	}
+
+	void WriteLE(std::vector<uint8_t> &dst, uint64_t value, int byteCount)
+	{
+		for (int i = 0; i < byteCount; i++)
+		{
+			dst.push_back(static_cast<uint8_t>(value >> (i * 8)));
+		}
+	}
+
 	// Performance optimization for bit reading (replaces the unnecessary heap 
 	// allocation of std::vector<bool>). Use BitVector::bitsUsed instead of 
 	// BitVector::bits.size().
@@ -205,17 +234,8 @@ namespace
 	};
 }
 
-bool ExeUnpacker::init(const char *filename)
+bool ExeUnpacker::unpack(const uint8_t *srcPtr, int srcCount)
 {
-	Buffer<std::byte> src;
-	if (!VFS::Manager::get().read(filename, &src))
-	{
-		DebugLogError("Could not read \"" + std::string(filename) + "\".");
-		return false;
-	}
-
-	const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.get());
-
 	// Generate the bit trees for "duplication mode". Since the Duplication1 table has 
 	// a special case at index 11, split the insertions up for the first bit tree.
 	BitTree bitTree1, bitTree2;
@@ -239,7 +259,7 @@ bool ExeUnpacker::init(const char *filename)
 
 	// Beginning and end of compressed data in the executable.
 	const uint8_t *compressedStart = srcPtr + 752;
-	const uint8_t *compressedEnd = srcPtr + (src.getCount() - 8);
+	const uint8_t *compressedEnd = srcPtr + (srcCount - 8);
 
 	// Last word of compressed data must be 0xFFFF.
 	const uint16_t lastCompWord = Bytes::getLE16(compressedEnd - 2);
@@ -441,7 +461,152 @@ bool ExeUnpacker::init(const char *filename)
 	return true;
 }
 
+bool ExeUnpacker::tryReadCache(const std::string &cacheFilename, uint64_t srcHash, int srcCount)
+{
+	std::ifstream stream(cacheFilename, std::ios::binary | std::ios::ate);
+	if (!stream.is_open())
+	{
+		return false;
+	}
+
+	const std::streamoff fileSize = stream.tellg();
+	if (fileSize < CacheHeaderSize)
+	{
+		return false;
+	}
+
+	std::array<uint8_t, CacheHeaderSize> header;
+	stream.seekg(0, std::ios::beg);
+	stream.read(reinterpret_cast<char*>(header.data()), header.size());
+	if (!stream.good())
+	{
+		return false;
+	}
+
+	const uint8_t *headerPtr = header.data();
+	const bool matchesSource = std::equal(CacheMagic.begin(), CacheMagic.end(), headerPtr) &&
+		(Bytes::getLE32(headerPtr + 4) == CacheVersion) &&
+		(Bytes::getLE32(headerPtr + 8) == static_cast<uint32_t>(srcCount)) &&
+		(Bytes::getLE32(headerPtr + 12) == static_cast<uint32_t>(srcHash)) &&
+		(Bytes::getLE32(headerPtr + 16) == static_cast<uint32_t>(srcHash >> 32));
+	if (!matchesSource)
+	{
+		return false;
+	}
+
+	const uint32_t imageSize = Bytes::getLE32(headerPtr + 20);
+	if (static_cast<std::streamoff>(imageSize) != (fileSize - CacheHeaderSize))
+	{
+		return false;
+	}
+
+	this->exeData = std::vector<uint8_t>(imageSize);
+	stream.read(reinterpret_cast<char*>(this->exeData.data()), imageSize);
+	if (!stream.good())
+	{
+		this->exeData.clear();
+		return false;
+	}
+
+	return true;
+}
+
+void ExeUnpacker::writeCache(const std::string &cacheFilename, uint64_t srcHash, int srcCount) const
+{
+	std::vector<uint8_t> header;
+	header.reserve(CacheHeaderSize);
+	header.insert(header.end(), CacheMagic.begin(), CacheMagic.end());
+	WriteLE(header, CacheVersion, 4);
+	WriteLE(header, static_cast<uint32_t>(srcCount), 4);
+	WriteLE(header, srcHash, 8);
+	WriteLE(header, static_cast<uint32_t>(this->exeData.size()), 4);
+	DebugAssert(header.size() == CacheHeaderSize);
+
+	// Write to a temporary file first so an interrupted write can't leave a bad cache to be loaded next time.
+	const std::string tempFilename = cacheFilename + ".tmp";
+	std::ofstream stream(tempFilename, std::ios::binary | std::ios::trunc);
+	if (!stream.is_open())
+	{
+		DebugLogWarning("Couldn't open \"" + tempFilename + "\" for writing the unpacked executable.");
+		return;
+	}
+
+	stream.write(reinterpret_cast<const char*>(header.data()), header.size());
+	stream.write(reinterpret_cast<const char*>(this->exeData.data()), this->exeData.size());
+	stream.close();
+	if (stream.fail())
+	{
+		DebugLogWarning("Couldn't write unpacked executable to \"" + tempFilename + "\".");
+		std::remove(tempFilename.c_str());
+		return;
+	}
+
+	// std::rename() doesn't replace an existing file on every platform.
+	std::remove(cacheFilename.c_str());
+	if (std::rename(tempFilename.c_str(), cacheFilename.c_str()) != 0)
+	{
+		DebugLogWarning("Couldn't rename \"" + tempFilename + "\" to \"" + cacheFilename + "\".");
+		std::remove(tempFilename.c_str());
+	}
+}
+
+bool ExeUnpacker::init(const char *filename)
+{
+	VFS::FileView src;
+	if (!VFS::Manager::get().readView(filename, &src))
+	{
+		DebugLogError("Could not read \"" + std::string(filename) + "\".");
+		return false;
+	}
+
+	const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.get());
+	this->sourceHash = GetExecutableHash(srcPtr, src.getCount());
+	return this->unpack(srcPtr, src.getCount());
+}
+
+bool ExeUnpacker::init(const char *filename, const std::string &cacheFilename)
+{
+	Profiler::Sampler sampler;
+	sampler.setStart();
+
+	VFS::FileView src;
+	if (!VFS::Manager::get().readView(filename, &src))
+	{
+		DebugLogError("Could not read \"" + std::string(filename) + "\".");
+		return false;
+	}
+
+	const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.get());
+	const int srcCount = src.getCount();
+	const uint64_t srcHash = GetExecutableHash(srcPtr, srcCount);
+	this->sourceHash = srcHash;
+	if (this->tryReadCache(cacheFilename, srcHash, srcCount))
+	{
+		sampler.setStop();
+		DebugLog("Loaded unpacked \"" + std::string(filename) + "\" from cache in " +
+			String::fixedPrecision(sampler.getMilliseconds(), 2) + "ms.");
+		return true;
+	}
+
+	if (!this->unpack(srcPtr, srcCount))
+	{
+		return false;
+	}
+
+	sampler.setStop();
+	DebugLog("Unpacked \"" + std::string(filename) + "\" in " +
+		String::fixedPrecision(sampler.getMilliseconds(), 2) + "ms (no valid cache).");
+
+	this->writeCache(cacheFilename, srcHash, srcCount);
+	return true;
+}
+
 const std::vector<uint8_t> &ExeUnpacker::getData() const
 {
 	return this->exeData;
 }
+
+uint64_t ExeUnpacker::getSourceHash() const
+{
+	return this->sourceHash;
+}
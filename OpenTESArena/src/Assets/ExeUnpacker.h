@@ -2,6 +2,7 @@
 #define EXE_UNPACKER_H
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 // For decompressing DOS executables compressed with PKLITE.
@@ -10,12 +11,29 @@ class ExeUnpacker
 {
 private:
 	std::vector<uint8_t> exeData;
+	uint64_t sourceHash; // Hash of the compressed executable.
+
+	// Decompresses the given compressed executable bytes into the executable data.
+	bool unpack(const uint8_t *srcPtr, int srcCount);
+
+	// Attempts to load a previously unpacked image that was generated from the given executable bytes.
+	bool tryReadCache(const std::string &cacheFilename, uint64_t srcHash, int srcCount);
+
+	// Saves the unpacked image so later launches can skip decompression.
+	void writeCache(const std::string &cacheFilename, uint64_t srcHash, int srcCount) const;
 public:
 	// Reads in a compressed EXE file and decompresses it.
 	bool init(const char *filename);
 
+	// Same as above, but first checks for an unpacked image in the given cache file that matches the
+	// executable's hash, and writes one if it's missing or stale.
+	bool init(const char *filename, const std::string &cacheFilename);
+
 	// Gets the decompressed executable data.
 	const std::vector<uint8_t> &getData() const;
+
+	// Gets a hash of the compressed executable for recognizing data generated from it.
+	uint64_t getSourceHash() const;
 };
 
 #endif
@@ -0,0 +1,73 @@
+#ifndef FLC_DECODER_H
+#define FLC_DECODER_H
+
+#include <cstdint>
+
+#include "../Media/Palette.h"
+
+#include "components/utilities/Buffer2D.h"
+#include "components/vfs/manager.hpp"
+
+// Decodes .FLC/.CEL frames one at a time in playback order. Only the current frame is kept, since each
+// delta frame is applied on top of the previous one. See FLCFile for the format notes.
+
+class FLCDecoder
+{
+private:
+	VFS::FileView src;
+	Buffer2D<uint8_t> framePixels; // Palette indices of the current frame.
+	Palette palette; // Most recently read palette chunk.
+	double frameDuration;
+	int width;
+	int height;
+	int frameCount; // Excludes the last frame in the file since it loops back to the first.
+	int frameIndex; // Frame currently in the pixel buffer, or -1 before the first one.
+	uint32_t dataOffset; // Byte offset of the next frame header.
+
+	// Reads a palette chunk and writes out the results to the reference parameter.
+	static bool readPalette(const uint8_t *chunkData, Palette *dst);
+
+	// Decodes a fullscreen FLC chunk by overwriting the current frame indices.
+	void decodeFullFrame(const uint8_t *chunkData);
+
+	// Decodes a delta FLC chunk by partially updating the current frame indices.
+	void decodeDeltaFrame(const uint8_t *chunkData, int chunkSize);
+
+	// Walks the frame headers (without decoding) to count the frames that have pixel data.
+	bool tryCountFrames(int *outCount) const;
+public:
+	FLCDecoder();
+
+	// Reads the header and prepares for the first frame. No frames are decoded yet.
+	bool init(const char *filename);
+
+	// Gets the number of frames.
+	int getFrameCount() const;
+
+	// Gets the duration of each frame in seconds.
+	double getFrameDuration() const;
+
+	// Gets the width of each frame.
+	int getWidth() const;
+
+	// Gets the height of each frame.
+	int getHeight() const;
+
+	// Gets the index of the most recently decoded frame, or -1 if none have been decoded.
+	int getFrameIndex() const;
+
+	// Decodes the next frame into the current frame buffer. Returns false at the end of the animation or if
+	// the frame couldn't be read.
+	bool readNextFrame();
+
+	// Goes back to before the first frame.
+	void rewind();
+
+	// Gets the palette of the current frame.
+	const Palette &getPalette() const;
+
+	// Gets the pixel data of the current frame.
+	const uint8_t *getPixels() const;
+};
+
+#endif
@@ -36,19 +36,8 @@ private:
 	int width;
 	int height;
 
-	// Reads a palette chunk and writes out the results to the reference parameter.
-	static bool readPalette(const uint8_t *chunkData, Palette *dst);
-
-	// Decodes a fullscreen FLC chunk by updating the initial frame indices and
-	// returning a complete frame.
-	Buffer2D<uint8_t> decodeFullFrame(const uint8_t *chunkData, int chunkSize,
-		Buffer2D<uint8_t> &initialFrame);
-
-	// Decodes a delta FLC chunk by partially updating the initial frame indices and
-	// returning a complete frame.
-	Buffer2D<uint8_t> decodeDeltaFrame(const uint8_t *chunkData, int chunkSize,
-		Buffer2D<uint8_t> &initialFrame);
 public:
+	// Decodes every frame up front. Long cinematics should use FLCDecoder or FLCFrameStream instead.
 	bool init(const char *filename);
 
 	// Gets the number of frames.
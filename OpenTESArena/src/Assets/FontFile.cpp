@@ -25,8 +25,8 @@ namespace
 
 bool FontFile::init(const char *filename)
 {
-	Buffer<std::byte> src;
-	if (!VFS::Manager::get().read(filename, &src))
+	VFS::FileView src;
+	if (!VFS::Manager::get().readView(filename, &src))
 	{
 		DebugLogError("Could not read \"" + std::string(filename) + "\".");
 		return false;
@@ -55,8 +55,8 @@ bool IMGFile::init(const char *filename)
 		return true;
 	}
 
-	Buffer<std::byte> src;
-	if (!VFS::Manager::get().read(filename, &src))
+	VFS::FileView src;
+	if (!VFS::Manager::get().readView(filename, &src))
 	{
 		DebugLogError("Could not read \"" + std::string(filename) + "\".");
 		return false;
@@ -214,8 +214,8 @@ Palette IMGFile::readPalette(const uint8_t *paletteData)
 
 bool IMGFile::tryExtractPalette(const char *filename, Palette &palette)
 {
-	Buffer<std::byte> src;
-	if (!VFS::Manager::get().read(filename, &src))
+	VFS::FileView src;
+	if (!VFS::Manager::get().readView(filename, &src))
 	{
 		DebugLogError("Could not read \"" + std::string(filename) + "\".");
 		return false;
@@ -415,8 +415,8 @@ BufferView<const ArenaTypes::MIFTrigger> MIFFile::Level::getTRIG() const
 
 bool MIFFile::init(const char *filename)
 {
-	Buffer<std::byte> src;
-	if (!VFS::Manager::get().read(filename, &src))
+	VFS::FileView src;
+	if (!VFS::Manager::get().readView(filename, &src))
 	{
 		DebugLogError("Could not read \"" + std::string(filename) + "\".");
 		return false;
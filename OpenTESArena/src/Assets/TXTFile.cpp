@@ -7,8 +7,8 @@
 
 bool TXTFile::init(const char *filename)
 {
-    Buffer<std::byte> src;
-    if (!VFS::Manager::get().read(filename, &src))
+    VFS::FileView src;
+    if (!VFS::Manager::get().readView(filename, &src))
     {
         DebugLogError("Could not open \"" + std::string(filename) + "\".");
         return false;
@@ -19,4 +19,18 @@ struct TextureAssetReference
 	bool operator==(const TextureAssetReference &other) const;
 };
 
+namespace std
+{
+	template <>
+	struct hash<TextureAssetReference>
+	{
+		size_t operator()(const TextureAssetReference &textureAssetRef) const
+		{
+			const size_t filenameHash = std::hash<std::string>()(textureAssetRef.filename);
+			const size_t indexHash = static_cast<size_t>(textureAssetRef.index.value_or(-1));
+			return filenameHash ^ (indexHash * 31);
+		}
+	};
+}
+
 #endif
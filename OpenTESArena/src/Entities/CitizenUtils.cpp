@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <vector>
 
 #include "CitizenUtils.h"
 #include "EntityDefinitionLibrary.h"
@@ -170,36 +171,15 @@ bool CitizenUtils::trySpawnCitizenInChunk(const Chunk &chunk, const CitizenGenIn
 		return false;
 	}
 
-	const std::optional<VoxelInt2> spawnVoxel = [&chunk, &random]() -> std::optional<VoxelInt2>
+	const BufferView<const VoxelInt2> spawnVoxels = chunk.getCitizenSpawnVoxels();
+	if (spawnVoxels.getCount() == 0)
 	{
-		DebugAssert(chunk.getHeight() >= 2);
-
-		constexpr int spawnTriesCount = 20;
-		for (int spawnTry = 0; spawnTry < spawnTriesCount; spawnTry++)
-		{
-			const VoxelInt2 spawnVoxel(random.next(Chunk::WIDTH), random.next(Chunk::DEPTH));
-			const Chunk::VoxelID voxelID = chunk.getVoxel(spawnVoxel.x, 1, spawnVoxel.y);
-			const Chunk::VoxelID groundVoxelID = chunk.getVoxel(spawnVoxel.x, 0, spawnVoxel.y);
-			const VoxelDefinition &voxelDef = chunk.getVoxelDef(voxelID);
-			const VoxelDefinition &groundVoxelDef = chunk.getVoxelDef(groundVoxelID);
-
-			if ((voxelDef.type == ArenaTypes::VoxelType::None) &&
-				(groundVoxelDef.type == ArenaTypes::VoxelType::Floor))
-			{
-				return spawnVoxel;
-			}
-		}
-
-		// No spawn position found.
-		return std::nullopt;
-	}();
-
-	if (!spawnVoxel.has_value())
-	{
-		DebugLogWarning("Couldn't find spawn voxel for citizen.");
+		DebugLogWarning("No citizen spawn voxels in chunk \"" + chunkCoord.toString() + "\".");
 		return false;
 	}
 
+	const VoxelInt2 spawnVoxel = spawnVoxels.get(random.next(spawnVoxels.getCount()));
+
 	const bool male = random.next(2) == 0;
 	const EntityDefID entityDefID = male ? citizenGenInfo.maleEntityDefID : citizenGenInfo.femaleEntityDefID;
 	const EntityDefinition &entityDef = male ? *citizenGenInfo.maleEntityDef : *citizenGenInfo.femaleEntityDef;
@@ -217,7 +197,7 @@ bool CitizenUtils::trySpawnCitizenInChunk(const Chunk &chunk, const CitizenGenIn
 	dynamicEntity->initCitizen(entityDefID, entityAnimInst, direction);
 
 	// Idle animation by default.
-	const std::optional<int> stateIndex = entityAnimDef.tryGetStateIndex(EntityAnimationUtils::STATE_IDLE.c_str());
+	const std::optional<int> stateIndex = entityAnimDef.tryGetStateIndex(EntityAnimationStateType::Idle);
 	if (!stateIndex.has_value())
 	{
 		DebugLogWarning("Couldn't get idle state index for citizen.");
@@ -227,13 +207,11 @@ bool CitizenUtils::trySpawnCitizenInChunk(const Chunk &chunk, const CitizenGenIn
 	EntityAnimationInstance &animInst = dynamicEntity->getAnimInstance();
 	animInst.setStateIndex(*stateIndex);
 
-	auto citizenParams = std::make_unique<EntityAnimationInstance::CitizenParams>();
-	citizenParams->palette = generatedPalette;
-	animInst.setCitizenParams(std::move(citizenParams));
+	animInst.setPaletteID(entityManager.addEntityPalette(generatedPalette));
 
 	// Note: since the entity pointer is being used directly, update the position last
 	// in scope to avoid a dangling pointer problem in case it changes chunks.
-	const CoordDouble2 spawnCoordReal(chunkCoord, VoxelUtils::getVoxelCenter(*spawnVoxel));
+	const CoordDouble2 spawnCoordReal(chunkCoord, VoxelUtils::getVoxelCenter(spawnVoxel));
 	dynamicEntity->setPosition(spawnCoordReal, entityManager);
 
 	return true;
@@ -279,13 +257,20 @@ void CitizenUtils::clearCitizens(EntityManager &entityManager)
 	Buffer<const Entity*> entities(entityManager.getCountOfType(entityType));
 	const int entityWriteCount = entityManager.getEntitiesOfType(entityType, entities.get(), entities.getCount());
 
+	// Removing an entity moves others around in their group, so gather IDs first.
+	std::vector<EntityID> citizenIDs;
 	for (int i = 0; i < entityWriteCount; i++)
 	{
 		const Entity *entity = entities.get(i);
 		const DynamicEntity *dynamicEntity = dynamic_cast<const DynamicEntity*>(entity);
 		if (dynamicEntity->getDerivedType() == DynamicEntityType::Citizen)
 		{
-			entityManager.remove(dynamicEntity->getID());
+			citizenIDs.emplace_back(dynamicEntity->getID());
 		}
 	}
+
+	for (const EntityID citizenID : citizenIDs)
+	{
+		entityManager.remove(citizenID);
+	}
 }
@@ -3,8 +3,8 @@
 
 #include "DynamicEntity.h"
 #include "EntityManager.h"
+#include "EntityTickBuffer.h"
 #include "EntityType.h"
-#include "../Audio/AudioManager.h"
 #include "../Game/CardinalDirection.h"
 #include "../Game/CardinalDirectionName.h"
 #include "../Game/Game.h"
@@ -132,15 +132,18 @@ bool DynamicEntity::tryGetCreatureSoundFilename(const EntityManager &entityManag
 	return true;
 }
 
-void DynamicEntity::playCreatureSound(const std::string &soundFilename, double ceilingScale,
-	AudioManager &audioManager)
+void DynamicEntity::queueCreatureSound(const std::string &soundFilename, double ceilingScale,
+	EntityTickBuffer &tickBuffer)
 {
 	// Centered inside the creature.
 	const CoordDouble3 soundCoord(
 		this->position.chunk,
 		VoxelDouble3(this->position.point.x, ceilingScale * 1.50, this->position.point.y));
 	const NewDouble3 absoluteSoundPosition = VoxelUtils::coordToNewPoint(soundCoord);
-	audioManager.playSound(soundFilename, absoluteSoundPosition);
+
+	EntityTickBuffer::SoundRequest soundRequest;
+	soundRequest.init(soundFilename, absoluteSoundPosition);
+	tickBuffer.sounds.emplace_back(std::move(soundRequest));
 }
 
 void DynamicEntity::yaw(double radians)
@@ -198,10 +201,10 @@ void DynamicEntity::setDestination(const NewDouble2 *point)
 	this->setDestination(point, minDistance);
 }
 
-void DynamicEntity::updateCitizenState(Game &game, double dt)
+void DynamicEntity::updateCitizenState(Game &game, double dt, EntityTickBuffer &tickBuffer)
 {
 	auto &gameState = game.getGameState();
-	auto &random = game.getRandom();
+	auto &random = tickBuffer.random;
 	const auto &player = gameState.getPlayer();
 	const MapInstance &activeMapInst = gameState.getActiveMapInst();
 	const LevelInstance &activeLevelInst = activeMapInst.getActiveLevel();
@@ -223,14 +226,14 @@ void DynamicEntity::updateCitizenState(Game &game, double dt)
 	const bool isPlayerStopped = playerSpeedSqr < Constants::Epsilon;
 
 	// Get idle and walk state indices.
-	const std::optional<int> idleStateIndex = animDef.tryGetStateIndex(EntityAnimationUtils::STATE_IDLE.c_str());
+	const std::optional<int> idleStateIndex = animDef.tryGetStateIndex(EntityAnimationStateType::Idle);
 	if (!idleStateIndex.has_value())
 	{
 		DebugLogWarning("Couldn't get citizen idle state index.");
 		return;
 	}
 
-	const std::optional<int> walkStateIndex = animDef.tryGetStateIndex(EntityAnimationUtils::STATE_WALK.c_str());
+	const std::optional<int> walkStateIndex = animDef.tryGetStateIndex(EntityAnimationStateType::Walk);
 	if (!walkStateIndex.has_value())
 	{
 		DebugLogWarning("Couldn't get citizen walk state index.");
@@ -275,7 +278,7 @@ void DynamicEntity::updateCitizenState(Game &game, double dt)
 	}
 }
 
-void DynamicEntity::updateCreatureState(Game &game, double dt)
+void DynamicEntity::updateCreatureState(Game &game, double dt, EntityTickBuffer &tickBuffer)
 {
 	auto &gameState = game.getGameState();
 	const MapInstance &activeMapInst = gameState.getActiveMapInst();
@@ -299,18 +302,17 @@ void DynamicEntity::updateCreatureState(Game &game, double dt)
 			std::string creatureSoundFilename;
 			if (this->tryGetCreatureSoundFilename(entityManager, entityDefLibrary, &creatureSoundFilename))
 			{
-				auto &audioManager = game.getAudioManager();
-				this->playCreatureSound(creatureSoundFilename, ceilingScale, audioManager);
+				this->queueCreatureSound(creatureSoundFilename, ceilingScale, tickBuffer);
 
 				const double creatureSoundWaitTime =
-					DynamicEntity::nextCreatureSoundWaitTime(game.getRandom());
+					DynamicEntity::nextCreatureSoundWaitTime(tickBuffer.random);
 				this->secondsTillCreatureSound = creatureSoundWaitTime;
 			}
 		}
 	}
 }
 
-void DynamicEntity::updateProjectileState(Game &game, double dt)
+void DynamicEntity::updateProjectileState(Game &game, double dt, EntityTickBuffer&)
 {
 	// @todo: projectile motion + collision
 }
@@ -330,7 +332,7 @@ void DynamicEntity::updatePhysics(const LevelInstance &activeLevel,
 		const EntityAnimationDefinition &animDef = entityDef.getAnimDef();
 
 		// If citizen and walking, continue walking until next block is not air.
-		const std::optional<int> walkStateIndex = animDef.tryGetStateIndex(EntityAnimationUtils::STATE_WALK.c_str());
+		const std::optional<int> walkStateIndex = animDef.tryGetStateIndex(EntityAnimationStateType::Walk);
 		if (!walkStateIndex.has_value())
 		{
 			DebugLogWarning("Couldn't get citizen walk state index.");
@@ -358,32 +360,22 @@ void DynamicEntity::updatePhysics(const LevelInstance &activeLevel,
 
 			if (nextVoxel != curVoxel)
 			{
-				auto isSuitableVoxel = [&chunkManager](const CoordInt2 &coord)
+				// Candidate voxels are almost always in the citizen's chunk, so only search the chunk manager
+				// for the ones that aren't.
+				const Chunk *curChunk = chunkManager.tryGetChunk(curVoxel.chunk);
+				auto isSuitableVoxel = [&chunkManager, &curVoxel, curChunk](const CoordInt2 &coord)
 				{
-					const Chunk *chunk = chunkManager.tryGetChunk(coord.chunk);
-
-					auto isValidVoxel = [chunk]()
-					{
-						return chunk != nullptr;
-					};
-
-					auto isPassableVoxel = [&coord, chunk]()
+					const Chunk *chunk = (coord.chunk == curVoxel.chunk) ? curChunk : chunkManager.tryGetChunk(coord.chunk);
+					if (chunk == nullptr)
 					{
-						const VoxelInt3 voxel(coord.voxel.x, 1, coord.voxel.y);
-						const Chunk::VoxelID voxelID = chunk->getVoxel(voxel.x, voxel.y, voxel.z);
-						const VoxelDefinition &voxelDef = chunk->getVoxelDef(voxelID);
-						return voxelDef.type == ArenaTypes::VoxelType::None;
-					};
-
-					auto isWalkableVoxel = [&coord, chunk]()
-					{
-						const VoxelInt3 voxel(coord.voxel.x, 0, coord.voxel.y);
-						const Chunk::VoxelID voxelID = chunk->getVoxel(voxel.x, voxel.y, voxel.z);
-						const VoxelDefinition &voxelDef = chunk->getVoxelDef(voxelID);
-						return voxelDef.type == ArenaTypes::VoxelType::Floor;
-					};
+						return false;
+					}
 
-					return isValidVoxel() && isPassableVoxel() && isWalkableVoxel();
+					// Citizens walk on floor voxels with nothing above them.
+					const VoxelInt2 &voxel = coord.voxel;
+					const bool isPassableVoxel = chunk->hasVoxelTrait(voxel.x, 1, voxel.y, VoxelTraitType::Empty);
+					const bool isWalkableVoxel = chunk->hasVoxelTrait(voxel.x, 0, voxel.y, VoxelTraitType::Floor);
+					return isPassableVoxel && isWalkableVoxel;
 				};
 
 				if (!isSuitableVoxel(nextVoxel))
@@ -445,21 +437,21 @@ void DynamicEntity::reset()
 	this->destination = std::nullopt;
 }
 
-void DynamicEntity::tick(Game &game, double dt)
+void DynamicEntity::tick(Game &game, double dt, EntityTickBuffer &tickBuffer)
 {
-	Entity::tick(game, dt);
+	Entity::tick(game, dt, tickBuffer);
 
 	// Update derived entity state.
 	switch (this->derivedType)
 	{
 	case DynamicEntityType::Citizen:
-		this->updateCitizenState(game, dt);
+		this->updateCitizenState(game, dt, tickBuffer);
 		break;
 	case DynamicEntityType::Creature:
-		this->updateCreatureState(game, dt);
+		this->updateCreatureState(game, dt, tickBuffer);
 		break;
 	case DynamicEntityType::Projectile:
-		this->updateProjectileState(game, dt);
+		this->updateProjectileState(game, dt, tickBuffer);
 		break;
 	default:
 		DebugNotImplementedMsg(std::to_string(static_cast<int>(this->derivedType)));
@@ -471,5 +463,5 @@ void DynamicEntity::tick(Game &game, double dt)
 	const MapInstance &activeMapInst = gameState.getActiveMapInst();
 	const LevelInstance &activeLevelInst = activeMapInst.getActiveLevel();
 	const EntityDefinitionLibrary &entityDefLibrary = game.getEntityDefinitionLibrary();
-	this->updatePhysics(activeLevelInst, entityDefLibrary, game.getRandom(), dt);
+	this->updatePhysics(activeLevelInst, entityDefLibrary, tickBuffer.random, dt);
 }
@@ -12,7 +12,6 @@
 // An entity that can move and look in different directions. The displayed texture depends
 // on the entity's position relative to the player's camera.
 
-class AudioManager;
 class EntityDefinitionLibrary;
 class EntityManager;
 class ExeData;
@@ -39,17 +38,17 @@ private:
 	bool tryGetCreatureSoundFilename(const EntityManager &entityManager,
 		const EntityDefinitionLibrary &entityDefLibrary, std::string *outFilename) const;
 
-	// Plays the given creature sound on the entity.
-	void playCreatureSound(const std::string &soundFilename, double ceilingScale,
-		AudioManager &audioManager);
+	// Queues the given creature sound to play on the entity.
+	void queueCreatureSound(const std::string &soundFilename, double ceilingScale,
+		EntityTickBuffer &tickBuffer);
 
 	// Helper method for rotating.
 	void yaw(double radians);
 
 	// Update functions for various dynamic entity types.
-	void updateCitizenState(Game &game, double dt);
-	void updateCreatureState(Game &game, double dt);
-	void updateProjectileState(Game &game, double dt);
+	void updateCitizenState(Game &game, double dt, EntityTickBuffer &tickBuffer);
+	void updateCreatureState(Game &game, double dt, EntityTickBuffer &tickBuffer);
+	void updateProjectileState(Game &game, double dt, EntityTickBuffer &tickBuffer);
 
 	// Updates the entity's physics in the world (if any).
 	void updatePhysics(const LevelInstance &activeLevel, const EntityDefinitionLibrary &entityDefLibrary,
@@ -86,7 +85,7 @@ public:
 	void setDestination(const NewDouble2 *point);
 
 	void reset() override;
-	void tick(Game &game, double dt) override;
+	void tick(Game &game, double dt, EntityTickBuffer &tickBuffer) override;
 };
 
 #endif
@@ -129,7 +129,7 @@ void Entity::reset()
 	this->animInst.reset();
 }
 
-void Entity::tick(Game &game, double dt)
+void Entity::tick(Game &game, double dt, EntityTickBuffer&)
 {
 	const EntityAnimationDefinition &animDef = [this, &game]() -> const EntityAnimationDefinition&
 	{
@@ -15,6 +15,8 @@ class Game;
 
 enum class EntityType;
 
+struct EntityTickBuffer;
+
 class Entity
 {
 private:
@@ -63,8 +65,9 @@ public:
 	// Clears all entity data so it can be used for another entity of the same type.
 	virtual void reset();
 
-	// Animates the entity's state by delta time.
-	virtual void tick(Game &game, double dt);
+	// Animates the entity's state by delta time. This can run on a worker thread, so any changes outside
+	// the entity go through the tick buffer.
+	virtual void tick(Game &game, double dt, EntityTickBuffer &tickBuffer);
 };
 
 #endif
@@ -7,6 +7,23 @@
 #include "components/utilities/String.h"
 #include "components/utilities/StringView.h"
 
+namespace
+{
+	// State names for each state type, in the same order as the enum.
+	const std::array<const std::string*, EntityAnimationDefinition::STATE_TYPE_COUNT> StateTypeNames =
+	{
+		&EntityAnimationUtils::STATE_IDLE,
+		&EntityAnimationUtils::STATE_LOOK,
+		&EntityAnimationUtils::STATE_WALK,
+		&EntityAnimationUtils::STATE_ATTACK,
+		&EntityAnimationUtils::STATE_DEATH,
+		&EntityAnimationUtils::STATE_ACTIVATED
+	};
+
+	static_assert(static_cast<int>(EntityAnimationStateType::Activated) ==
+		(EntityAnimationDefinition::STATE_TYPE_COUNT - 1));
+}
+
 EntityAnimationDefinition::Keyframe::Keyframe(TextureAssetReference &&textureAssetRef, double width, double height)
 	: textureAssetRef(std::move(textureAssetRef))
 {
@@ -117,6 +134,21 @@ void EntityAnimationDefinition::State::clearKeyframeLists()
 	this->keyframeLists.clear();
 }
 
+EntityAnimationDefinition::EntityAnimationDefinition()
+{
+	this->stateTypeIndices.fill(-1);
+}
+
+void EntityAnimationDefinition::updateStateTypeIndices()
+{
+	for (int i = 0; i < STATE_TYPE_COUNT; i++)
+	{
+		const std::string &stateName = *StateTypeNames[i];
+		const std::optional<int> stateIndex = this->tryGetStateIndex(stateName.c_str());
+		this->stateTypeIndices[i] = stateIndex.has_value() ? *stateIndex : -1;
+	}
+}
+
 int EntityAnimationDefinition::getStateCount() const
 {
 	return static_cast<int>(this->states.size());
@@ -148,9 +180,23 @@ std::optional<int> EntityAnimationDefinition::tryGetStateIndex(const char *name)
 	return std::nullopt;
 }
 
+std::optional<int> EntityAnimationDefinition::tryGetStateIndex(EntityAnimationStateType stateType) const
+{
+	const int stateTypeIndex = static_cast<int>(stateType);
+	DebugAssertIndex(this->stateTypeIndices, stateTypeIndex);
+	const int stateIndex = this->stateTypeIndices[stateTypeIndex];
+	if (stateIndex < 0)
+	{
+		return std::nullopt;
+	}
+
+	return stateIndex;
+}
+
 void EntityAnimationDefinition::addState(State &&state)
 {
 	this->states.push_back(std::move(state));
+	this->updateStateTypeIndices();
 }
 
 void EntityAnimationDefinition::removeState(const char *name)
@@ -159,10 +205,12 @@ void EntityAnimationDefinition::removeState(const char *name)
 	if (stateIndex.has_value())
 	{
 		this->states.erase(this->states.begin() + *stateIndex);
+		this->updateStateTypeIndices();
 	}
 }
 
 void EntityAnimationDefinition::clear()
 {
 	this->states.clear();
+	this->stateTypeIndices.fill(-1);
 }
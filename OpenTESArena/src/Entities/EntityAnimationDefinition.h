@@ -6,6 +6,7 @@
 #include <vector>
 #include <string>
 
+#include "EntityAnimationStateType.h"
 #include "EntityAnimationUtils.h"
 #include "../Assets/TextureAssetReference.h"
 
@@ -73,12 +74,23 @@ public:
 		void addKeyframeList(KeyframeList &&keyframeList);
 		void clearKeyframeLists();
 	};
+	// Number of state types with a known name.
+	static constexpr int STATE_TYPE_COUNT = 6;
 private:
 	std::vector<State> states; // Idle, Attack, etc..
+
+	// Indices of states with a known name, or -1 if missing. Updated whenever states are added or
+	// removed so per-tick code doesn't need string comparisons.
+	std::array<int, STATE_TYPE_COUNT> stateTypeIndices;
+
+	void updateStateTypeIndices();
 public:
+	EntityAnimationDefinition();
+
 	int getStateCount() const;
 	const State &getState(int index) const;
 	std::optional<int> tryGetStateIndex(const char *name) const;
+	std::optional<int> tryGetStateIndex(EntityAnimationStateType stateType) const;
 
 	void addState(State &&state);
 	void removeState(const char *name);
@@ -1,127 +1,24 @@
 #include <cmath>
 
+#include "EntityAnimationDefinition.h"
 #include "EntityAnimationInstance.h"
-#include "../Media/TextureManager.h"
+#include "EntityManager.h"
 
 #include "components/debug/Debug.h"
 
-int EntityAnimationInstance::KeyframeList::getKeyframeCount() const
-{
-	return static_cast<int>(this->keyframes.size());
-}
-
-const EntityAnimationInstance::Keyframe &EntityAnimationInstance::KeyframeList::getKeyframe(int index) const
-{
-	DebugAssertIndex(this->keyframes, index);
-	return this->keyframes[index];
-}
-
-void EntityAnimationInstance::KeyframeList::addKeyframe(Keyframe &&keyframe)
-{
-	this->keyframes.push_back(std::move(keyframe));
-}
-
-void EntityAnimationInstance::KeyframeList::clearKeyframes()
-{
-	this->keyframes.clear();
-}
-
-int EntityAnimationInstance::State::getKeyframeListCount() const
-{
-	return static_cast<int>(this->keyframeLists.size());
-}
-
-const EntityAnimationInstance::KeyframeList &EntityAnimationInstance::State::getKeyframeList(int index) const
-{
-	DebugAssertIndex(this->keyframeLists, index);
-	return this->keyframeLists[index];
-}
-
-void EntityAnimationInstance::State::addKeyframeList(EntityAnimationInstance::KeyframeList &&keyframeList)
-{
-	this->keyframeLists.push_back(std::move(keyframeList));
-}
-
-void EntityAnimationInstance::State::clearKeyframeLists()
-{
-	this->keyframeLists.clear();
-}
-
 EntityAnimationInstance::EntityAnimationInstance()
 {
-	this->stateIndex = -1;
-	this->currentSeconds = 0.0;
-}
-
-EntityAnimationInstance::EntityAnimationInstance(const EntityAnimationInstance &other)
-	: states(other.states)
-{
-	const std::unique_ptr<CitizenParams> &otherCitizenParams = other.citizenParams;
-	this->citizenParams = (otherCitizenParams != nullptr) ?
-		std::make_unique<CitizenParams>(*otherCitizenParams) : nullptr;
-
-	this->currentSeconds = other.currentSeconds;
-	this->stateIndex = other.stateIndex;
-}
-
-EntityAnimationInstance &EntityAnimationInstance::operator=(const EntityAnimationInstance &other)
-{
-	if (this != &other)
-	{
-		this->states = other.states;
-
-		const std::unique_ptr<CitizenParams> &otherCitizenParams = other.citizenParams;
-		this->citizenParams = (otherCitizenParams != nullptr) ?
-			std::make_unique<CitizenParams>(*otherCitizenParams) : nullptr;
-
-		this->currentSeconds = other.currentSeconds;
-		this->stateIndex = other.stateIndex;
-	}
-	
-	return *this;
+	this->reset();
 }
 
 void EntityAnimationInstance::init(const EntityAnimationDefinition &animDef)
 {
-	for (int i = 0; i < animDef.getStateCount(); i++)
-	{
-		const EntityAnimationDefinition::State &defState = animDef.getState(i);
-		EntityAnimationInstance::State instState;
-
-		for (int j = 0; j < defState.getKeyframeListCount(); j++)
-		{
-			const EntityAnimationDefinition::KeyframeList &defKeyframeList = defState.getKeyframeList(j);
-			EntityAnimationInstance::KeyframeList instKeyframeList;
-
-			for (int k = 0; k < defKeyframeList.getKeyframeCount(); k++)
-			{
-				EntityAnimationInstance::Keyframe instKeyframe;
-				// @todo: this will eventually get renderer entity texture handles, likely from looking up in a hash table
-				// of texture asset references (w/ other variables like flipped, reflective, etc.).
-				instKeyframeList.addKeyframe(std::move(instKeyframe));
-			}
-
-			instState.addKeyframeList(std::move(instKeyframeList));
-		}
-
-		this->states.emplace_back(std::move(instState));
-	}
+	this->stateCount = animDef.getStateCount();
 }
 
 int EntityAnimationInstance::getStateCount() const
 {
-	return static_cast<int>(this->states.size());
-}
-
-const EntityAnimationInstance::State &EntityAnimationInstance::getState(int index) const
-{
-	DebugAssertIndex(this->states, index);
-	return this->states[index];
-}
-
-const EntityAnimationInstance::CitizenParams *EntityAnimationInstance::getCitizenParams() const
-{
-	return this->citizenParams.get();
+	return this->stateCount;
 }
 
 int EntityAnimationInstance::getStateIndex() const
@@ -134,23 +31,30 @@ double EntityAnimationInstance::getCurrentSeconds() const
 	return this->currentSeconds;
 }
 
-void EntityAnimationInstance::setCitizenParams(std::unique_ptr<CitizenParams> &&citizenParams)
+EntityPaletteID EntityAnimationInstance::getPaletteID() const
 {
-	this->citizenParams = std::move(citizenParams);
+	return this->paletteID;
 }
 
 void EntityAnimationInstance::setStateIndex(int index)
 {
+	DebugAssert(index >= 0);
+	DebugAssert(index < this->stateCount);
 	this->stateIndex = index;
 	this->resetTime();
 }
 
+void EntityAnimationInstance::setPaletteID(EntityPaletteID id)
+{
+	this->paletteID = id;
+}
+
 void EntityAnimationInstance::reset()
 {
-	this->states.clear();
-	this->citizenParams = nullptr;
-	this->resetTime();
+	this->stateCount = 0;
 	this->stateIndex = -1;
+	this->paletteID = EntityManager::NO_PALETTE_ID;
+	this->resetTime();
 }
 
 void EntityAnimationInstance::resetTime()
@@ -1,97 +1,44 @@
 #ifndef ENTITY_ANIMATION_INSTANCE_H
 #define ENTITY_ANIMATION_INSTANCE_H
 
-#include <array>
-#include <memory>
-#include <string>
-#include <vector>
+#include "EntityUtils.h"
 
-#include "EntityAnimationDefinition.h"
-#include "EntityAnimationUtils.h"
-#include "../Assets/TextureAssetReference.h"
-#include "../Media/TextureUtils.h"
+// Instance-specific animation data, references a shared animation definition. Keyframes are read
+// from the owning entity's definition so instances stay small and cheap to copy.
 
-#include "components/utilities/BufferView.h"
+// @todo: eventually store renderer texture handles here for keyframes that differ per instance (i.e.,
+// enemy humans with weapons drawn on top). Those should be shared allocations looked up by the
+// combination of textures, not per-instance keyframe lists.
 
-// Instance-specific animation data, references a shared animation definition.
-
-class TextureBuilder;
-class TextureManager;
+class EntityAnimationDefinition;
 
 class EntityAnimationInstance
 {
-public:
-	class Keyframe
-	{
-	private:
-		// @todo: use an entity texture handle from the renderer. This should be shareable between different
-		// entities; for example, 100 chain armor male enemies with swords could all have this same handle.
-		// In order to effectively handle enemy human weapons, each instance keyframe should be an allocated
-		// renderer texture handle like EntityTextureID with the weapon texture drawn on top of the human texture.
-		// Don't complicate anything by having "multiple layers" in a keyframe. It's just one texture. There
-		// could be sharing of that combination (i.e. medium armor male enemy with sword) done beforehand and
-		// the keyframe would still get that texture handle.
-	public:
-		// @todo: eventually return renderer texture handle instead and maybe don't pass anim def keyframe. The
-		// entity animation definition needs its own entity texture handles allocated as "the go-to ones" if there
-		// is nothing interesting to set as the override handle in this instance keyframe.
-	};
-
-	class KeyframeList
-	{
-	private:
-		std::vector<Keyframe> keyframes;
-	public:
-		int getKeyframeCount() const;
-		const Keyframe &getKeyframe(int index) const;
-
-		void addKeyframe(Keyframe &&keyframe);
-		void clearKeyframes();
-	};
-
-	class State
-	{
-	private:
-		std::vector<KeyframeList> keyframeLists;
-	public:
-		int getKeyframeListCount() const;
-		const KeyframeList &getKeyframeList(int index) const;
-
-		void addKeyframeList(KeyframeList &&keyframeList);
-		void clearKeyframeLists();
-	};
-
-	struct CitizenParams
-	{
-		// Each citizen has a unique palette instead of unique textures for memory savings. It was found
-		// through testing that hardly any citizen instances share textures due to variations in their
-		// random palette. As a result, citizen textures will need to be 8-bit.
-		Palette palette;
-	};
 private:
-	std::vector<State> states;
-	std::unique_ptr<CitizenParams> citizenParams; // Extra data for citizens.
-	double currentSeconds; // Seconds through current state.
+	int stateCount; // Number of states in the shared definition.
 	int stateIndex; // Active state, also usable with animation definition states.
+	double currentSeconds; // Seconds through current state.
+
+	// Palette override owned by the entity manager, or NO_PALETTE_ID. Each citizen has a unique palette
+	// instead of unique textures for memory savings. It was found through testing that hardly any citizen
+	// instances share textures due to variations in their random palette. As a result, citizen textures
+	// will need to be 8-bit.
+	EntityPaletteID paletteID;
 public:
 	EntityAnimationInstance();
-	EntityAnimationInstance(const EntityAnimationInstance &other);
-
-	EntityAnimationInstance &operator=(const EntityAnimationInstance &other);
 
 	void init(const EntityAnimationDefinition &animDef);
 
 	int getStateCount() const;
-	const State &getState(int index) const;
-	const CitizenParams *getCitizenParams() const;
-	double getCurrentSeconds() const;
 	int getStateIndex() const;
-
-	void setCitizenParams(std::unique_ptr<CitizenParams> &&citizenParams);
+	double getCurrentSeconds() const;
+	EntityPaletteID getPaletteID() const;
 
 	// Sets the active state index shared between this instance and its definition.
 	void setStateIndex(int index);
 
+	void setPaletteID(EntityPaletteID id);
+
 	void reset();
 	void resetTime();
 
@@ -0,0 +1,17 @@
+#ifndef ENTITY_ANIMATION_STATE_TYPE_H
+#define ENTITY_ANIMATION_STATE_TYPE_H
+
+// Animation states that engine code refers to directly. Each one matches a state name in
+// EntityAnimationUtils, and an animation definition resolves their indices when it is built.
+
+enum class EntityAnimationStateType
+{
+	Idle,
+	Look,
+	Walk,
+	Attack,
+	Death,
+	Activated
+};
+
+#endif
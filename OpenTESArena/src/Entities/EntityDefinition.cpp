@@ -71,6 +71,12 @@ void EntityDefinition::EnemyDefinition::initCreature(int creatureIndex, bool isF
 	this->creature.init(creatureIndex, isFinalBoss, exeData);
 }
 
+void EntityDefinition::EnemyDefinition::initCreature(const CreatureDefinition &creature)
+{
+	this->type = EnemyDefinition::Type::Creature;
+	this->creature = creature;
+}
+
 void EntityDefinition::EnemyDefinition::initHuman(bool male, int charClassID)
 {
 	this->type = EnemyDefinition::Type::Human;
@@ -323,6 +329,13 @@ void EntityDefinition::initEnemyCreature(int creatureIndex, bool isFinalBoss, co
 	this->enemy.initCreature(creatureIndex, isFinalBoss, exeData);
 }
 
+void EntityDefinition::initEnemyCreature(const EnemyDefinition::CreatureDefinition &creature,
+	EntityAnimationDefinition &&animDef)
+{
+	this->init(Type::Enemy, std::move(animDef));
+	this->enemy.initCreature(creature);
+}
+
 void EntityDefinition::initEnemyHuman(bool male, int charClassID, EntityAnimationDefinition &&animDef)
 {
 	this->init(Type::Enemy, std::move(animDef));
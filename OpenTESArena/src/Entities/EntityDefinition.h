@@ -81,6 +81,7 @@ public:
 		const HumanDefinition &getHuman() const;
 
 		void initCreature(int creatureIndex, bool isFinalBoss, const ExeData &exeData);
+		void initCreature(const CreatureDefinition &creature);
 		void initHuman(bool male, int charClassID);
 	};
 
@@ -294,6 +295,7 @@ public:
 	// Enemy.
 	void initEnemyCreature(int creatureIndex, bool isFinalBoss, const ExeData &exeData,
 		EntityAnimationDefinition &&animDef);
+	void initEnemyCreature(const EnemyDefinition::CreatureDefinition &creature, EntityAnimationDefinition &&animDef);
 	void initEnemyHuman(bool male, int charClassID, EntityAnimationDefinition &&animDef);
 
 	// Citizen.
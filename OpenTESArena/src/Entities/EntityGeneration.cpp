@@ -18,20 +18,20 @@ Entity *EntityGeneration::makeEntity(EntityType entityType, EntityDefinition::Ty
 	EntityAnimationInstance animInst;
 	animInst.init(animDef);
 
-	const std::string &defaultStateName = [&entityDef, &entityGenInfo]() -> const std::string&
+	const EntityAnimationStateType defaultStateType = [&entityDef, &entityGenInfo]()
 	{
 		if (!EntityUtils::isStreetlight(entityDef))
 		{
-			return EntityAnimationUtils::STATE_IDLE;
+			return EntityAnimationStateType::Idle;
 		}
 		else
 		{
 			return entityGenInfo.nightLightsAreActive ?
-				EntityAnimationUtils::STATE_ACTIVATED : EntityAnimationUtils::STATE_IDLE;
+				EntityAnimationStateType::Activated : EntityAnimationStateType::Idle;
 		}
 	}();
 
-	const std::optional<int> defaultStateIndex = animDef.tryGetStateIndex(defaultStateName.c_str());
+	const std::optional<int> defaultStateIndex = animDef.tryGetStateIndex(defaultStateType);
 	if (!defaultStateIndex.has_value())
 	{
 		DebugLogWarning("Couldn't get default state index for entity.");
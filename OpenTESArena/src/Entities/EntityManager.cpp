@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 
 #include "EntityDefinitionLibrary.h"
@@ -7,6 +8,7 @@
 #include "EntityType.h"
 #include "EntityVisibilityState.h"
 #include "../Assets/MIFUtils.h"
+#include "../Audio/AudioManager.h"
 #include "../Game/Game.h"
 #include "../Math/Constants.h"
 #include "../Math/MathUtils.h"
@@ -15,234 +17,241 @@
 
 #include "components/debug/Debug.h"
 
-template <typename T>
-int EntityManager::EntityGroup<T>::getCount() const
+namespace
 {
-	return static_cast<int>(this->entities.size());
-}
+	// Fewest entities per thread before ticking in parallel is worth the cost of waking worker threads.
+	constexpr int MIN_ENTITIES_PER_TICK_THREAD = 64;
 
-template <typename T>
-T *EntityManager::EntityGroup<T>::getEntityAtIndex(int index)
-{
-	DebugAssert(this->validEntities.size() == this->entities.size());
-	DebugAssertIndex(this->validEntities, index);
-	const bool isValid = this->validEntities[index];
-	return isValid ? &this->entities[index] : nullptr;
-}
+	// Combines the frame's seed with a chunk coordinate so each chunk's random numbers don't depend on
+	// where the chunk is in the entity chunk list.
+	int MakeChunkTickSeed(uint32_t frameSeed, const ChunkInt2 &chunk)
+	{
+		uint32_t seed = frameSeed;
+		seed ^= static_cast<uint32_t>(chunk.x) * 0x9E3779B1u;
+		seed = (seed << 13) | (seed >> 19);
+		seed ^= static_cast<uint32_t>(chunk.y) * 0x85EBCA77u;
+		return static_cast<int>(seed & 0x7FFFFFFF);
+	}
 
-template <typename T>
-const T *EntityManager::EntityGroup<T>::getEntityAtIndex(int index) const
-{
-	DebugAssert(this->validEntities.size() == this->entities.size());
-	DebugAssertIndex(this->validEntities, index);
-	const bool isValid = this->validEntities[index];
-	return isValid ? &this->entities[index] : nullptr;
-}
+	// Entity IDs are a slot index in the low bits and that slot's generation in the high bits. The sign
+	// bit is never used so IDs can't collide with EntityManager::NO_ID.
+	constexpr int ENTITY_SLOT_INDEX_BITS = 20;
+	constexpr int ENTITY_SLOT_INDEX_MASK = (1 << ENTITY_SLOT_INDEX_BITS) - 1;
+	constexpr int ENTITY_GENERATION_MASK = (1 << (31 - ENTITY_SLOT_INDEX_BITS)) - 1;
 
-template <typename T>
-int EntityManager::EntityGroup<T>::getEntities(Entity **outEntities, int outSize)
-{
-	DebugAssert(outEntities != nullptr);
-	DebugAssert(outSize >= 0);
-	DebugAssert(this->validEntities.size() == this->entities.size());
+	EntityID MakeEntityID(int slotIndex, int generation)
+	{
+		return (generation << ENTITY_SLOT_INDEX_BITS) | slotIndex;
+	}
 
-	int writeIndex = 0;
-	const int count = this->getCount();
-	for (int i = 0; i < count; i++)
+	int GetEntitySlotIndex(EntityID id)
 	{
-		// Break if the destination buffer is full.
-		if (writeIndex == outSize)
-		{
-			break;
-		}
+		return id & ENTITY_SLOT_INDEX_MASK;
+	}
 
-		DebugAssertIndex(this->validEntities, i);
-		const bool isValid = this->validEntities[i];
+	int GetEntityGeneration(EntityID id)
+	{
+		return (id >> ENTITY_SLOT_INDEX_BITS) & ENTITY_GENERATION_MASK;
+	}
 
-		// Skip if entity is not valid.
-		if (!isValid)
+	// Ordering for voxels in a chunk's sorted voxel->entity look-up.
+	bool VoxelLessThan(const VoxelInt3 &a, const VoxelInt3 &b)
+	{
+		if (a.x != b.x)
 		{
-			continue;
+			return a.x < b.x;
 		}
+		else if (a.y != b.y)
+		{
+			return a.y < b.y;
+		}
+		else
+		{
+			return a.z < b.z;
+		}
+	}
 
-		T &entity = this->entities[i];
-		outEntities[writeIndex] = &entity;
-		writeIndex++;
+	// Gets a dynamic entity's facing relative to the eye as an angle into its animation's keyframe lists.
+	Radians GetDynamicAnimAngle(double dirX, double dirY, double eyeDirX, double eyeDirY, int angleCount)
+	{
+		const Radians entityAngle = MathUtils::fullAtan2(NewDouble2(dirX, dirY));
+		const Radians diffAngle = MathUtils::fullAtan2(NewDouble2(eyeDirX, eyeDirY));
+
+		// Use the difference of the two angles to get the relative angle.
+		const Radians resultAngle = Constants::TwoPi + (entityAngle - diffAngle);
+
+		// Angle bias so the final direction is centered within its angle range.
+		const Radians angleBias = (Constants::TwoPi / static_cast<double>(angleCount)) * 0.50;
+
+		return std::fmod(resultAngle + angleBias, Constants::TwoPi);
 	}
 
-	return writeIndex;
-}
+	// Index into animation keyframe lists for a state.
+	int GetAnimAngleIndex(Radians animAngle, int angleCount)
+	{
+		const double angleCountReal = static_cast<double>(angleCount);
+		const double anglePercent = animAngle / Constants::TwoPi;
+		const int angleIndex = static_cast<int>(angleCountReal * anglePercent);
+		return std::clamp(angleIndex, 0, angleCount - 1);
+	}
 
-template <typename T>
-int EntityManager::EntityGroup<T>::getEntities(const Entity **outEntities, int outSize) const
-{
-	DebugAssert(outEntities != nullptr);
-	DebugAssert(outSize >= 0);
-	DebugAssert(this->validEntities.size() == this->entities.size());
+	// Progress through the current animation.
+	int GetAnimKeyframeIndex(double animCurSeconds, double animTotalSeconds, int keyframeCount)
+	{
+		const double keyframeCountReal = static_cast<double>(keyframeCount);
+		const double animPercent = animCurSeconds / animTotalSeconds;
+		const int keyframeIndex = static_cast<int>(keyframeCountReal * animPercent);
+		return std::clamp(keyframeIndex, 0, keyframeCount - 1);
+	}
 
-	int writeIndex = 0;
-	const int count = this->getCount();
-	for (int i = 0; i < count; i++)
+	// Gets the bottom center of an entity's flat, set on top of any raised platform it is in.
+	CoordDouble3 GetFlatPosition3D(const CoordDouble2 &flatPosition2D, const EntityDefinition &entityDef,
+		double ceilingScale, const ChunkManager &chunkManager)
 	{
-		// Break if the destination buffer is full.
-		if (writeIndex == outSize)
+		const int baseYOffset = EntityUtils::getYOffset(entityDef);
+		const double flatYOffset = static_cast<double>(-baseYOffset) / MIFUtils::ARENA_UNITS;
+
+		// If the entity is in a raised platform voxel, they are set on top of it.
+		const double raisedPlatformYOffset = [&flatPosition2D, ceilingScale, &chunkManager]()
 		{
-			break;
-		}
+			const CoordInt2 entityVoxelCoord(
+				flatPosition2D.chunk,
+				VoxelUtils::pointToVoxel(flatPosition2D.point));
+			const Chunk *chunk = chunkManager.tryGetChunk(entityVoxelCoord.chunk);
+			if (chunk == nullptr)
+			{
+				// Not sure this is ever reachable, but handle just in case.
+				return 0.0;
+			}
 
-		DebugAssertIndex(this->validEntities, i);
-		const bool isValid = this->validEntities[i];
+			const Chunk::VoxelID voxelID = chunk->getVoxel(entityVoxelCoord.voxel.x, 1, entityVoxelCoord.voxel.y);
+			const VoxelDefinition &voxelDef = chunk->getVoxelDef(voxelID);
 
-		// Skip if entity is not valid.
-		if (!isValid)
-		{
-			continue;
-		}
+			if (voxelDef.type == ArenaTypes::VoxelType::Raised)
+			{
+				const VoxelDefinition::RaisedData &raised = voxelDef.raised;
+				return (raised.yOffset + raised.ySize) * ceilingScale;
+			}
+			else
+			{
+				// No raised platform offset.
+				return 0.0;
+			}
+		}();
 
-		const T &entity = this->entities[i];
-		outEntities[writeIndex] = &entity;
-		writeIndex++;
+		const VoxelDouble3 flatPoint(
+			flatPosition2D.point.x,
+			ceilingScale + flatYOffset + raisedPlatformYOffset,
+			flatPosition2D.point.y);
+		return CoordDouble3(flatPosition2D.chunk, flatPoint);
 	}
-
-	return writeIndex;
 }
 
 template <typename T>
-std::optional<int> EntityManager::EntityGroup<T>::getEntityIndex(EntityID id) const
+int EntityManager::EntityGroup<T>::getCount() const
 {
-	const auto iter = this->indices.find(id);
-	if (iter != this->indices.end())
-	{
-		return iter->second;
-	}
-	else
-	{
-		return std::nullopt;
-	}
+	return static_cast<int>(this->entities.size());
 }
 
 template <typename T>
-int EntityManager::EntityGroup<T>::nextFreeIndex()
+T *EntityManager::EntityGroup<T>::getEntityAtIndex(int index)
 {
-	int index;
-	if (this->freeIndices.size() > 0)
-	{
-		// Reuse a previously-owned entity slot.
-		index = this->freeIndices.back();
-		this->freeIndices.pop_back();
-
-		DebugAssertIndex(this->validEntities, index);
-		this->validEntities[index] = true;
-	}
-	else
-	{
-		// Insert new at the end of the entities list.
-		index = static_cast<int>(this->entities.size());
-		this->entities.push_back(T());
-		this->validEntities.push_back(true);
-	}
-
-	return index;
+	DebugAssertIndex(this->entities, index);
+	return &this->entities[index];
 }
 
 template <typename T>
-T *EntityManager::EntityGroup<T>::addEntity(EntityID id)
+const T *EntityManager::EntityGroup<T>::getEntityAtIndex(int index) const
 {
-	DebugAssert(id != EntityManager::NO_ID);
-	DebugAssert(this->validEntities.size() == this->entities.size());
-
-	// Entity ID must not already be in use.
-	DebugAssert(!this->getEntityIndex(id).has_value());
-
-	// Find available position in entities array, allocating space if needed.
-	const int index = this->nextFreeIndex();
-
-	// Initialize basic entity data.
 	DebugAssertIndex(this->entities, index);
-	T &entitySlot = this->entities[index];
-	entitySlot.reset();
-	entitySlot.setID(id);
-
-	// Insert into ID -> entity index table.
-	this->indices.insert(std::make_pair(id, index));
-
-	return &entitySlot;
+	return &this->entities[index];
 }
 
 template <typename T>
-bool EntityManager::EntityGroup<T>::tryAcquireEntity(EntityID id, EntityGroup<T> &oldGroup)
+int EntityManager::EntityGroup<T>::getEntities(Entity **outEntities, int outSize)
 {
-	if (id == EntityManager::NO_ID)
-	{
-		DebugLogWarning("Cannot acquire invalid entity.");
-		return false;
-	}
+	DebugAssert(outEntities != nullptr);
+	DebugAssert(outSize >= 0);
 
-	// Entity ID must not already be in use.
-	if (this->getEntityIndex(id).has_value())
+	const int writeCount = std::min(this->getCount(), outSize);
+	for (int i = 0; i < writeCount; i++)
 	{
-		DebugLogWarning("Entity \"" + std::to_string(id) + "\" already in this group.");
-		return false;
+		outEntities[i] = &this->entities[i];
 	}
 
-	std::optional<int> oldEntityIndex = oldGroup.getEntityIndex(id);
-	if (!oldEntityIndex.has_value())
-	{
-		DebugLogWarning("Entity \"" + std::to_string(id) + "\" not in old group.");
-		return false;
-	}
+	return writeCount;
+}
 
-	// Move entity from old group to new group.
-	const int newEntityIndex = this->nextFreeIndex();
-	DebugAssertIndex(this->entities, newEntityIndex);
-	this->entities[newEntityIndex] = std::move(oldGroup.entities[*oldEntityIndex]);
-	this->indices.insert(std::make_pair(id, newEntityIndex));
+template <typename T>
+int EntityManager::EntityGroup<T>::getEntities(const Entity **outEntities, int outSize) const
+{
+	DebugAssert(outEntities != nullptr);
+	DebugAssert(outSize >= 0);
 
-	// Clean up old group.
-	oldGroup.validEntities[*oldEntityIndex] = false;
-	oldGroup.indices.erase(id);
-	oldGroup.freeIndices.push_back(*oldEntityIndex);
+	const int writeCount = std::min(this->getCount(), outSize);
+	for (int i = 0; i < writeCount; i++)
+	{
+		outEntities[i] = &this->entities[i];
+	}
 
-	return true;
+	return writeCount;
 }
 
 template <typename T>
-void EntityManager::EntityGroup<T>::remove(EntityID id)
+T *EntityManager::EntityGroup<T>::addEntity(EntityID id)
 {
 	DebugAssert(id != EntityManager::NO_ID);
-	DebugAssert(this->validEntities.size() == this->entities.size());
 
-	// Find entity with the given ID.
-	const std::optional<int> optIndex = this->getEntityIndex(id);
-	if (optIndex.has_value())
-	{
-		const int index = optIndex.value();
+	// Initialize basic entity data.
+	T &entity = this->entities.emplace_back();
+	entity.reset();
+	entity.setID(id);
+	return &entity;
+}
 
-		// Clear entity slot.
-		DebugAssertIndex(this->entities, index);
-		this->entities[index].reset();
-		this->validEntities[index] = false;
+template <typename T>
+EntityID EntityManager::EntityGroup<T>::acquireEntity(int oldIndex, EntityGroup<T> &oldGroup)
+{
+	DebugAssert(&oldGroup != this);
+	DebugAssertIndex(oldGroup.entities, oldIndex);
 
-		// Clear ID mapping.
-		this->indices.erase(id);
+	// Move entity from old group to new group, then clean up the old group.
+	this->entities.emplace_back(std::move(oldGroup.entities[oldIndex]));
+	return oldGroup.remove(oldIndex);
+}
 
-		// Add entity index to previously-owned slots list.
-		this->freeIndices.push_back(index);
-	}
-	else
+template <typename T>
+EntityID EntityManager::EntityGroup<T>::remove(int index)
+{
+	DebugAssertIndex(this->entities, index);
+
+	// Fill the hole with the last entity so the group stays packed.
+	const int lastIndex = static_cast<int>(this->entities.size()) - 1;
+	EntityID movedID = EntityManager::NO_ID;
+	if (index != lastIndex)
 	{
-		// Not in entity group.
-		DebugLogWarning("Tried to remove missing entity \"" + std::to_string(id) + "\".");
+		this->entities[index] = std::move(this->entities[lastIndex]);
+		movedID = this->entities[index].getID();
 	}
+
+	this->entities.pop_back();
+	return movedID;
 }
 
 template <typename T>
 void EntityManager::EntityGroup<T>::clear()
 {
 	this->entities.clear();
-	this->validEntities.clear();
-	this->indices.clear();
-	this->freeIndices.clear();
+}
+
+void EntityManager::EntitySlot::init()
+{
+	this->chunkIndex = -1;
+	this->entityIndex = -1;
+	this->type = static_cast<EntityType>(-1);
+	this->generation = 0;
+	this->hasVoxelRange = false;
+	this->isVoxelRangeDirty = false;
 }
 
 void EntityManager::EntityChunk::init(const ChunkInt2 &chunk)
@@ -250,100 +259,182 @@ void EntityManager::EntityChunk::init(const ChunkInt2 &chunk)
 	this->chunk = chunk;
 }
 
+void EntityManager::EntityChunk::addVoxelEntity(const VoxelInt3 &voxel, EntityID id)
+{
+	const auto iter = std::upper_bound(this->entityVoxels.begin(), this->entityVoxels.end(), voxel, VoxelLessThan);
+	const int index = static_cast<int>(std::distance(this->entityVoxels.begin(), iter));
+	this->entityVoxels.insert(iter, voxel);
+	this->voxelEntityIDs.insert(this->voxelEntityIDs.begin() + index, id);
+}
+
+void EntityManager::EntityChunk::removeVoxelEntity(const VoxelInt3 &voxel, EntityID id)
+{
+	const auto range = std::equal_range(this->entityVoxels.begin(), this->entityVoxels.end(), voxel, VoxelLessThan);
+	const int startIndex = static_cast<int>(std::distance(this->entityVoxels.begin(), range.first));
+	const int endIndex = static_cast<int>(std::distance(this->entityVoxels.begin(), range.second));
+	for (int i = startIndex; i < endIndex; i++)
+	{
+		if (this->voxelEntityIDs[i] == id)
+		{
+			this->entityVoxels.erase(this->entityVoxels.begin() + i);
+			this->voxelEntityIDs.erase(this->voxelEntityIDs.begin() + i);
+			return;
+		}
+	}
+
+	DebugLogWarning("Entity \"" + std::to_string(id) + "\" wasn't in voxel look-up of chunk \"" +
+		this->chunk.toString() + "\".");
+}
+
 void EntityManager::EntityChunk::clear()
 {
 	this->staticGroup.clear();
 	this->dynamicGroup.clear();
+	this->staticVisibility.clear();
+	this->dynamicVisibility.clear();
+	this->entityVoxels.clear();
+	this->voxelEntityIDs.clear();
 }
 
 EntityManager::EntityManager()
 {
-	this->nextID = 0;
+	this->visibilityCeilingScale = 0.0;
 }
 
 EntityID EntityManager::nextFreeID()
 {
-	// Check if any pre-owned entity IDs are available.
-	if (this->freeIDs.size() > 0)
+	// Check if any pre-owned slots are available.
+	int slotIndex;
+	if (this->freeSlotIndices.size() > 0)
 	{
-		const EntityID id = this->freeIDs.back();
-		this->freeIDs.pop_back();
-		return id;
+		slotIndex = this->freeSlotIndices.back();
+		this->freeSlotIndices.pop_back();
 	}
 	else
 	{
-		// Get the next available ID.
-		const EntityID id = this->nextID;
-		this->nextID++;
-		return id;
+		slotIndex = static_cast<int>(this->slots.size());
+		DebugAssertMsg(slotIndex <= ENTITY_SLOT_INDEX_MASK, "Too many entities.");
+
+		EntitySlot slot;
+		slot.init();
+		this->slots.emplace_back(std::move(slot));
 	}
+
+	DebugAssertIndex(this->slots, slotIndex);
+	const EntitySlot &slot = this->slots[slotIndex];
+	return MakeEntityID(slotIndex, slot.generation);
 }
 
-EntityRef EntityManager::makeEntity(EntityType type)
+EntityManager::EntitySlot *EntityManager::tryGetSlot(EntityID id)
 {
-	// Get the default chunk for creating the entity in.
-	DebugAssertMsg(!this->entityChunks.empty(), "Need at least one active chunk for creating an entity.");
-	EntityChunk &defaultEntityChunk = this->entityChunks.front();
+	if (id == EntityManager::NO_ID)
+	{
+		return nullptr;
+	}
 
-	const EntityID id = this->nextFreeID();
-	EntityRef entityRef = [this, type, &defaultEntityChunk, id]()
+	const int slotIndex = GetEntitySlotIndex(id);
+	if (slotIndex >= static_cast<int>(this->slots.size()))
 	{
-		// Instantiate the entity based on their type.
-		if (type == EntityType::Static)
-		{
-			EntityGroup<StaticEntity> &group = defaultEntityChunk.staticGroup;
-			StaticEntity *entity = group.addEntity(id);
-			return EntityRef(this, id, type);
-		}
-		else if (type == EntityType::Dynamic)
-		{
-			EntityGroup<DynamicEntity> &group = defaultEntityChunk.dynamicGroup;
-			DynamicEntity *entity = group.addEntity(id);
-			return EntityRef(this, id, type);
-		}
-		else
-		{
-			DebugNotImplementedMsg(std::to_string(static_cast<int>(type)));
-			return EntityRef(nullptr, EntityManager::NO_ID, static_cast<EntityType>(-1));
-		}
-	}();
+		return nullptr;
+	}
 
-	DebugAssert(entityRef.getID() == id);
-	return entityRef;
+	EntitySlot &slot = this->slots[slotIndex];
+	const bool isLive = (slot.chunkIndex >= 0) && (slot.generation == GetEntityGeneration(id));
+	return isLive ? &slot : nullptr;
 }
 
-template <typename T>
-T *EntityManager::getInternal(EntityID id, EntityGroup<T> &group)
+const EntityManager::EntitySlot *EntityManager::tryGetSlot(EntityID id) const
 {
 	if (id == EntityManager::NO_ID)
 	{
 		return nullptr;
 	}
 
-	const std::optional<int> index = group.getEntityIndex(id);
-	if (!index.has_value())
+	const int slotIndex = GetEntitySlotIndex(id);
+	if (slotIndex >= static_cast<int>(this->slots.size()))
 	{
 		return nullptr;
 	}
 
-	return group.getEntityAtIndex(*index);
+	const EntitySlot &slot = this->slots[slotIndex];
+	const bool isLive = (slot.chunkIndex >= 0) && (slot.generation == GetEntityGeneration(id));
+	return isLive ? &slot : nullptr;
 }
 
-template <typename T>
-const T *EntityManager::getInternal(EntityID id, const EntityGroup<T> &group) const
+void EntityManager::freeSlot(EntityID id)
+{
+	EntitySlot *slot = this->tryGetSlot(id);
+	DebugAssert(slot != nullptr);
+
+	this->removeVoxelEntityMappings(id, *slot);
+	slot->isVoxelRangeDirty = false;
+
+	// Bump the generation so any copies of the ID are now invalid.
+	slot->chunkIndex = -1;
+	slot->entityIndex = -1;
+	slot->generation = (slot->generation + 1) & ENTITY_GENERATION_MASK;
+	this->freeSlotIndices.push_back(GetEntitySlotIndex(id));
+}
+
+void EntityManager::freeEntityPalette(const Entity &entity)
+{
+	const EntityPaletteID paletteID = entity.getAnimInstance().getPaletteID();
+	if (paletteID != EntityManager::NO_PALETTE_ID)
+	{
+		DebugAssertIndex(this->palettes, paletteID);
+		this->freePaletteIDs.push_back(paletteID);
+	}
+}
+
+void EntityManager::updateSlotEntityIndex(EntityID id, int entityIndex)
 {
 	if (id == EntityManager::NO_ID)
 	{
-		return nullptr;
+		// Nothing was moved.
+		return;
 	}
 
-	const std::optional<int> index = group.getEntityIndex(id);
-	if (!index.has_value())
+	EntitySlot *slot = this->tryGetSlot(id);
+	DebugAssert(slot != nullptr);
+	slot->entityIndex = entityIndex;
+}
+
+EntityRef EntityManager::makeEntity(EntityType type)
+{
+	// Get the default chunk for creating the entity in.
+	DebugAssertMsg(!this->entityChunks.empty(), "Need at least one active chunk for creating an entity.");
+	constexpr int defaultChunkIndex = 0;
+	EntityChunk &defaultEntityChunk = this->entityChunks[defaultChunkIndex];
+
+	// Instantiate the entity based on their type.
+	int entityIndex;
+	const EntityID id = this->nextFreeID();
+	if (type == EntityType::Static)
 	{
-		return nullptr;
+		EntityGroup<StaticEntity> &group = defaultEntityChunk.staticGroup;
+		group.addEntity(id);
+		entityIndex = group.getCount() - 1;
+	}
+	else if (type == EntityType::Dynamic)
+	{
+		EntityGroup<DynamicEntity> &group = defaultEntityChunk.dynamicGroup;
+		group.addEntity(id);
+		entityIndex = group.getCount() - 1;
+	}
+	else
+	{
+		this->freeSlotIndices.push_back(GetEntitySlotIndex(id));
+		DebugNotImplementedMsg(std::to_string(static_cast<int>(type)));
+		return EntityRef(nullptr, EntityManager::NO_ID, static_cast<EntityType>(-1));
 	}
 
-	return group.getEntityAtIndex(*index);
+	EntitySlot &slot = this->slots[GetEntitySlotIndex(id)];
+	slot.chunkIndex = defaultChunkIndex;
+	slot.entityIndex = entityIndex;
+	slot.type = type;
+	this->markVoxelRangeDirty(id, slot);
+
+	return EntityRef(this, id, type);
 }
 
 std::optional<int> EntityManager::tryGetChunkIndex(const ChunkInt2 &chunk) const
@@ -366,108 +457,76 @@ std::optional<int> EntityManager::tryGetChunkIndex(const ChunkInt2 &chunk) const
 
 Entity *EntityManager::getEntityHandle(EntityID id, EntityType type)
 {
-	for (EntityChunk &entityChunk : this->entityChunks)
+	const EntitySlot *slot = this->tryGetSlot(id);
+	if ((slot == nullptr) || (slot->type != type))
 	{
-		if (type == EntityType::Static)
-		{
-			EntityGroup<StaticEntity> &group = entityChunk.staticGroup;
-			StaticEntity *entity = this->getInternal(id, group);
-			if (entity != nullptr)
-			{
-				return entity;
-			}
-		}
-		else if (type == EntityType::Dynamic)
-		{
-			EntityGroup<DynamicEntity> &group = entityChunk.dynamicGroup;
-			DynamicEntity *entity = this->getInternal(id, group);
-			if (entity != nullptr)
-			{
-				return entity;
-			}
-		}
-		else
-		{
-			DebugNotImplementedMsg(std::to_string(static_cast<int>(type)));
-		}
+		return nullptr;
 	}
 
-	return nullptr;
+	DebugAssertIndex(this->entityChunks, slot->chunkIndex);
+	EntityChunk &entityChunk = this->entityChunks[slot->chunkIndex];
+	if (type == EntityType::Static)
+	{
+		return entityChunk.staticGroup.getEntityAtIndex(slot->entityIndex);
+	}
+	else if (type == EntityType::Dynamic)
+	{
+		return entityChunk.dynamicGroup.getEntityAtIndex(slot->entityIndex);
+	}
+	else
+	{
+		DebugNotImplementedMsg(std::to_string(static_cast<int>(type)));
+		return nullptr;
+	}
 }
 
 const Entity *EntityManager::getEntityHandle(EntityID id, EntityType type) const
 {
-	for (const EntityChunk &entityChunk : this->entityChunks)
+	const EntitySlot *slot = this->tryGetSlot(id);
+	if ((slot == nullptr) || (slot->type != type))
 	{
-		if (type == EntityType::Static)
-		{
-			const EntityGroup<StaticEntity> &group = entityChunk.staticGroup;
-			const StaticEntity *entity = this->getInternal(id, group);
-			if (entity != nullptr)
-			{
-				return entity;
-			}
-		}
-		else if (type == EntityType::Dynamic)
-		{
-			const EntityGroup<DynamicEntity> &group = entityChunk.dynamicGroup;
-			const DynamicEntity *entity = this->getInternal(id, group);
-			if (entity != nullptr)
-			{
-				return entity;
-			}
-		}
-		else
-		{
-			DebugNotImplementedMsg(std::to_string(static_cast<int>(type)));
-		}
+		return nullptr;
 	}
 
-	return nullptr;
+	DebugAssertIndex(this->entityChunks, slot->chunkIndex);
+	const EntityChunk &entityChunk = this->entityChunks[slot->chunkIndex];
+	if (type == EntityType::Static)
+	{
+		return entityChunk.staticGroup.getEntityAtIndex(slot->entityIndex);
+	}
+	else if (type == EntityType::Dynamic)
+	{
+		return entityChunk.dynamicGroup.getEntityAtIndex(slot->entityIndex);
+	}
+	else
+	{
+		DebugNotImplementedMsg(std::to_string(static_cast<int>(type)));
+		return nullptr;
+	}
 }
 
 Entity *EntityManager::getEntityHandle(EntityID id)
 {
-	// Find which entity group the given entity ID is in. This is a slow look-up because there is
-	// no hint where the entity is at.
-	Entity *entity = this->getEntityHandle(id, EntityType::Static);
-	if (entity != nullptr)
-	{
-		// Static entity.
-		return entity;
-	}
-
-	entity = this->getEntityHandle(id, EntityType::Dynamic);
-	if (entity != nullptr)
+	// The slot knows which entity group the entity is in.
+	const EntitySlot *slot = this->tryGetSlot(id);
+	if (slot == nullptr)
 	{
-		// Dynamic entity.
-		return entity;
+		return nullptr;
 	}
 
-	// Not in any entity group.
-	return nullptr;
+	return this->getEntityHandle(id, slot->type);
 }
 
 const Entity *EntityManager::getEntityHandle(EntityID id) const
 {
-	// Find which entity group the given entity ID is in. This is a slow look-up because there is
-	// no hint where the entity is at.
-	const Entity *entity = this->getEntityHandle(id, EntityType::Static);
-	if (entity != nullptr)
+	// The slot knows which entity group the entity is in.
+	const EntitySlot *slot = this->tryGetSlot(id);
+	if (slot == nullptr)
 	{
-		// Static entity.
-		return entity;
-	}
-
-	entity = this->getEntityHandle(id, EntityType::Dynamic);
-	if (entity != nullptr)
-	{
-		// Dynamic entity.
-		return entity;
+		return nullptr;
 	}
 
-	// Not in any entity group.
-	return nullptr;
+	return this->getEntityHandle(id, slot->type);
 }
 
 EntityRef EntityManager::getEntityRef(EntityID id, EntityType type)
@@ -483,16 +542,16 @@ ConstEntityRef EntityManager::getEntityRef(EntityID id, EntityType type) const
 EntityRef EntityManager::getEntityRef(EntityID id)
 {
 	// Get the entity's type if possible.
-	Entity *entity = this->getEntityHandle(id);
-	EntityType entityType = (entity != nullptr) ? entity->getEntityType() : EntityType::Static;
+	const EntitySlot *slot = this->tryGetSlot(id);
+	const EntityType entityType = (slot != nullptr) ? slot->type : EntityType::Static;
 	return this->getEntityRef(id, entityType);
 }
 
 ConstEntityRef EntityManager::getEntityRef(EntityID id) const
 {
 	// Get the entity's type if possible.
-	const Entity *entity = this->getEntityHandle(id);
-	EntityType entityType = (entity != nullptr) ? entity->getEntityType() : EntityType::Static;
+	const EntitySlot *slot = this->tryGetSlot(id);
+	const EntityType entityType = (slot != nullptr) ? slot->type : EntityType::Static;
 	return this->getEntityRef(id, entityType);
 }
 
@@ -718,6 +777,313 @@ EntityDefID EntityManager::addEntityDef(EntityDefinition &&def,
 	return defID;
 }
 
+EntityPaletteID EntityManager::addEntityPalette(const Palette &palette)
+{
+	// Reuse a previously-owned palette if possible.
+	EntityPaletteID id;
+	if (this->freePaletteIDs.size() > 0)
+	{
+		id = this->freePaletteIDs.back();
+		this->freePaletteIDs.pop_back();
+
+		DebugAssertIndex(this->palettes, id);
+		this->palettes[id] = palette;
+	}
+	else
+	{
+		id = static_cast<EntityPaletteID>(this->palettes.size());
+		this->palettes.emplace_back(palette);
+	}
+
+	return id;
+}
+
+const Palette &EntityManager::getEntityPalette(EntityPaletteID id) const
+{
+	DebugAssertIndex(this->palettes, id);
+	return this->palettes[id];
+}
+
+template <typename T>
+void EntityManager::updateGroupVisibility(const EntityGroup<T> &group, const CoordDouble2 &eye2D,
+	double ceilingScale, const ChunkManager &chunkManager, const EntityDefinitionLibrary &entityDefLibrary,
+	std::vector<CachedVisibility> &outVisibility)
+{
+	const int count = group.getCount();
+	outVisibility.resize(count);
+
+	// Gather facing inputs into contiguous arrays so the angle math runs in one tight loop.
+	VisibilityScratch &scratch = this->visibilityScratch;
+	scratch.resize(count);
+	for (int i = 0; i < count; i++)
+	{
+		const T &entity = *group.getEntityAtIndex(i);
+		const EntityDefinition &entityDef = this->getEntityDef(entity.getDefinitionID(), entityDefLibrary);
+		const EntityAnimationDefinition &animDef = entityDef.getAnimDef();
+		const EntityAnimationDefinition::State &animDefState = animDef.getState(entity.getAnimInstance().getStateIndex());
+		scratch.angleCounts[i] = animDefState.getKeyframeListCount();
+
+		if constexpr (std::is_same_v<T, DynamicEntity>)
+		{
+			const NewDouble2 &entityDir = entity.getDirection();
+			const VoxelDouble2 eyeDir = (eye2D - entity.getPosition()).normalized();
+			scratch.dirXs[i] = entityDir.x;
+			scratch.dirYs[i] = entityDir.y;
+			scratch.eyeDirXs[i] = eyeDir.x;
+			scratch.eyeDirYs[i] = eyeDir.y;
+		}
+	}
+
+	if constexpr (std::is_same_v<T, DynamicEntity>)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			scratch.animAngles[i] = GetDynamicAnimAngle(scratch.dirXs[i], scratch.dirYs[i],
+				scratch.eyeDirXs[i], scratch.eyeDirYs[i], scratch.angleCounts[i]);
+		}
+	}
+	else
+	{
+		// Static entities always face the camera.
+		std::fill(scratch.animAngles.begin(), scratch.animAngles.begin() + count, 0.0);
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		const T &entity = *group.getEntityAtIndex(i);
+		const EntityDefinition &entityDef = this->getEntityDef(entity.getDefinitionID(), entityDefLibrary);
+		const EntityAnimationDefinition &animDef = entityDef.getAnimDef();
+		const EntityAnimationInstance &animInst = entity.getAnimInstance();
+		const int stateIndex = animInst.getStateIndex();
+		const EntityAnimationDefinition::State &animDefState = animDef.getState(stateIndex);
+
+		const int angleIndex = GetAnimAngleIndex(scratch.animAngles[i], scratch.angleCounts[i]);
+		const EntityAnimationDefinition::KeyframeList &animDefKeyframeList = animDefState.getKeyframeList(angleIndex);
+		const int keyframeIndex = GetAnimKeyframeIndex(animInst.getCurrentSeconds(),
+			animDefState.getTotalSeconds(), animDefKeyframeList.getKeyframeCount());
+
+		const CoordDouble2 &entityCoord = entity.getPosition();
+		const CoordDouble3 flatPosition = GetFlatPosition3D(entityCoord, entityDef, ceilingScale, chunkManager);
+
+		CachedVisibility &visibility = outVisibility[i];
+		visibility.visState.init(&entity, flatPosition, stateIndex, angleIndex, keyframeIndex);
+		visibility.id = entity.getID();
+		visibility.position = entityCoord;
+		entity.getViewIndependentBBox3D(flatPosition.point.y, *this, entityDefLibrary,
+			&visibility.bboxMin, &visibility.bboxMax);
+	}
+}
+
+void EntityManager::VisibilityScratch::resize(int count)
+{
+	this->dirXs.resize(count);
+	this->dirYs.resize(count);
+	this->eyeDirXs.resize(count);
+	this->eyeDirYs.resize(count);
+	this->angleCounts.resize(count);
+	this->animAngles.resize(count);
+}
+
+const EntityManager::CachedVisibility *EntityManager::tryGetCachedVisibility(const Entity &entity,
+	double ceilingScale) const
+{
+	if (!this->visibilityEye.has_value() || (ceilingScale != this->visibilityCeilingScale))
+	{
+		return nullptr;
+	}
+
+	const EntitySlot *slot = this->tryGetSlot(entity.getID());
+	if (slot == nullptr)
+	{
+		return nullptr;
+	}
+
+	DebugAssertIndex(this->entityChunks, slot->chunkIndex);
+	const EntityChunk &entityChunk = this->entityChunks[slot->chunkIndex];
+	const std::vector<CachedVisibility> &visibilities = (slot->type == EntityType::Static) ?
+		entityChunk.staticVisibility : entityChunk.dynamicVisibility;
+	if (slot->entityIndex >= static_cast<int>(visibilities.size()))
+	{
+		// Added since the last update.
+		return nullptr;
+	}
+
+	// Entities can be moved around in their group or change position after the update.
+	const CachedVisibility &visibility = visibilities[slot->entityIndex];
+	const CoordDouble2 &position = entity.getPosition();
+	const bool isCurrent = (visibility.id == entity.getID()) && (visibility.visState.entity == &entity) &&
+		(visibility.position.chunk == position.chunk) && (visibility.position.point == position.point);
+	return isCurrent ? &visibility : nullptr;
+}
+
+void EntityManager::markVoxelRangeDirty(EntityID id, EntitySlot &slot)
+{
+	if (!slot.isVoxelRangeDirty)
+	{
+		slot.isVoxelRangeDirty = true;
+		this->voxelDirtyEntityIDs.emplace_back(id);
+	}
+}
+
+void EntityManager::addVoxelEntityMappings(EntityID id, EntitySlot &slot, const CoordInt3 &minVoxelCoord,
+	const CoordInt3 &maxVoxelCoord)
+{
+	DebugAssert(!slot.hasVoxelRange);
+	const VoxelInt3 voxelCoordDiff = maxVoxelCoord - minVoxelCoord;
+
+	// Iterate over the voxels the entity's bounding box touches.
+	for (WEInt z = 0; z <= voxelCoordDiff.z; z++)
+	{
+		for (int y = 0; y <= voxelCoordDiff.y; y++)
+		{
+			for (SNInt x = 0; x <= voxelCoordDiff.x; x++)
+			{
+				const VoxelInt3 curVoxel(
+					minVoxelCoord.voxel.x + x,
+					minVoxelCoord.voxel.y + y,
+					minVoxelCoord.voxel.z + z);
+				const CoordInt3 coord = ChunkUtils::recalculateCoord(minVoxelCoord.chunk, curVoxel);
+
+				// Voxels in chunks that aren't loaded are mapped when their chunk is added.
+				const std::optional<int> chunkIndex = this->tryGetChunkIndex(coord.chunk);
+				if (chunkIndex.has_value())
+				{
+					this->entityChunks[*chunkIndex].addVoxelEntity(coord.voxel, id);
+				}
+			}
+		}
+	}
+
+	slot.hasVoxelRange = true;
+	slot.voxelRangeMin = minVoxelCoord;
+	slot.voxelRangeMax = maxVoxelCoord;
+}
+
+void EntityManager::removeVoxelEntityMappings(EntityID id, EntitySlot &slot)
+{
+	if (!slot.hasVoxelRange)
+	{
+		return;
+	}
+
+	const CoordInt3 &minVoxelCoord = slot.voxelRangeMin;
+	const VoxelInt3 voxelCoordDiff = slot.voxelRangeMax - minVoxelCoord;
+	for (WEInt z = 0; z <= voxelCoordDiff.z; z++)
+	{
+		for (int y = 0; y <= voxelCoordDiff.y; y++)
+		{
+			for (SNInt x = 0; x <= voxelCoordDiff.x; x++)
+			{
+				const VoxelInt3 curVoxel(
+					minVoxelCoord.voxel.x + x,
+					minVoxelCoord.voxel.y + y,
+					minVoxelCoord.voxel.z + z);
+				const CoordInt3 coord = ChunkUtils::recalculateCoord(minVoxelCoord.chunk, curVoxel);
+				const std::optional<int> chunkIndex = this->tryGetChunkIndex(coord.chunk);
+				if (chunkIndex.has_value())
+				{
+					this->entityChunks[*chunkIndex].removeVoxelEntity(coord.voxel, id);
+				}
+			}
+		}
+	}
+
+	slot.hasVoxelRange = false;
+}
+
+void EntityManager::updateVoxelEntityMappings(double ceilingScale)
+{
+	for (const EntityID entityID : this->voxelDirtyEntityIDs)
+	{
+		EntitySlot *slot = this->tryGetSlot(entityID);
+		if ((slot == nullptr) || !slot->isVoxelRangeDirty)
+		{
+			// Removed since it was queued.
+			continue;
+		}
+
+		slot->isVoxelRangeDirty = false;
+
+		DebugAssertIndex(this->entityChunks, slot->chunkIndex);
+		const EntityChunk &entityChunk = this->entityChunks[slot->chunkIndex];
+		const std::vector<CachedVisibility> &visibilities = (slot->type == EntityType::Static) ?
+			entityChunk.staticVisibility : entityChunk.dynamicVisibility;
+		DebugAssertIndex(visibilities, slot->entityIndex);
+		const CachedVisibility &visibility = visibilities[slot->entityIndex];
+
+		// Normalize Y values.
+		const CoordDouble3 &minCoord = visibility.bboxMin;
+		const CoordDouble3 &maxCoord = visibility.bboxMax;
+		const VoxelDouble3 minPoint(minCoord.point.x, minCoord.point.y / ceilingScale, minCoord.point.z);
+		const VoxelDouble3 maxPoint(maxCoord.point.x, maxCoord.point.y / ceilingScale, maxCoord.point.z);
+		const CoordInt3 minVoxelCoord(minCoord.chunk, VoxelUtils::pointToVoxel(minPoint));
+		const CoordInt3 maxVoxelCoord(maxCoord.chunk, VoxelUtils::pointToVoxel(maxPoint));
+
+		// Most moves stay within the same voxels.
+		if (slot->hasVoxelRange && (slot->voxelRangeMin == minVoxelCoord) && (slot->voxelRangeMax == maxVoxelCoord))
+		{
+			continue;
+		}
+
+		this->removeVoxelEntityMappings(entityID, *slot);
+		this->addVoxelEntityMappings(entityID, *slot, minVoxelCoord, maxVoxelCoord);
+	}
+
+	this->voxelDirtyEntityIDs.clear();
+}
+
+void EntityManager::updateVisibilityStates(const CoordDouble2 &eye2D, double ceilingScale,
+	const ChunkManager &chunkManager, const EntityDefinitionLibrary &entityDefLibrary)
+{
+	if (ceilingScale != this->visibilityCeilingScale)
+	{
+		// Every entity's voxel range depends on the ceiling scale.
+		for (int i = 0; i < static_cast<int>(this->slots.size()); i++)
+		{
+			EntitySlot &slot = this->slots[i];
+			if (slot.chunkIndex >= 0)
+			{
+				this->markVoxelRangeDirty(MakeEntityID(i, slot.generation), slot);
+			}
+		}
+	}
+
+	for (EntityChunk &entityChunk : this->entityChunks)
+	{
+		this->updateGroupVisibility(entityChunk.staticGroup, eye2D, ceilingScale, chunkManager,
+			entityDefLibrary, entityChunk.staticVisibility);
+		this->updateGroupVisibility(entityChunk.dynamicGroup, eye2D, ceilingScale, chunkManager,
+			entityDefLibrary, entityChunk.dynamicVisibility);
+	}
+
+	this->visibilityEye = eye2D;
+	this->visibilityCeilingScale = ceilingScale;
+
+	// Only entities that were added or moved need their voxels looked at again.
+	this->updateVoxelEntityMappings(ceilingScale);
+}
+
+BufferView<const EntityID> EntityManager::getEntityIDsInVoxel(const CoordInt3 &coord) const
+{
+	const std::optional<int> chunkIndex = this->tryGetChunkIndex(coord.chunk);
+	if (!chunkIndex.has_value())
+	{
+		return BufferView<const EntityID>();
+	}
+
+	const EntityChunk &entityChunk = this->entityChunks[*chunkIndex];
+	const std::vector<VoxelInt3> &entityVoxels = entityChunk.entityVoxels;
+	const auto range = std::equal_range(entityVoxels.begin(), entityVoxels.end(), coord.voxel, VoxelLessThan);
+	const int offset = static_cast<int>(std::distance(entityVoxels.begin(), range.first));
+	const int count = static_cast<int>(std::distance(range.first, range.second));
+	if (count == 0)
+	{
+		return BufferView<const EntityID>();
+	}
+
+	return BufferView<const EntityID>(entityChunk.voxelEntityIDs.data() + offset, count);
+}
+
 void EntityManager::getEntityVisibilityState2D(const Entity &entity, const CoordDouble2 &eye2D,
 	const ChunkManager &chunkManager, const EntityDefinitionLibrary &entityDefLibrary,
 	EntityVisibilityState2D &outVisState) const
@@ -729,10 +1095,9 @@ void EntityManager::getEntityVisibilityState2D(const Entity &entity, const Coord
 	// Get active animation state.
 	const int stateIndex = animInst.getStateIndex();
 	const EntityAnimationDefinition::State &animDefState = animDef.getState(stateIndex);
-	const EntityAnimationInstance::State &animInstState = animInst.getState(stateIndex);
 
 	// Get animation angle based on entity direction relative to some camera/eye.
-	const int angleCount = animInstState.getKeyframeListCount();
+	const int angleCount = animDefState.getKeyframeListCount();
 	const Radians animAngle = [&entity, &eye2D, angleCount]()
 	{
 		if (entity.getEntityType() == EntityType::Static)
@@ -746,17 +1111,7 @@ void EntityManager::getEntityVisibilityState2D(const Entity &entity, const Coord
 			const DynamicEntity &dynamicEntity = static_cast<const DynamicEntity&>(entity);
 			const NewDouble2 &entityDir = dynamicEntity.getDirection();
 			const VoxelDouble2 diffDir = (eye2D - dynamicEntity.getPosition()).normalized();
-
-			const Radians entityAngle = MathUtils::fullAtan2(entityDir);
-			const Radians diffAngle = MathUtils::fullAtan2(diffDir);
-
-			// Use the difference of the two angles to get the relative angle.
-			const Radians resultAngle = Constants::TwoPi + (entityAngle - diffAngle);
-
-			// Angle bias so the final direction is centered within its angle range.
-			const Radians angleBias = (Constants::TwoPi / static_cast<double>(angleCount)) * 0.50;
-
-			return std::fmod(resultAngle + angleBias, Constants::TwoPi);
+			return GetDynamicAnimAngle(entityDir.x, entityDir.y, diffDir.x, diffDir.y, angleCount);
 		}
 		else
 		{
@@ -766,28 +1121,14 @@ void EntityManager::getEntityVisibilityState2D(const Entity &entity, const Coord
 	}();
 
 	// Index into animation keyframe lists for the state.
-	const int angleIndex = [angleCount, animAngle]()
-	{
-		const double angleCountReal = static_cast<double>(angleCount);
-		const double anglePercent = animAngle / Constants::TwoPi;
-		const int angleIndex = static_cast<int>(angleCountReal * anglePercent);
-		return std::clamp(angleIndex, 0, angleCount - 1);
-	}();
+	const int angleIndex = GetAnimAngleIndex(animAngle, angleCount);
 
 	// Keyframe list for the current state and angle.
 	const EntityAnimationDefinition::KeyframeList &animDefKeyframeList = animDefState.getKeyframeList(angleIndex);
 
 	// Progress through current animation.
-	const int keyframeIndex = [&animInst, &animDefState, &animDefKeyframeList]()
-	{
-		const int keyframeCount = animDefKeyframeList.getKeyframeCount();
-		const double keyframeCountReal = static_cast<double>(keyframeCount);
-		const double animCurSeconds = animInst.getCurrentSeconds();
-		const double animTotalSeconds = animDefState.getTotalSeconds();
-		const double animPercent = animCurSeconds / animTotalSeconds;
-		const int keyframeIndex = static_cast<int>(keyframeCountReal * animPercent);
-		return std::clamp(keyframeIndex, 0, keyframeCount - 1);
-	}();
+	const int keyframeIndex = GetAnimKeyframeIndex(animInst.getCurrentSeconds(),
+		animDefState.getTotalSeconds(), animDefKeyframeList.getKeyframeCount());
 
 	const CoordDouble2 &entityCoord = entity.getPosition();
 	const CoordDouble2 flatPosition(
@@ -801,50 +1142,38 @@ void EntityManager::getEntityVisibilityState3D(const Entity &entity, const Coord
 	double ceilingScale, const ChunkManager &chunkManager, const EntityDefinitionLibrary &entityDefLibrary,
 	EntityVisibilityState3D &outVisState) const
 {
+	// Use the last visibility update if it was for this eye.
+	const CachedVisibility *visibility = this->tryGetCachedVisibility(entity, ceilingScale);
+	if ((visibility != nullptr) && (this->visibilityEye->chunk == eye2D.chunk) &&
+		(this->visibilityEye->point == eye2D.point))
+	{
+		outVisState = visibility->visState;
+		return;
+	}
+
 	// Use the results from the 2D calculation.
 	EntityVisibilityState2D visState2D;
 	this->getEntityVisibilityState2D(entity, eye2D, chunkManager, entityDefLibrary, visState2D);
 
 	const EntityDefinition &entityDef = this->getEntityDef(entity.getDefinitionID(), entityDefLibrary);
-	const int baseYOffset = EntityUtils::getYOffset(entityDef);
-	const double flatYOffset = static_cast<double>(-baseYOffset) / MIFUtils::ARENA_UNITS;
+	const CoordDouble3 flatPosition = GetFlatPosition3D(visState2D.flatPosition, entityDef, ceilingScale, chunkManager);
+	outVisState.init(&entity, flatPosition, visState2D.stateIndex, visState2D.angleIndex, visState2D.keyframeIndex);
+}
 
-	// If the entity is in a raised platform voxel, they are set on top of it.
-	const double raisedPlatformYOffset = [ceilingScale, &chunkManager, &visState2D]()
+void EntityManager::getEntityBBox3D(const Entity &entity, const EntityVisibilityState3D &visState,
+	double ceilingScale, const EntityDefinitionLibrary &entityDefLibrary, CoordDouble3 *outMin,
+	CoordDouble3 *outMax) const
+{
+	// The bounding box doesn't depend on the eye, only the flat's height.
+	const CachedVisibility *visibility = this->tryGetCachedVisibility(entity, ceilingScale);
+	if ((visibility != nullptr) && (visibility->visState.flatPosition.point.y == visState.flatPosition.point.y))
 	{
-		const CoordInt2 entityVoxelCoord(
-			visState2D.flatPosition.chunk,
-			VoxelUtils::pointToVoxel(visState2D.flatPosition.point));
-		const Chunk *chunk = chunkManager.tryGetChunk(entityVoxelCoord.chunk);
-		if (chunk == nullptr)
-		{
-			// Not sure this is ever reachable, but handle just in case.
-			return 0.0;
-		}
-
-		const Chunk::VoxelID voxelID = chunk->getVoxel(entityVoxelCoord.voxel.x, 1, entityVoxelCoord.voxel.y);
-		const VoxelDefinition &voxelDef = chunk->getVoxelDef(voxelID);
-
-		if (voxelDef.type == ArenaTypes::VoxelType::Raised)
-		{
-			const VoxelDefinition::RaisedData &raised = voxelDef.raised;
-			return (raised.yOffset + raised.ySize) * ceilingScale;
-		}
-		else
-		{
-			// No raised platform offset.
-			return 0.0;
-		}
-	}();
-
-	// Bottom center of flat.
-	const VoxelDouble3 flatPoint(
-		visState2D.flatPosition.point.x,
-		ceilingScale + flatYOffset + raisedPlatformYOffset,
-		visState2D.flatPosition.point.y);
-	const CoordDouble3 flatPosition(visState2D.flatPosition.chunk, flatPoint);
+		*outMin = visibility->bboxMin;
+		*outMax = visibility->bboxMax;
+		return;
+	}
 
-	outVisState.init(&entity, flatPosition, visState2D.stateIndex, visState2D.angleIndex, visState2D.keyframeIndex);
+	entity.getViewIndependentBBox3D(visState.flatPosition.point.y, *this, entityDefLibrary, outMin, outMax);
 }
 
 const EntityAnimationDefinition::Keyframe &EntityManager::getEntityAnimKeyframe(const Entity &entity,
@@ -870,45 +1199,19 @@ void EntityManager::updateEntityChunk(Entity *entity)
 	const EntityType entityType = entity->getEntityType();
 
 	// Find which chunk they were in before.
-	// @todo: if this is slow, we could use the entity's current chunk as a hint.
-	std::optional<int> oldChunkIndex;
-	for (int i = 0; i < static_cast<int>(this->entityChunks.size()); i++)
-	{
-		const EntityChunk &entityChunk = this->entityChunks[i];
-		if (entityType == EntityType::Static)
-		{
-			const EntityGroup<StaticEntity> &group = entityChunk.staticGroup;
-			const std::optional<int> entityIndex = group.getEntityIndex(entityID);
-			if (entityIndex.has_value())
-			{
-				oldChunkIndex = i;
-				break;
-			}
-		}
-		else if (entityType == EntityType::Dynamic)
-		{
-			const EntityGroup<DynamicEntity> &group = entityChunk.dynamicGroup;
-			const std::optional<int> entityIndex = group.getEntityIndex(entityID);
-			if (entityIndex.has_value())
-			{
-				oldChunkIndex = i;
-				break;
-			}
-		}
-		else
-		{
-			DebugNotImplementedMsg(std::to_string(static_cast<int>(entityType)));
-		}
-	}
-
-	if (!oldChunkIndex.has_value())
+	EntitySlot *slot = this->tryGetSlot(entityID);
+	if (slot == nullptr)
 	{
 		DebugLogError("Couldn't find old chunk that entity \"" + std::to_string(entityID) + "\" was in before.");
 		return;
 	}
 
+	this->markVoxelRangeDirty(entityID, *slot);
+
 	// See if the entity changed chunks.
-	EntityChunk &oldEntityChunk = this->entityChunks[*oldChunkIndex];
+	const int oldChunkIndex = slot->chunkIndex;
+	DebugAssertIndex(this->entityChunks, oldChunkIndex);
+	EntityChunk &oldEntityChunk = this->entityChunks[oldChunkIndex];
 	const ChunkInt2 &oldChunk = oldEntityChunk.chunk;
 
 	const CoordDouble2 &entityPosition = entity->getPosition();
@@ -926,69 +1229,84 @@ void EntityManager::updateEntityChunk(Entity *entity)
 			return;
 		}
 
+		// The entity pointer is invalid after moving.
+		const int oldEntityIndex = slot->entityIndex;
 		EntityChunk &newEntityChunk = this->entityChunks[*newChunkIndex];
+		int newEntityIndex;
+		EntityID movedEntityID;
 		if (entityType == EntityType::Static)
 		{
 			EntityGroup<StaticEntity> &oldGroup = oldEntityChunk.staticGroup;
 			EntityGroup<StaticEntity> &newGroup = newEntityChunk.staticGroup;
-			if (!newGroup.tryAcquireEntity(entityID, oldGroup))
-			{
-				DebugLogError("Couldn't move static entity \"" + std::to_string(entityID) + "\" from old to new group.");
-			}
+			movedEntityID = newGroup.acquireEntity(oldEntityIndex, oldGroup);
+			newEntityIndex = newGroup.getCount() - 1;
 		}
 		else if (entityType == EntityType::Dynamic)
 		{
 			EntityGroup<DynamicEntity> &oldGroup = oldEntityChunk.dynamicGroup;
 			EntityGroup<DynamicEntity> &newGroup = newEntityChunk.dynamicGroup;
-			if (!newGroup.tryAcquireEntity(entityID, oldGroup))
-			{
-				DebugLogError("Couldn't move dynamic entity \"" + std::to_string(entityID) + "\" from old to new group.");
-			}
+			movedEntityID = newGroup.acquireEntity(oldEntityIndex, oldGroup);
+			newEntityIndex = newGroup.getCount() - 1;
 		}
 		else
 		{
 			DebugNotImplementedMsg(std::to_string(static_cast<int>(entityType)));
+			return;
 		}
+
+		slot->chunkIndex = *newChunkIndex;
+		slot->entityIndex = newEntityIndex;
+		this->updateSlotEntityIndex(movedEntityID, oldEntityIndex);
 	}
 }
 
 void EntityManager::remove(EntityID id)
 {
-	// Find which entity group the given entity ID is in. This is a slow look-up because there is
-	// no hint where the entity is at.
-	for (EntityChunk &entityChunk : this->entityChunks)
+	const EntitySlot *slot = this->tryGetSlot(id);
+	if (slot == nullptr)
 	{
-		// If the entity is in either the static or dynamic entity group, delete it and return its ID
-		// to the free IDs.
-		EntityGroup<StaticEntity> &staticGroup = entityChunk.staticGroup;
-		std::optional<int> entityIndex = staticGroup.getEntityIndex(id);
-		if (entityIndex.has_value())
-		{
-			staticGroup.remove(id);
-			this->freeIDs.push_back(id);
-			return;
-		}
+		// Not in any entity group.
+		DebugLogWarning("Tried to remove missing entity \"" + std::to_string(id) + "\".");
+		return;
+	}
 
-		EntityGroup<DynamicEntity> &dynamicGroup = entityChunk.dynamicGroup;
-		entityIndex = dynamicGroup.getEntityIndex(id);
-		if (entityIndex.has_value())
-		{
-			dynamicGroup.remove(id);
-			this->freeIDs.push_back(id);
-			return;
-		}
+	// Delete the entity and return its ID to the free IDs.
+	const int entityIndex = slot->entityIndex;
+	DebugAssertIndex(this->entityChunks, slot->chunkIndex);
+	EntityChunk &entityChunk = this->entityChunks[slot->chunkIndex];
+	EntityID movedEntityID;
+	if (slot->type == EntityType::Static)
+	{
+		EntityGroup<StaticEntity> &group = entityChunk.staticGroup;
+		this->freeEntityPalette(*group.getEntityAtIndex(entityIndex));
+		movedEntityID = group.remove(entityIndex);
+	}
+	else if (slot->type == EntityType::Dynamic)
+	{
+		EntityGroup<DynamicEntity> &group = entityChunk.dynamicGroup;
+		this->freeEntityPalette(*group.getEntityAtIndex(entityIndex));
+		movedEntityID = group.remove(entityIndex);
+	}
+	else
+	{
+		DebugNotImplementedMsg(std::to_string(static_cast<int>(slot->type)));
+		return;
 	}
 
-	// Not in any entity group.
-	DebugLogWarning("Tried to remove missing entity \"" + std::to_string(id) + "\".");
+	this->freeSlot(id);
+	this->updateSlotEntityIndex(movedEntityID, entityIndex);
 }
 
 void EntityManager::clear()
 {
 	this->entityChunks.clear();
 	this->entityDefs.clear();
-	this->freeIDs.clear();
-	this->nextID = 0;
+	this->slots.clear();
+	this->freeSlotIndices.clear();
+	this->palettes.clear();
+	this->freePaletteIDs.clear();
+	this->voxelDirtyEntityIDs.clear();
+	this->visibilityEye = std::nullopt;
 }
 
 void EntityManager::addChunk(const ChunkInt2 &chunk)
@@ -999,6 +1317,20 @@ void EntityManager::addChunk(const ChunkInt2 &chunk)
 		return;
 	}
 
+	// Entities whose bounding boxes reach into this chunk need mapping into its voxel look-up.
+	for (int i = 0; i < static_cast<int>(this->slots.size()); i++)
+	{
+		EntitySlot &slot = this->slots[i];
+		if (slot.hasVoxelRange &&
+			(chunk.x >= slot.voxelRangeMin.chunk.x) && (chunk.x <= slot.voxelRangeMax.chunk.x) &&
+			(chunk.y >= slot.voxelRangeMin.chunk.y) && (chunk.y <= slot.voxelRangeMax.chunk.y))
+		{
+			const EntityID id = MakeEntityID(i, slot.generation);
+			this->removeVoxelEntityMappings(id, slot);
+			this->markVoxelRangeDirty(id, slot);
+		}
+	}
+
 	// Add a new empty entity chunk.
 	EntityChunk entityChunk;
 	entityChunk.init(chunk);
@@ -1014,58 +1346,116 @@ void EntityManager::removeChunk(const ChunkInt2 &chunk)
 		return;
 	}
 
-	// Reclaim all of the entity IDs owned by the chunk.
+	// Reclaim all of the entity IDs and palettes owned by the chunk.
 	const EntityChunk &entityChunk = this->entityChunks[*chunkIndex];
 	const EntityGroup<StaticEntity> &staticEntities = entityChunk.staticGroup;
 	for (int i = 0; i < staticEntities.getCount(); i++)
 	{
-		const Entity *entity = staticEntities.getEntityAtIndex(i);
-		if (entity != nullptr)
-		{
-			this->freeIDs.push_back(entity->getID());
-		}
+		const StaticEntity &entity = *staticEntities.getEntityAtIndex(i);
+		this->freeSlot(entity.getID());
+		this->freeEntityPalette(entity);
 	}
 
 	const EntityGroup<DynamicEntity> &dynamicEntities = entityChunk.dynamicGroup;
 	for (int i = 0; i < dynamicEntities.getCount(); i++)
 	{
-		const Entity *entity = dynamicEntities.getEntityAtIndex(i);
-		if (entity != nullptr)
+		const DynamicEntity &entity = *dynamicEntities.getEntityAtIndex(i);
+		this->freeSlot(entity.getID());
+		this->freeEntityPalette(entity);
+	}
+
+	// Remove the chunk from the entity manager, then point entities in later chunks at their new
+	// chunk index.
+	this->entityChunks.erase(this->entityChunks.begin() + *chunkIndex);
+
+	for (int i = *chunkIndex; i < static_cast<int>(this->entityChunks.size()); i++)
+	{
+		const EntityChunk &movedEntityChunk = this->entityChunks[i];
+		const EntityGroup<StaticEntity> &movedStaticEntities = movedEntityChunk.staticGroup;
+		for (int j = 0; j < movedStaticEntities.getCount(); j++)
 		{
-			this->freeIDs.push_back(entity->getID());
+			this->tryGetSlot(movedStaticEntities.getEntityAtIndex(j)->getID())->chunkIndex = i;
+		}
+
+		const EntityGroup<DynamicEntity> &movedDynamicEntities = movedEntityChunk.dynamicGroup;
+		for (int j = 0; j < movedDynamicEntities.getCount(); j++)
+		{
+			this->tryGetSlot(movedDynamicEntities.getEntityAtIndex(j)->getID())->chunkIndex = i;
 		}
 	}
+}
 
-	// Remove the chunk from the entity manager.
-	this->entityChunks.erase(this->entityChunks.begin() + *chunkIndex);
+void EntityManager::tickChunk(Game &game, double dt, EntityChunk &entityChunk, EntityTickBuffer &tickBuffer)
+{
+	EntityGroup<StaticEntity> &staticGroup = entityChunk.staticGroup;
+	const int staticEntityCount = staticGroup.getCount();
+	for (int i = 0; i < staticEntityCount; i++)
+	{
+		StaticEntity *entity = staticGroup.getEntityAtIndex(i);
+		entity->tick(game, dt, tickBuffer);
+	}
+
+	EntityGroup<DynamicEntity> &dynamicGroup = entityChunk.dynamicGroup;
+	const int dynamicEntityCount = dynamicGroup.getCount();
+	for (int i = 0; i < dynamicEntityCount; i++)
+	{
+		DynamicEntity *entity = dynamicGroup.getEntityAtIndex(i);
+		const CoordDouble2 oldPosition = entity->getPosition();
+		entity->tick(game, dt, tickBuffer);
+
+		// Moving the entity to another chunk would change the groups being iterated, so it's deferred along
+		// with updating the voxel look-ups.
+		const CoordDouble2 &newPosition = entity->getPosition();
+		if ((newPosition.chunk != oldPosition.chunk) || (newPosition.point != oldPosition.point))
+		{
+			tickBuffer.movedEntityIDs.emplace_back(entity->getID());
+		}
+	}
 }
 
 void EntityManager::tick(Game &game, double dt)
 {
-	// Update all entities in each chunk.
-	for (EntityChunk &entityChunk : this->entityChunks)
+	// Each chunk's tick buffer is seeded from one draw of the game's RNG and the chunk's coordinate, so the
+	// results don't depend on chunk order or how chunks are split between threads.
+	const int chunkCount = static_cast<int>(this->entityChunks.size());
+	this->tickBuffers.resize(chunkCount);
+
+	const uint32_t frameSeed = static_cast<uint32_t>(game.getRandom().next());
+	for (int i = 0; i < chunkCount; i++)
+	{
+		this->tickBuffers[i].init(MakeChunkTickSeed(frameSeed, this->entityChunks[i].chunk));
+	}
+
+	auto tickChunkRange = [this, &game, dt, chunkCount](int startIndex, int stride)
 	{
-		EntityGroup<StaticEntity> &staticGroup = entityChunk.staticGroup;
-		const int staticEntityCount = staticGroup.getCount();
-		for (int i = 0; i < staticEntityCount; i++)
+		for (int i = startIndex; i < chunkCount; i += stride)
 		{
-			StaticEntity *entity = staticGroup.getEntityAtIndex(i);
-			if (entity != nullptr)
-			{
-				entity->tick(game, dt);
-			}
+			this->tickChunk(game, dt, this->entityChunks[i], this->tickBuffers[i]);
 		}
+	};
 
-		EntityGroup<DynamicEntity> &dynamicGroup = entityChunk.dynamicGroup;
-		const int dynamicEntityCount = dynamicGroup.getCount();
-		for (int i = 0; i < dynamicEntityCount; i++)
+	// Only use worker threads when there are enough entities to be worth waking them.
+	ThreadPool &threadPool = game.getThreadPool();
+	const int entityThreadCount = std::max(this->getCount() / MIN_ENTITIES_PER_TICK_THREAD, 1);
+	const int threadCount = std::min({ threadPool.getThreadCount(), chunkCount, entityThreadCount });
+	threadPool.run(threadCount, tickChunkRange);
+
+	// Apply shared side effects serially.
+	AudioManager &audioManager = game.getAudioManager();
+	for (const EntityTickBuffer &tickBuffer : this->tickBuffers)
+	{
+		for (const EntityTickBuffer::SoundRequest &soundRequest : tickBuffer.sounds)
 		{
-			DynamicEntity *entity = dynamicGroup.getEntityAtIndex(i);
-			if (entity != nullptr)
-			{
-				entity->tick(game, dt);
-				this->updateEntityChunk(entity);
-			}
+			audioManager.playSound(soundRequest.filename, soundRequest.position);
+		}
+	}
+
+	for (const EntityTickBuffer &tickBuffer : this->tickBuffers)
+	{
+		for (const EntityID entityID : tickBuffer.movedEntityIDs)
+		{
+			Entity *entity = this->getEntityHandle(entityID, EntityType::Dynamic);
+			this->updateEntityChunk(entity);
 		}
 	}
 }
@@ -10,20 +10,21 @@
 #include "Entity.h"
 #include "EntityDefinition.h"
 #include "EntityRef.h"
+#include "EntityTickBuffer.h"
 #include "EntityUtils.h"
+#include "EntityVisibilityState.h"
 #include "StaticEntity.h"
 #include "../Math/Vector3.h"
+#include "../Media/Palette.h"
 #include "../World/VoxelUtils.h"
 
 #include "components/utilities/Buffer2D.h"
+#include "components/utilities/BufferView.h"
 
 class ChunkManager;
 class EntityDefinitionLibrary;
 class Game;
 
-struct EntityVisibilityState2D;
-struct EntityVisibilityState3D;
-
 enum class EntityType;
 
 class EntityManager
@@ -35,24 +36,11 @@ private:
 	private:
 		static_assert(std::is_base_of_v<Entity, T>);
 
-		// Contiguous array for fast iteration. Entries can be empty to avoid moving other
-		// entries around.
+		// Densely-packed entities for fast iteration. Removing an entity moves the last one into
+		// its place, so indices are only stable until the next removal.
 		std::vector<T> entities;
-
-		// Parallel array for whether the equivalent entities index is valid.
-		std::vector<bool> validEntities;
-
-		// Entity ID -> entity index mappings for fast insertion/deletion/look-up.
-		std::unordered_map<EntityID, int> indices;
-
-		// List of previously-owned entity indices that can be replaced with new entities.
-		std::vector<int> freeIndices;
-
-		// Finds the next free entity index to add to, allocating if necessary.
-		int nextFreeIndex();
 	public:
-		// Gets number of entities in the group. Intended for iterating over the entire group,
-		// so it also includes any empty entries.
+		// Gets number of entities in the group.
 		int getCount() const;
 
 		// Gets an entity by index.
@@ -63,22 +51,48 @@ private:
 		int getEntities(Entity **outEntities, int outSize);
 		int getEntities(const Entity **outEntities, int outSize) const;
 
-		// Gets the index of an entity if the given ID has an associated mapping.
-		std::optional<int> getEntityIndex(EntityID id) const;
-
-		// Inserts a new entity and assigns it the given ID.
+		// Inserts a new entity at the end of the group and assigns it the given ID.
 		T *addEntity(EntityID id);
 
-		// Moves an entity from the old group to this group if able.
-		bool tryAcquireEntity(EntityID id, EntityGroup<T> &oldGroup);
+		// Moves an entity from the old group to the end of this group. Returns the ID of the entity
+		// that took its place in the old group, or NO_ID if there was none.
+		EntityID acquireEntity(int oldIndex, EntityGroup<T> &oldGroup);
 
-		// Removes an entity from the group.
-		void remove(EntityID id);
+		// Removes an entity from the group. Returns the ID of the entity that took its place, or
+		// NO_ID if there was none.
+		EntityID remove(int index);
 
 		// Removes all entities.
 		void clear();
 	};
 
+	// Where an entity is currently stored. Entity IDs are a slot index in the low bits and the slot's
+	// generation in the high bits, so IDs of removed entities can be rejected without any hashing.
+	struct EntitySlot
+	{
+		int chunkIndex; // Index into entity chunks, or -1 if the slot is free.
+		int entityIndex; // Index into the chunk's group for the entity type.
+		EntityType type;
+		int generation; // Incremented each time the slot is freed.
+
+		// Voxels the entity is listed under in the voxel look-ups, and whether it has been added or moved
+		// since they were last updated.
+		bool hasVoxelRange;
+		bool isVoxelRangeDirty;
+		CoordInt3 voxelRangeMin, voxelRangeMax;
+
+		void init();
+	};
+
+	// An entity's visibility state and view-independent bounding box from the last visibility update.
+	struct CachedVisibility
+	{
+		EntityVisibilityState3D visState;
+		EntityID id; // Entity ID and position when cached, for detecting stale entries.
+		CoordDouble2 position;
+		CoordDouble3 bboxMin, bboxMax;
+	};
+
 	// All entities for a particular chunk.
 	struct EntityChunk
 	{
@@ -86,8 +100,21 @@ private:
 		EntityGroup<StaticEntity> staticGroup;
 		EntityGroup<DynamicEntity> dynamicGroup;
 
+		// Parallel to the entity groups, filled by the last visibility update.
+		std::vector<CachedVisibility> staticVisibility;
+		std::vector<CachedVisibility> dynamicVisibility;
+
+		// Voxels in this chunk touched by entity bounding boxes, sorted for look-up, and the parallel IDs of
+		// those entities. Includes entities in adjacent chunks that overlap this chunk's edge.
+		std::vector<VoxelInt3> entityVoxels;
+		std::vector<EntityID> voxelEntityIDs;
+
 		void init(const ChunkInt2 &chunk);
 
+		// Inserts or erases one voxel's entry in the sorted voxel look-up.
+		void addVoxelEntity(const VoxelInt3 &voxel, EntityID id);
+		void removeVoxelEntity(const VoxelInt3 &voxel, EntityID id);
+
 		void clear();
 	};
 
@@ -99,26 +126,85 @@ private:
 	// to be zero-based because these are in addition to ones in the entity definition library.
 	std::unordered_map<EntityDefID, EntityDefinition> entityDefs;
 
-	// Free IDs (previously owned) and the next available ID (never owned).
-	std::vector<EntityID> freeIDs;
-	EntityID nextID;
+	// Instance-specific palettes owned by entities, plus previously-owned ones that can be reused.
+	std::vector<Palette> palettes;
+	std::vector<EntityPaletteID> freePaletteIDs;
+
+	// Returns an entity's palette (if any) to the free palettes.
+	void freeEntityPalette(const Entity &entity);
+
+	// Structure-of-arrays scratch space for calculating dynamic entity animation angles in one pass.
+	struct VisibilityScratch
+	{
+		std::vector<double> dirXs, dirYs; // Entity facing.
+		std::vector<double> eyeDirXs, eyeDirYs; // Entity to eye.
+		std::vector<int> angleCounts;
+		std::vector<double> animAngles; // Radians.
+
+		void resize(int count);
+	};
+
+	// Entities added or moved since the voxel look-ups were last updated. Removed entities are taken out
+	// of the look-ups immediately.
+	std::vector<EntityID> voxelDirtyEntityIDs;
 
-	// Obtains an available ID to be assigned to a new entity, incrementing the current max
-	// if no previously owned IDs are available to reuse.
+	// Eye and ceiling scale of the last visibility update. Cached visibility states are only used by
+	// queries that match them.
+	std::optional<CoordDouble2> visibilityEye;
+	double visibilityCeilingScale;
+	VisibilityScratch visibilityScratch;
+
+	// One per entity chunk, reused every tick.
+	std::vector<EntityTickBuffer> tickBuffers;
+
+	// Entity ID -> storage location look-up, plus previously-owned slots that can be reused.
+	std::vector<EntitySlot> slots;
+	std::vector<int> freeSlotIndices;
+
+	// Obtains an available ID to be assigned to a new entity, reusing a previously-owned slot if
+	// possible. The caller must set the slot's location.
 	EntityID nextFreeID();
 
-	// Helper functions for looking up an entity in the given group by ID.
-	template <typename T>
-	T *getInternal(EntityID id, EntityGroup<T> &group);
-	template <typename T>
-	const T *getInternal(EntityID id, const EntityGroup<T> &group) const;
+	// Gets the slot for an entity ID if the ID refers to a live entity.
+	EntitySlot *tryGetSlot(EntityID id);
+	const EntitySlot *tryGetSlot(EntityID id) const;
+
+	// Frees the slot for a live entity ID so its ID is no longer valid.
+	void freeSlot(EntityID id);
+
+	// Updates the dense index of an entity that was moved by a removal within its group.
+	void updateSlotEntityIndex(EntityID id, int entityIndex);
 
 	// Gets the entity chunk index if it exists.
 	std::optional<int> tryGetChunkIndex(const ChunkInt2 &chunk) const;
+
+	// Calculates visibility for every entity in a group relative to the eye.
+	template <typename T>
+	void updateGroupVisibility(const EntityGroup<T> &group, const CoordDouble2 &eye2D, double ceilingScale,
+		const ChunkManager &chunkManager, const EntityDefinitionLibrary &entityDefLibrary,
+		std::vector<CachedVisibility> &outVisibility);
+
+	// Queues an entity to be re-added to the voxel look-ups at the next visibility update.
+	void markVoxelRangeDirty(EntityID id, EntitySlot &slot);
+
+	// Adds or removes an entity in the voxel look-up of every chunk its voxel range touches.
+	void addVoxelEntityMappings(EntityID id, EntitySlot &slot, const CoordInt3 &minVoxelCoord,
+		const CoordInt3 &maxVoxelCoord);
+	void removeVoxelEntityMappings(EntityID id, EntitySlot &slot);
+
+	// Moves queued entities to the voxels their freshly cached bounding boxes touch.
+	void updateVoxelEntityMappings(double ceilingScale);
+
+	// Gets an entity's entry from the last visibility update if it is still current for the entity.
+	const CachedVisibility *tryGetCachedVisibility(const Entity &entity, double ceilingScale) const;
+
+	// Ticks all entities in one chunk. Safe to call for different chunks at the same time.
+	void tickChunk(Game &game, double dt, EntityChunk &entityChunk, EntityTickBuffer &tickBuffer);
 public:
 	// The default ID for entities with no ID.
 	static constexpr EntityID NO_ID = -1;
 	static constexpr EntityDefID NO_DEF_ID = -1;
+	static constexpr EntityPaletteID NO_PALETTE_ID = -1;
 
 	EntityManager();
 
@@ -126,8 +212,8 @@ public:
 	// there must be at least one active chunk, and this entity is default-assigned to that chunk.
 	EntityRef makeEntity(EntityType type);
 
-	// Gets a raw entity handle, given their ID and an optional entity type for faster look-up.
-	// Returns null if no ID matches. Does not protect against dangling pointers.
+	// Gets a raw entity handle, given their ID and an optional entity type. Returns null if no ID
+	// matches or the type is wrong. Does not protect against dangling pointers.
 	Entity *getEntityHandle(EntityID id, EntityType type);
 	const Entity *getEntityHandle(EntityID id, EntityType type) const;
 	Entity *getEntityHandle(EntityID id);
@@ -173,7 +259,19 @@ public:
 	// Adds an entity definition and returns its ID.
 	EntityDefID addEntityDef(EntityDefinition &&def, const EntityDefinitionLibrary &entityDefLibrary);
 
-	// Gets the entity visibility data necessary for rendering and ray cast selection.
+	// Adds a palette for an entity's animation instance to reference. It is freed when the entity is.
+	EntityPaletteID addEntityPalette(const Palette &palette);
+
+	// Gets the palette an animation instance references.
+	const Palette &getEntityPalette(EntityPaletteID id) const;
+
+	// Calculates visibility states and bounding boxes of all entities relative to the eye in one pass. Called
+	// once per frame after entities are ticked so the renderer and ray casts can share the results.
+	void updateVisibilityStates(const CoordDouble2 &eye2D, double ceilingScale, const ChunkManager &chunkManager,
+		const EntityDefinitionLibrary &entityDefLibrary);
+
+	// Gets the entity visibility data necessary for rendering and ray cast selection. The 3D state comes
+	// from the last visibility update when it used the same eye.
 	void getEntityVisibilityState2D(const Entity &entity, const CoordDouble2 &eye2D,
 		const ChunkManager &chunkManager, const EntityDefinitionLibrary &entityDefLibrary,
 		EntityVisibilityState2D &outVisState) const;
@@ -181,6 +279,15 @@ public:
 		double ceilingScale, const ChunkManager &chunkManager, const EntityDefinitionLibrary &entityDefLibrary,
 		EntityVisibilityState3D &outVisState) const;
 
+	// Gets the IDs of entities whose bounding boxes touch the voxel. Removed entities are dropped right away,
+	// but added or moved ones are only picked up by the next visibility update.
+	BufferView<const EntityID> getEntityIDsInVoxel(const CoordInt3 &coord) const;
+
+	// Gets an entity's view-independent bounding box for the given visibility state, from the last
+	// visibility update if possible.
+	void getEntityBBox3D(const Entity &entity, const EntityVisibilityState3D &visState, double ceilingScale,
+		const EntityDefinitionLibrary &entityDefLibrary, CoordDouble3 *outMin, CoordDouble3 *outMax) const;
+
 	// Convenience function for getting the active keyframe from an entity, given some
 	// visibility data.
 	const EntityAnimationDefinition::Keyframe &getEntityAnimKeyframe(const Entity &entity,
@@ -201,7 +308,8 @@ public:
 	// Deletes all entities in the given chunk and removes it from the manager.
 	void removeChunk(const ChunkInt2 &chunk);
 
-	// Ticks the entity manager by delta time.
+	// Ticks the entity manager by delta time. Chunks are ticked in parallel, then queued sounds are
+	// played and entities that crossed a chunk border are moved, both in chunk order.
 	void tick(Game &game, double dt);
 };
 
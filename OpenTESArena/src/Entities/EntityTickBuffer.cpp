@@ -0,0 +1,14 @@
+#include "EntityTickBuffer.h"
+
+void EntityTickBuffer::SoundRequest::init(const std::string &filename, const NewDouble3 &position)
+{
+	this->filename = filename;
+	this->position = position;
+}
+
+void EntityTickBuffer::init(int seed)
+{
+	this->random.init(seed);
+	this->sounds.clear();
+	this->movedEntityIDs.clear();
+}
@@ -0,0 +1,32 @@
+#ifndef ENTITY_TICK_BUFFER_H
+#define ENTITY_TICK_BUFFER_H
+
+#include <string>
+#include <vector>
+
+#include "EntityUtils.h"
+#include "../Math/Random.h"
+#include "../World/Coord.h"
+
+// Side effects of ticking one entity chunk. Entities can be ticked on worker threads, so anything they'd
+// normally do to shared state (random numbers, sounds, moving between chunks) goes through here and is applied
+// by the entity manager afterwards in chunk order.
+
+struct EntityTickBuffer
+{
+	struct SoundRequest
+	{
+		std::string filename;
+		NewDouble3 position;
+
+		void init(const std::string &filename, const NewDouble3 &position);
+	};
+
+	Random random; // Re-seeded every tick from the game's RNG and the chunk coordinate.
+	std::vector<SoundRequest> sounds;
+	std::vector<EntityID> movedEntityIDs; // Entities whose position changed.
+
+	void init(int seed);
+};
+
+#endif
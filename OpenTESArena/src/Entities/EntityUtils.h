@@ -12,6 +12,9 @@ using EntityID = int;
 // Entity definition handle.
 using EntityDefID = int;
 
+// Entity palette handle, for instance-specific palettes like citizen clothing colors.
+using EntityPaletteID = int;
+
 class CharacterClassLibrary;
 class EntityDefinitionLibrary;
 
@@ -195,20 +195,16 @@ void Player::handleCollision(const LevelInstance &activeLevel, double dt)
 {
 	const ChunkManager &chunkManager = activeLevel.getChunkManager();
 
-	auto tryGetVoxelDef = [&activeLevel, &chunkManager](const CoordInt3 &coord) -> const VoxelDefinition*
+	// Regular old Euler integration in XZ plane.
+	const CoordDouble3 curPlayerCoord = this->getPosition();
+	const VoxelDouble3 deltaPosition(this->velocity.x * dt, 0.0, this->velocity.z * dt);
+
+	// The voxels checked are almost always in the player's chunk, so only search the chunk manager
+	// for the ones that aren't.
+	const Chunk *playerChunk = chunkManager.tryGetChunk(curPlayerCoord.chunk);
+	auto tryGetChunk = [&chunkManager, &curPlayerCoord, playerChunk](const ChunkInt2 &chunkCoord) -> const Chunk*
 	{
-		const Chunk *chunk = chunkManager.tryGetChunk(coord.chunk);
-		if (chunk != nullptr)
-		{
-			const Chunk::VoxelID voxelID = chunk->getVoxel(coord.voxel.x, coord.voxel.y, coord.voxel.z);
-			const VoxelDefinition &voxelDef = chunk->getVoxelDef(voxelID);
-			return &voxelDef;
-		}
-		else
-		{
-			// Chunks not in the chunk manager are air.
-			return nullptr;
-		}
+		return (chunkCoord == curPlayerCoord.chunk) ? playerChunk : chunkManager.tryGetChunk(chunkCoord);
 	};
 
 	// Coordinates of the base of the voxel the feet are in.
@@ -216,10 +212,6 @@ void Player::handleCollision(const LevelInstance &activeLevel, double dt)
 	const int feetVoxelY = static_cast<int>(std::floor(
 		this->getFeetY() / activeLevel.getCeilingScale()));
 
-	// Regular old Euler integration in XZ plane.
-	const CoordDouble3 curPlayerCoord = this->getPosition();
-	const VoxelDouble3 deltaPosition(this->velocity.x * dt, 0.0, this->velocity.z * dt);
-
 	// The next voxels in X/Y/Z directions based on player movement.
 	const VoxelInt3 nextXVoxel(
 		static_cast<SNInt>(std::floor(curPlayerCoord.point.x + deltaPosition.x)),
@@ -235,79 +227,46 @@ void Player::handleCollision(const LevelInstance &activeLevel, double dt)
 		static_cast<WEInt>(std::floor(curPlayerCoord.point.z + deltaPosition.z)));
 
 	const CoordInt3 nextXCoord = ChunkUtils::recalculateCoord(curPlayerCoord.chunk, nextXVoxel);
-	const CoordInt3 nextYCoord = ChunkUtils::recalculateCoord(curPlayerCoord.chunk, nextYVoxel);
 	const CoordInt3 nextZCoord = ChunkUtils::recalculateCoord(curPlayerCoord.chunk, nextZVoxel);
-	const VoxelDefinition *xVoxelDef = tryGetVoxelDef(nextXCoord);
-	const VoxelDefinition *yVoxelDef = tryGetVoxelDef(nextYCoord);
-	const VoxelDefinition *zVoxelDef = tryGetVoxelDef(nextZCoord);
 
 	// Check horizontal collisions.
 
 	// -- Temp hack until Y collision detection is implemented --
 	// - @todo: formalize the collision calculation and get rid of this hack.
 	//   We should be able to cover all collision cases in Arena now.
-	auto wouldCollideWithVoxel = [&chunkManager](const CoordInt3 &coord, const VoxelDefinition &voxelDef)
+	auto wouldCollideWithVoxel = [&tryGetChunk](const CoordInt3 &coord)
 	{
-		if (voxelDef.type == ArenaTypes::VoxelType::TransparentWall)
+		const Chunk *chunk = tryGetChunk(coord.chunk);
+		const VoxelInt3 &voxel = coord.voxel;
+		if ((chunk == nullptr) || !chunk->isValidVoxel(voxel.x, voxel.y, voxel.z))
 		{
-			// Transparent wall collision.
-			const VoxelDefinition::TransparentWallData &transparent = voxelDef.transparentWall;
-			return transparent.collider;
+			// Chunks not in the chunk manager are air.
+			return false;
 		}
-		else if (voxelDef.type == ArenaTypes::VoxelType::Edge)
+
+		// Solid voxels already account for colliders and level transitions (which are entered by the
+		// "on voxel enter" hack).
+		if (!chunk->hasVoxelTrait(voxel.x, voxel.y, voxel.z, VoxelTraitType::Solid))
 		{
-			// Edge collision.
-			// - @todo: treat as edge, not solid voxel.
-			const VoxelDefinition::EdgeData &edge = voxelDef.edge;
-			return edge.collider;
+			return false;
 		}
-		else
+
+		if (chunk->hasVoxelTrait(voxel.x, voxel.y, voxel.z, VoxelTraitType::Door))
 		{
-			const Chunk *chunk = chunkManager.tryGetChunk(coord.chunk);
-			DebugAssert(chunk != nullptr);
-
-			// General voxel collision.
-			const bool isEmpty = voxelDef.type == ArenaTypes::VoxelType::None;
-			const bool isOpenDoor = [&coord, &voxelDef, chunk]()
-			{
-				if (voxelDef.type == ArenaTypes::VoxelType::Door)
-				{
-					const VoxelInstance *doorInst = chunk->tryGetVoxelInst(coord.voxel, VoxelInstance::Type::OpenDoor);
-					const bool isClosed = doorInst == nullptr;
-					return !isClosed;
-				}
-				else
-				{
-					return false;
-				}
-			}();
-
-			// -- Temporary hack for "on voxel enter" transitions --
-			// - @todo: replace with "on would enter voxel" event and near facing check.
-			const bool isLevelTransition = [&coord, &voxelDef, chunk]()
-			{
-				if (voxelDef.type == ArenaTypes::VoxelType::Wall)
-				{
-					// Check if there is a level change transition definition for this voxel.
-					const TransitionDefinition *transitionDef = chunk->tryGetTransition(coord.voxel);
-					return (transitionDef != nullptr) && (transitionDef->getType() == TransitionType::LevelChange);
-				}
-				else
-				{
-					return false;
-				}
-			}();
-
-			return !isEmpty && !isOpenDoor && !isLevelTransition;
+			const VoxelInstance *doorInst = chunk->tryGetVoxelInst(voxel, VoxelInstance::Type::OpenDoor);
+			const bool isClosed = doorInst == nullptr;
+			return isClosed;
 		}
+
+		return true;
 	};
 
-	if ((xVoxelDef != nullptr) && wouldCollideWithVoxel(nextXCoord, *xVoxelDef))
+	if (wouldCollideWithVoxel(nextXCoord))
 	{
 		this->velocity.x = 0.0;
 	}
 
-	if ((zVoxelDef != nullptr) && wouldCollideWithVoxel(nextZCoord, *zVoxelDef))
+	if (wouldCollideWithVoxel(nextZCoord))
 	{
 		this->velocity.z = 0.0;
 	}
@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <future>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -26,6 +28,7 @@
 
 #include "components/debug/Debug.h"
 #include "components/utilities/File.h"
+#include "components/utilities/Profiler.h"
 #include "components/utilities/String.h"
 #include "components/utilities/TextLinesFile.h"
 #include "components/vfs/manager.hpp"
@@ -39,6 +42,7 @@ namespace
 Game::Game()
 {
 	DebugLog("Initializing (Platform: " + Platform::getPlatform() + ").");
+	const auto startupStartTime = std::chrono::high_resolution_clock::now();
 
 	// Get the current working directory. This is most relevant for platforms
 	// like macOS, where the base path might be in the app's own "Resources" folder.
@@ -66,12 +70,20 @@ Game::Game()
 		this->options.getAudio_SoundVolume(), this->options.getAudio_SoundChannels(),
 		this->options.getAudio_SoundResampling(), this->options.getAudio_Is3DAudio(), midiPath);
 
-	// Initialize music library from file.
+	// Initialize music library from file. It only reads a text file, so it loads in the background while
+	// the renderer is set up.
 	const std::string musicLibraryPath = this->basePath + "data/audio/MusicDefinitions.txt";
-	if (!this->musicLibrary.init(musicLibraryPath.c_str()))
-	{
-		DebugLogError("Couldn't init music library at \"" + musicLibraryPath + "\".");
-	}
+	// Each startup library is timed on its own so the log can compare the concurrent total with loading them
+	// one after another.
+	Profiler::Sampler musicLibrarySampler;
+	std::future<bool> musicLibraryFuture = std::async(std::launch::async,
+		[this, musicLibraryPath, &musicLibrarySampler]()
+	{
+		musicLibrarySampler.setStart();
+		const bool success = this->musicLibrary.init(musicLibraryPath.c_str());
+		musicLibrarySampler.setStop();
+		return success;
+	});
 
 	// Initialize the renderer and window with the given settings.
 	auto resolutionScaleFunc = [this]()
@@ -153,30 +165,115 @@ Game::Game()
 		throw DebugException("\"" + fullArenaPath + "\" does not have an Arena executable.");
 	}();
 
-	// Load fonts.
-	if (!this->fontLibrary.init())
+	// Measure how fast the startup asset libraries read from the VFS.
+	const auto assetLoadStartTime = std::chrono::high_resolution_clock::now();
+	int startFileCount, startMappedFileCount;
+	size_t startByteCount;
+	VFS::Manager::get().getReadStats(&startFileCount, &startMappedFileCount, &startByteCount);
+
+	// Asset libraries that don't depend on each other are loaded concurrently. Character classes and entity
+	// definitions wait for the executable data in the binary asset library, and entity definitions are loaded
+	// on this thread because the texture manager isn't thread-safe.
+	Profiler::Sampler fontLibrarySampler, textAssetLibrarySampler, cinematicLibrarySampler,
+		binaryAssetLibrarySampler, charClassLibrarySampler, entityDefLibrarySampler;
+	std::future<bool> fontLibraryFuture = std::async(std::launch::async, [this, &fontLibrarySampler]()
+	{
+		fontLibrarySampler.setStart();
+		const bool success = this->fontLibrary.init();
+		fontLibrarySampler.setStop();
+		return success;
+	});
+
+	std::future<bool> textAssetLibraryFuture = std::async(std::launch::async, [this, &textAssetLibrarySampler]()
 	{
-		DebugCrash("Couldn't init font library.");
-	}
+		textAssetLibrarySampler.setStart();
+		const bool success = this->textAssetLibrary.init();
+		textAssetLibrarySampler.setStop();
+		return success;
+	});
 
-	// Load various asset libraries.
+	std::future<void> cinematicLibraryFuture = std::async(std::launch::async, [this, &cinematicLibrarySampler]()
+	{
+		cinematicLibrarySampler.setStart();
+		this->cinematicLibrary.init();
+		cinematicLibrarySampler.setStop();
+	});
+
+	binaryAssetLibrarySampler.setStart();
 	if (!this->binaryAssetLibrary.init(isFloppyVersion))
 	{
 		DebugCrash("Couldn't init binary asset library.");
 	}
 
-	if (!this->textAssetLibrary.init())
+	binaryAssetLibrarySampler.setStop();
+
+	// Load character classes (dependent on original game's data).
+	std::future<void> charClassLibraryFuture = std::async(std::launch::async, [this, &charClassLibrarySampler]()
+	{
+		charClassLibrarySampler.setStart();
+		this->charClassLibrary.init(this->binaryAssetLibrary.getExeData());
+		charClassLibrarySampler.setStop();
+	});
+
+	// Load entity definitions (dependent on original game's data).
+	entityDefLibrarySampler.setStart();
+	this->entityDefLibrary.init(this->binaryAssetLibrary.getExeData(), this->textureManager);
+	entityDefLibrarySampler.setStop();
+
+	if (!fontLibraryFuture.get())
+	{
+		DebugCrash("Couldn't init font library.");
+	}
+
+	if (!textAssetLibraryFuture.get())
 	{
 		DebugCrash("Couldn't init text asset library.");
 	}
 
-	// Load character classes (dependent on original game's data).
-	this->charClassLibrary.init(this->binaryAssetLibrary.getExeData());
+	cinematicLibraryFuture.get();
+	charClassLibraryFuture.get();
 
-	this->cinematicLibrary.init();
+	if (!musicLibraryFuture.get())
+	{
+		DebugLogError("Couldn't init music library at \"" + musicLibraryPath + "\".");
+	}
 
-	// Load entity definitions (dependent on original game's data).
-	this->entityDefLibrary.init(this->binaryAssetLibrary.getExeData(), this->textureManager);
+	const auto assetLoadEndTime = std::chrono::high_resolution_clock::now();
+	const double assetLoadSeconds = static_cast<double>((assetLoadEndTime - assetLoadStartTime).count()) /
+		static_cast<double>(std::nano::den);
+	int endFileCount, endMappedFileCount;
+	size_t endByteCount;
+	VFS::Manager::get().getReadStats(&endFileCount, &endMappedFileCount, &endByteCount);
+
+	const double assetLoadMegabytes = static_cast<double>(endByteCount - startByteCount) / (1024.0 * 1024.0);
+	const double assetLoadThroughput = (assetLoadSeconds > 0.0) ? (assetLoadMegabytes / assetLoadSeconds) : 0.0;
+	DebugLog("Loaded startup assets in " + String::fixedPrecision(assetLoadSeconds * 1000.0, 2) + "ms (" +
+		std::to_string(endFileCount - startFileCount) + " files, " +
+		std::to_string(endMappedFileCount - startMappedFileCount) + " mapped, " +
+		String::fixedPrecision(assetLoadMegabytes, 2) + " MB, " +
+		String::fixedPrecision(assetLoadThroughput, 2) + " MB/s).");
+
+	// The sum is roughly what startup cost when these loaded one after another.
+	const double sequentialLibraryMilliseconds = fontLibrarySampler.getMilliseconds() +
+		binaryAssetLibrarySampler.getMilliseconds() + textAssetLibrarySampler.getMilliseconds() +
+		charClassLibrarySampler.getMilliseconds() + cinematicLibrarySampler.getMilliseconds() +
+		entityDefLibrarySampler.getMilliseconds() + musicLibrarySampler.getMilliseconds();
+	const double concurrentLibrarySavedMilliseconds =
+		std::max(sequentialLibraryMilliseconds - (assetLoadSeconds * 1000.0), 0.0);
+	DebugLog("Startup asset libraries: fonts " + String::fixedPrecision(fontLibrarySampler.getMilliseconds(), 2) +
+		"ms, binary assets " + String::fixedPrecision(binaryAssetLibrarySampler.getMilliseconds(), 2) +
+		"ms, text assets " + String::fixedPrecision(textAssetLibrarySampler.getMilliseconds(), 2) +
+		"ms, character classes " + String::fixedPrecision(charClassLibrarySampler.getMilliseconds(), 2) +
+		"ms, cinematics " + String::fixedPrecision(cinematicLibrarySampler.getMilliseconds(), 2) +
+		"ms, entity definitions " + String::fixedPrecision(entityDefLibrarySampler.getMilliseconds(), 2) +
+		"ms, music " + String::fixedPrecision(musicLibrarySampler.getMilliseconds(), 2) + "ms (" +
+		String::fixedPrecision(sequentialLibraryMilliseconds, 2) + "ms one after another).");
+
+	int indexEntryCount, indexLookupCount, indexAvoidedOpenCount;
+	VFS::Manager::get().getCaseInsensitiveIndexStats(&indexEntryCount, &indexLookupCount, &indexAvoidedOpenCount);
+	DebugLog("Case-insensitive file index: " + std::to_string(indexEntryCount) + " files, " +
+		std::to_string(indexLookupCount) + " lookups, " + std::to_string(indexAvoidedOpenCount) +
+		" filesystem opens avoided.");
 
 	// Load and set window icon.
 	const Surface icon = [this]()
@@ -211,6 +308,7 @@ Game::Game()
 
 	this->random.init();
 	this->scratchAllocator.init(SCRATCH_BUFFER_SIZE);
+	this->threadPool.init(Platform::getThreadCount());
 
 	// Initialize panel and music to default.
 	this->panel = IntroUiModel::makeStartupPanel(*this);
@@ -246,10 +344,21 @@ Game::Game()
 	this->requestedSubPanelPop = false;
 
 	this->running = true;
+
+	const auto startupEndTime = std::chrono::high_resolution_clock::now();
+	const double startupSeconds = static_cast<double>((startupEndTime - startupStartTime).count()) /
+		static_cast<double>(std::nano::den);
+	DebugLog("Startup finished in " + String::fixedPrecision(startupSeconds * 1000.0, 2) + "ms (about " +
+		String::fixedPrecision((startupSeconds * 1000.0) + concurrentLibrarySavedMilliseconds, 2) +
+		"ms with asset libraries loaded one after another).");
 }
 
 Game::~Game()
 {
+	// Destroy the game state first so any map generation still running on a worker thread is done before
+	// the asset libraries it reads from are destroyed.
+	this->gameState = nullptr;
+
 	if (this->applicationExitListenerID.has_value())
 	{
 		this->inputManager.removeListener(*this->applicationExitListenerID);
@@ -369,6 +478,11 @@ ScratchAllocator &Game::getScratchAllocator()
 	return this->scratchAllocator;
 }
 
+ThreadPool &Game::getThreadPool()
+{
+	return this->threadPool;
+}
+
 Profiler &Game::getProfiler()
 {
 	return this->profiler;
@@ -617,6 +731,15 @@ void Game::renderDebugInfo()
 				"Vis flats: " + std::to_string(profilerData.visFlatCount) + " (" +
 				std::to_string(profilerData.potentiallyVisFlatCount) + ")" +
 				", lights: " + std::to_string(profilerData.visLightCount));
+
+			const RendererSystem3D::TextureResidencyStats textureStats = this->renderer.getTextureResidencyStats();
+			const int textureRequestCount = textureStats.hitCount + textureStats.missCount;
+			const double textureHitPercent = (textureRequestCount > 0) ?
+				(100.0 * static_cast<double>(textureStats.hitCount) / static_cast<double>(textureRequestCount)) : 0.0;
+			debugText.append("\nTextures: " + std::to_string(textureStats.referencedCount) + " used, " +
+				std::to_string(textureStats.residentCount) + " resident (" +
+				String::fixedPrecision(static_cast<double>(textureStats.byteCount) / (1024.0 * 1024.0), 1) + "MB), " +
+				String::fixedPrecision(textureHitPercent, 1) + "% hit rate");
 		}
 		else
 		{
@@ -644,6 +767,20 @@ void Game::renderDebugInfo()
 			debugText.append("\nChunk: " + chunkStr + '\n' +
 				"Chunk pos: " + chunkPosX + ", " + chunkPosY + ", " + chunkPosZ + '\n' +
 				"Dir: " + dirX + ", " + dirY + ", " + dirZ);
+
+			// Voxel instance update cost (only animating ones are updated each frame).
+			const ChunkManager &chunkManager = this->gameState->getActiveMapInst().getActiveLevel().getChunkManager();
+			int voxelInstCount, activeVoxelInstCount;
+			chunkManager.getVoxelInstCounts(&voxelInstCount, &activeVoxelInstCount);
+			const std::string voxelInstTime = String::fixedPrecision(chunkManager.getVoxelInstUpdateTime() * 1000.0, 3);
+			debugText.append("\nVoxel insts: " + std::to_string(activeVoxelInstCount) + " active (" +
+				std::to_string(voxelInstCount) + "), update: " + voxelInstTime + "ms");
+
+			// Voxel memory of the active chunk set.
+			const std::string chunkVoxelKB = String::fixedPrecision(
+				static_cast<double>(chunkManager.getVoxelByteCount()) / 1024.0, 1);
+			debugText.append("\nChunks: " + std::to_string(chunkManager.getChunkCount()) + ", voxels: " +
+				chunkVoxelKB + "KB");
 		}
 		else
 		{
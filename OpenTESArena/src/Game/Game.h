@@ -23,6 +23,7 @@
 #include "../Rendering/Renderer.h"
 #include "../UI/FontLibrary.h"
 #include "../UI/TextBox.h"
+#include "../Utilities/ThreadPool.h"
 
 #include "components/utilities/Allocator.h"
 #include "components/utilities/FPSCounter.h"
@@ -79,6 +80,7 @@ private:
 	TextAssetLibrary textAssetLibrary;
 	Random random; // Convenience random for ease of use.
 	ScratchAllocator scratchAllocator;
+	ThreadPool threadPool; // For splitting per-frame work between threads.
 	Profiler profiler;
 	FPSCounter fpsCounter;
 	std::string basePath, optionsPath;
@@ -179,6 +181,9 @@ public:
 	// Gets the scratch buffer that is reset each frame.
 	ScratchAllocator &getScratchAllocator();
 
+	// Gets the worker threads shared by per-frame systems on the main thread.
+	ThreadPool &getThreadPool();
+
 	// Gets the profiler instance for measuring precise time spans.
 	Profiler &getProfiler();
 
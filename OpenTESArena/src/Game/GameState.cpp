@@ -1,6 +1,8 @@
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
+#include <future>
 #include <tuple>
 
 #include "SDL.h"
@@ -23,8 +25,10 @@
 #include "../UI/TextAlignment.h"
 #include "../UI/TextBox.h"
 #include "../UI/TextRenderUtils.h"
+#include "../Utilities/Platform.h"
 #include "../World/ArenaVoxelUtils.h"
 #include "../World/ArenaWeatherUtils.h"
+#include "../World/MapDefinitionFile.h"
 #include "../World/MapType.h"
 #include "../World/WeatherUtils.h"
 #include "../WorldMap/LocationDefinition.h"
@@ -33,13 +37,56 @@
 #include "components/debug/Debug.h"
 #include "components/utilities/String.h"
 
+namespace
+{
+	// Gets milliseconds elapsed since the given time point, for logging map load phases.
+	double GetMillisecondsSince(const std::chrono::high_resolution_clock::time_point &startTime)
+	{
+		const auto endTime = std::chrono::high_resolution_clock::now();
+		const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime);
+		const double seconds = static_cast<double>(nanoseconds.count()) / static_cast<double>(std::nano::den);
+		return seconds * 1000.0;
+	}
+
+	std::shared_ptr<const MapGeneration::CityGenInfo> CopyCityGenInfo(const MapGeneration::CityGenInfo &cityGenInfo)
+	{
+		const Buffer<uint8_t> &srcReservedBlocks = cityGenInfo.reservedBlocks;
+		Buffer<uint8_t> reservedBlocks(srcReservedBlocks.getCount());
+		if (srcReservedBlocks.getCount() > 0)
+		{
+			std::copy(srcReservedBlocks.get(), srcReservedBlocks.end(), reservedBlocks.get());
+		}
+
+		auto cityGenInfoCopy = std::make_shared<MapGeneration::CityGenInfo>();
+		cityGenInfoCopy->init(std::string(cityGenInfo.mifName), std::string(cityGenInfo.cityTypeName),
+			cityGenInfo.cityType, cityGenInfo.citySeed, cityGenInfo.rulerSeed, cityGenInfo.raceID,
+			cityGenInfo.isPremade, cityGenInfo.coastal, cityGenInfo.rulerIsMale, cityGenInfo.palaceIsMainQuestDungeon,
+			std::move(reservedBlocks), cityGenInfo.mainQuestTempleOverride, cityGenInfo.blockStartPosX,
+			cityGenInfo.blockStartPosY, cityGenInfo.cityBlocksPerSide);
+		return cityGenInfoCopy;
+	}
+
+	std::shared_ptr<const MapGeneration::WildGenInfo> CopyWildGenInfo(const MapGeneration::WildGenInfo &wildGenInfo)
+	{
+		const Buffer2D<ArenaWildUtils::WildBlockID> &srcWildBlockIDs = wildGenInfo.wildBlockIDs;
+		Buffer2D<ArenaWildUtils::WildBlockID> wildBlockIDs(srcWildBlockIDs.getWidth(), srcWildBlockIDs.getHeight());
+		std::copy(srcWildBlockIDs.get(), srcWildBlockIDs.end(), wildBlockIDs.get());
+
+		// The city definition is owned by the world map definition, which outlives any map load.
+		DebugAssert(wildGenInfo.cityDef != nullptr);
+		auto wildGenInfoCopy = std::make_shared<MapGeneration::WildGenInfo>();
+		wildGenInfoCopy->init(std::move(wildBlockIDs), *wildGenInfo.cityDef, wildGenInfo.fallbackSeed);
+		return wildGenInfoCopy;
+	}
+}
+
 GameState::WorldMapLocationIDs::WorldMapLocationIDs(int provinceID, int locationID)
 {
 	this->provinceID = provinceID;
 	this->locationID = locationID;
 }
 
-void GameState::MapState::init(MapDefinition &&mapDefinition, MapInstance &&mapInstance,
+void GameState::MapState::init(std::shared_ptr<const MapDefinition> &&mapDefinition, MapInstance &&mapInstance,
 	WeatherDefinition &&weatherDef, const std::optional<CoordInt3> &returnCoord)
 {
 	this->definition = std::move(mapDefinition);
@@ -60,6 +107,25 @@ void GameState::MapTransitionState::init(MapState &&mapState,
 	this->enteringInteriorFromExterior = enteringInteriorFromExterior;
 }
 
+void GameState::MapLoadState::init(std::string &&name, std::string &&cacheKey,
+	std::future<std::unique_ptr<MapDefinition>> &&mapDefinitionFuture, MapTransitionFinishFunc &&finishFunc)
+{
+	this->name = std::move(name);
+	this->cacheKey = std::move(cacheKey);
+	this->mapDefinitionFuture = std::move(mapDefinitionFuture);
+	this->finishFunc = std::move(finishFunc);
+	this->startTime = std::chrono::high_resolution_clock::now();
+}
+
+void GameState::MapPrefetchState::init(std::string &&cacheKey,
+	std::future<std::unique_ptr<MapDefinition>> &&mapDefinitionFuture)
+{
+	this->cacheKey = std::move(cacheKey);
+	this->mapDefinitionFuture = std::move(mapDefinitionFuture);
+	this->startTime = std::chrono::high_resolution_clock::now();
+	this->wanted = true;
+}
+
 GameState::GameState(Player &&player, const BinaryAssetLibrary &binaryAssetLibrary)
 	: player(std::move(player))
 {
@@ -115,6 +181,17 @@ GameState::GameState(Player &&player, const BinaryAssetLibrary &binaryAssetLibra
 GameState::~GameState()
 {
 	DebugLog("Closing.");
+
+	// Map generation workers reference the game's asset libraries, so they must finish before this returns.
+	if (this->mapLoad != nullptr)
+	{
+		this->mapLoad->mapDefinitionFuture.wait();
+	}
+
+	if (this->mapPrefetch != nullptr)
+	{
+		this->mapPrefetch->mapDefinitionFuture.wait();
+	}
 }
 
 /*bool GameState::tryMakeMapFromLocation(const LocationDefinition &locationDef, int raceID, WeatherType weatherType,
@@ -225,7 +302,7 @@ bool GameState::trySetFromWorldMap(int provinceID, int locationID, const std::op
 	const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
 	const TextAssetLibrary &textAssetLibrary, TextureManager &textureManager, Renderer &renderer)
 {
-	DebugAssertMsg(this->nextMap == nullptr, "Already have a map to transition to.");
+	DebugAssertMsg(this->getMapTransitionStage() == MapTransitionStage::None, "Already have a map to transition to.");
 
 	// Get the province and location definitions.
 	if ((provinceID < 0) || (provinceID >= this->worldMapDef.getProvinceCount()))
@@ -330,49 +407,53 @@ bool GameState::tryPushInterior(const MapGeneration::InteriorGenInfo &interiorGe
 	const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
 	TextureManager &textureManager, Renderer &renderer)
 {
-	DebugAssertMsg(this->nextMap == nullptr, "Already have a map to transition to.");
+	DebugAssertMsg(this->getMapTransitionStage() == MapTransitionStage::None, "Already have a map to transition to.");
 
-	MapDefinition mapDefinition;
-	if (!mapDefinition.initInterior(interiorGenInfo, charClassLibrary, entityDefLibrary,
-		binaryAssetLibrary, textureManager))
+	MapDefinitionGenFunc genFunc = GameState::makeInteriorGenFunc(interiorGenInfo, charClassLibrary,
+		entityDefLibrary, binaryAssetLibrary);
+
+	const uint32_t weatherSeed = this->arenaRandom.getSeed();
+	MapTransitionFinishFunc finishFunc = [returnCoord, weatherSeed](GameState &gameState,
+		std::shared_ptr<const MapDefinition> &&mapDefinition, const EntityDefinitionLibrary &entityDefLibrary,
+		TextureManager &textureManager, Renderer &renderer)
 	{
-		DebugLogError("Couldn't init interior map from generation info.");
-		return false;
-	}
+		constexpr int currentDay = 0; // Doesn't matter for interiors.
 
-	constexpr int currentDay = 0; // Doesn't matter for interiors.
+		MapInstance mapInstance;
+		mapInstance.init(*mapDefinition, currentDay, textureManager);
 
-	MapInstance mapInstance;
-	mapInstance.init(mapDefinition, currentDay, textureManager);
+		// Save return voxel to the current exterior (if any).
+		if (gameState.maps.size() > 0)
+		{
+			MapState &activeMapState = gameState.maps.top();
+			activeMapState.returnCoord = returnCoord;
+		}
 
-	// Save return voxel to the current exterior (if any).
-	if (this->maps.size() > 0)
-	{
-		MapState &activeMapState = this->maps.top();
-		activeMapState.returnCoord = returnCoord;
-	}
+		DebugAssert(mapDefinition->getStartPointCount() > 0);
+		const LevelDouble2 &startPoint = mapDefinition->getStartPoint(0);
+		const CoordInt2 startCoord = VoxelUtils::levelVoxelToCoord(VoxelUtils::pointToVoxel(startPoint));
 
-	DebugAssert(mapDefinition.getStartPointCount() > 0);
-	const LevelDouble2 &startPoint = mapDefinition.getStartPoint(0);
-	const CoordInt2 startCoord = VoxelUtils::levelVoxelToCoord(VoxelUtils::pointToVoxel(startPoint));
+		// Interiors are always clear weather.
+		Random weatherRandom(weatherSeed); // Cosmetic random.
+		WeatherDefinition weatherDef;
+		weatherDef.initFromClassic(ArenaTypes::WeatherType::Clear, currentDay, weatherRandom);
 
-	// Interiors are always clear weather.
-	Random weatherRandom(this->arenaRandom.getSeed()); // Cosmetic random.
-	WeatherDefinition weatherDef;
-	weatherDef.initFromClassic(ArenaTypes::WeatherType::Clear, currentDay, weatherRandom);
+		MapState mapState;
+		mapState.init(std::move(mapDefinition), std::move(mapInstance), std::move(weatherDef), std::nullopt);
 
-	MapState mapState;
-	mapState.init(std::move(mapDefinition), std::move(mapInstance), std::move(weatherDef), std::nullopt);
+		const std::optional<WorldMapLocationIDs> worldMapLocationIDs; // Doesn't change when pushing an interior.
+		std::optional<CitizenUtils::CitizenGenInfo> citizenGenInfo; // No citizens in interiors.
+		constexpr bool enteringInteriorFromExterior = true;
 
-	const std::optional<WorldMapLocationIDs> worldMapLocationIDs; // Doesn't change when pushing an interior.
-	std::optional<CitizenUtils::CitizenGenInfo> citizenGenInfo; // No citizens in interiors.
-	constexpr bool enteringInteriorFromExterior = true;
+		gameState.nextMap = std::make_unique<MapTransitionState>();
+		gameState.nextMap->init(std::move(mapState), worldMapLocationIDs, std::move(citizenGenInfo),
+			startCoord, enteringInteriorFromExterior);
 
-	this->nextMap = std::make_unique<MapTransitionState>();
-	this->nextMap->init(std::move(mapState), worldMapLocationIDs, std::move(citizenGenInfo),
-		startCoord, enteringInteriorFromExterior);
+		return true;
+	};
 
-	return true;
+	return this->tryLoadMap("interior", MapDefinitionCache::makeInteriorKey(interiorGenInfo), std::move(genFunc),
+		std::move(finishFunc), entityDefLibrary, binaryAssetLibrary, textureManager, renderer);
 }
 
 bool GameState::trySetInterior(const MapGeneration::InteriorGenInfo &interiorGenInfo,
@@ -380,50 +461,54 @@ bool GameState::trySetInterior(const MapGeneration::InteriorGenInfo &interiorGen
 	const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
 	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager, Renderer &renderer)
 {
-	DebugAssertMsg(this->nextMap == nullptr, "Already have a map to transition to.");
+	DebugAssertMsg(this->getMapTransitionStage() == MapTransitionStage::None, "Already have a map to transition to.");
 
-	MapDefinition mapDefinition;
-	if (!mapDefinition.initInterior(interiorGenInfo, charClassLibrary, entityDefLibrary,
-		binaryAssetLibrary, textureManager))
+	MapDefinitionGenFunc genFunc = GameState::makeInteriorGenFunc(interiorGenInfo, charClassLibrary,
+		entityDefLibrary, binaryAssetLibrary);
+
+	const uint32_t weatherSeed = this->arenaRandom.getSeed();
+	MapTransitionFinishFunc finishFunc = [playerStartOffset, worldMapLocationIDs, weatherSeed](
+		GameState &gameState, std::shared_ptr<const MapDefinition> &&mapDefinition,
+		const EntityDefinitionLibrary &entityDefLibrary, TextureManager &textureManager, Renderer &renderer)
 	{
-		DebugLogError("Couldn't init interior map from generation info.");
-		return false;
-	}
+		constexpr int currentDay = 0; // Doesn't matter for interiors.
 
-	constexpr int currentDay = 0; // Doesn't matter for interiors.
+		MapInstance mapInstance;
+		mapInstance.init(*mapDefinition, currentDay, textureManager);
 
-	MapInstance mapInstance;
-	mapInstance.init(mapDefinition, currentDay, textureManager);
+		const CoordInt2 startCoord = [&playerStartOffset, &mapDefinition]()
+		{
+			DebugAssert(mapDefinition->getStartPointCount() > 0);
+			const LevelDouble2 &startPoint = mapDefinition->getStartPoint(0);
+			const LevelInt2 startVoxel = VoxelUtils::pointToVoxel(startPoint);
+			const CoordInt2 coord = VoxelUtils::levelVoxelToCoord(startVoxel);
+			const VoxelInt2 offset = playerStartOffset.has_value() ? *playerStartOffset : VoxelInt2::Zero;
+			return ChunkUtils::recalculateCoord(coord.chunk, coord.voxel + offset);
+		}();
 
-	const CoordInt2 startCoord = [&playerStartOffset, &mapDefinition]()
-	{
-		DebugAssert(mapDefinition.getStartPointCount() > 0);
-		const LevelDouble2 &startPoint = mapDefinition.getStartPoint(0);
-		const LevelInt2 startVoxel = VoxelUtils::pointToVoxel(startPoint);
-		const CoordInt2 coord = VoxelUtils::levelVoxelToCoord(startVoxel);
-		const VoxelInt2 offset = playerStartOffset.has_value() ? *playerStartOffset : VoxelInt2::Zero;
-		return ChunkUtils::recalculateCoord(coord.chunk, coord.voxel + offset);
-	}();
+		// Interiors are always clear weather.
+		Random weatherRandom(weatherSeed); // Cosmetic random.
+		WeatherDefinition weatherDef;
+		weatherDef.initFromClassic(ArenaTypes::WeatherType::Clear, currentDay, weatherRandom);
 
-	// Interiors are always clear weather.
-	Random weatherRandom(this->arenaRandom.getSeed()); // Cosmetic random.
-	WeatherDefinition weatherDef;
-	weatherDef.initFromClassic(ArenaTypes::WeatherType::Clear, currentDay, weatherRandom);
+		MapState mapState;
+		mapState.init(std::move(mapDefinition), std::move(mapInstance), std::move(weatherDef), std::nullopt);
 
-	MapState mapState;
-	mapState.init(std::move(mapDefinition), std::move(mapInstance), std::move(weatherDef), std::nullopt);
+		std::optional<CitizenUtils::CitizenGenInfo> citizenGenInfo; // No citizens in interiors.
+		constexpr bool enteringInteriorFromExterior = false; // This method doesn't keep an exterior alive.
 
-	std::optional<CitizenUtils::CitizenGenInfo> citizenGenInfo; // No citizens in interiors.
-	constexpr bool enteringInteriorFromExterior = false; // This method doesn't keep an exterior alive.
+		gameState.nextMap = std::make_unique<MapTransitionState>();
+		gameState.nextMap->init(std::move(mapState), worldMapLocationIDs, std::move(citizenGenInfo),
+			startCoord, enteringInteriorFromExterior);
 
-	this->nextMap = std::make_unique<MapTransitionState>();
-	this->nextMap->init(std::move(mapState), worldMapLocationIDs, std::move(citizenGenInfo),
-		startCoord, enteringInteriorFromExterior);
+		// @todo: hack to make fast travel not crash when iterating stale distant objects in renderer
+		renderer.clearSky();
 
-	// @todo: hack to make fast travel not crash when iterating stale distant objects in renderer
-	renderer.clearSky();
+		return true;
+	};
 
-	return true;
+	return this->tryLoadMap("interior", MapDefinitionCache::makeInteriorKey(interiorGenInfo), std::move(genFunc),
+		std::move(finishFunc), entityDefLibrary, binaryAssetLibrary, textureManager, renderer);
 }
 
 bool GameState::trySetCity(const MapGeneration::CityGenInfo &cityGenInfo,
@@ -433,69 +518,87 @@ bool GameState::trySetCity(const MapGeneration::CityGenInfo &cityGenInfo,
 	const BinaryAssetLibrary &binaryAssetLibrary, const TextAssetLibrary &textAssetLibrary,
 	TextureManager &textureManager, Renderer &renderer)
 {
-	DebugAssertMsg(this->nextMap == nullptr, "Already have a map to transition to.");
+	DebugAssertMsg(this->getMapTransitionStage() == MapTransitionStage::None, "Already have a map to transition to.");
 
-	MapDefinition mapDefinition;
-	if (!mapDefinition.initCity(cityGenInfo, skyGenInfo, charClassLibrary, entityDefLibrary,
-		binaryAssetLibrary, textAssetLibrary, textureManager))
-	{
-		DebugLogError("Couldn't init city map from generation info.");
-		return false;
-	}
+	// The caller's generation info might not outlive a background load.
+	std::shared_ptr<const MapGeneration::CityGenInfo> cityGenInfoCopy = CopyCityGenInfo(cityGenInfo);
 
-	MapInstance mapInstance;
-	mapInstance.init(mapDefinition, skyGenInfo.currentDay, textureManager);
+	MapDefinitionGenFunc genFunc = [cityGenInfoCopy, skyGenInfo, &charClassLibrary, &entityDefLibrary,
+		&binaryAssetLibrary, &textAssetLibrary](TextureManager &textureManager, MapDefinition *outMapDefinition)
+	{
+		if (!outMapDefinition->initCity(*cityGenInfoCopy, skyGenInfo, charClassLibrary, entityDefLibrary,
+			binaryAssetLibrary, textAssetLibrary, textureManager))
+		{
+			DebugLogError("Couldn't init city map from generation info.");
+			return false;
+		}
 
-	DebugAssert(mapDefinition.getStartPointCount() > 0);
-	const LevelDouble2 &startPoint = mapDefinition.getStartPoint(0);
-	const CoordInt2 startCoord = VoxelUtils::levelVoxelToCoord(VoxelUtils::pointToVoxel(startPoint));
+		return true;
+	};
 
-	const ProvinceDefinition *provinceDefPtr = nullptr;
-	const LocationDefinition *locationDefPtr = nullptr;
-	if (newWorldMapLocationIDs.has_value())
-	{
-		provinceDefPtr = &this->worldMapDef.getProvinceDef(newWorldMapLocationIDs->provinceID);
-		locationDefPtr = &provinceDefPtr->getLocationDef(newWorldMapLocationIDs->locationID);
-	}
-	else
+	const int currentDay = skyGenInfo.currentDay;
+	MapTransitionFinishFunc finishFunc = [overrideWeather, newWorldMapLocationIDs, currentDay](
+		GameState &gameState, std::shared_ptr<const MapDefinition> &&mapDefinition,
+		const EntityDefinitionLibrary &entityDefLibrary, TextureManager &textureManager, Renderer &renderer)
 	{
-		// Use existing world map location (likely a wilderness->city transition).
-		provinceDefPtr = &this->getProvinceDefinition();
-		locationDefPtr = &this->getLocationDefinition();
-	}
+		MapInstance mapInstance;
+		mapInstance.init(*mapDefinition, currentDay, textureManager);
 
-	const LocationDefinition::CityDefinition &cityDef = locationDefPtr->getCityDefinition();
-	WeatherDefinition weatherDef = [&overrideWeather, &cityDef]()
-	{
-		if (overrideWeather.has_value())
+		DebugAssert(mapDefinition->getStartPointCount() > 0);
+		const LevelDouble2 &startPoint = mapDefinition->getStartPoint(0);
+		const CoordInt2 startCoord = VoxelUtils::levelVoxelToCoord(VoxelUtils::pointToVoxel(startPoint));
+
+		const ProvinceDefinition *provinceDefPtr = nullptr;
+		const LocationDefinition *locationDefPtr = nullptr;
+		if (newWorldMapLocationIDs.has_value())
 		{
-			// Use this when we don't want to randomly generate the weather.
-			return WeatherUtils::getFilteredWeather(*overrideWeather, cityDef.climateType);
+			provinceDefPtr = &gameState.worldMapDef.getProvinceDef(newWorldMapLocationIDs->provinceID);
+			locationDefPtr = &provinceDefPtr->getLocationDef(newWorldMapLocationIDs->locationID);
 		}
 		else
 		{
-			WeatherDefinition def;
-			def.initClear(); // @todo: generate the weather for this location.
-			return def; 
+			// Use existing world map location (likely a wilderness->city transition).
+			provinceDefPtr = &gameState.getProvinceDefinition();
+			locationDefPtr = &gameState.getLocationDefinition();
 		}
-	}();
 
-	MapState mapState;
-	mapState.init(std::move(mapDefinition), std::move(mapInstance), std::move(weatherDef), std::nullopt);
-	
-	CitizenUtils::CitizenGenInfo citizenGenInfo = CitizenUtils::makeCitizenGenInfo(
-		provinceDefPtr->getRaceID(), cityDef.climateType, entityDefLibrary, textureManager);
+		const LocationDefinition::CityDefinition &cityDef = locationDefPtr->getCityDefinition();
+		WeatherDefinition weatherDef = [&overrideWeather, &cityDef]()
+		{
+			if (overrideWeather.has_value())
+			{
+				// Use this when we don't want to randomly generate the weather.
+				return WeatherUtils::getFilteredWeather(*overrideWeather, cityDef.climateType);
+			}
+			else
+			{
+				WeatherDefinition def;
+				def.initClear(); // @todo: generate the weather for this location.
+				return def; 
+			}
+		}();
 
-	constexpr std::optional<bool> enteringInteriorFromExterior; // Unused for exteriors.
+		MapState mapState;
+		mapState.init(std::move(mapDefinition), std::move(mapInstance), std::move(weatherDef), std::nullopt);
 
-	this->nextMap = std::make_unique<MapTransitionState>();
-	this->nextMap->init(std::move(mapState), newWorldMapLocationIDs, std::move(citizenGenInfo),
-		startCoord, enteringInteriorFromExterior);
+		CitizenUtils::CitizenGenInfo citizenGenInfo = CitizenUtils::makeCitizenGenInfo(
+			provinceDefPtr->getRaceID(), cityDef.climateType, entityDefLibrary, textureManager);
 
-	// @todo: hack to make fast travel not crash when iterating stale distant objects in renderer
-	renderer.clearSky();
+		constexpr std::optional<bool> enteringInteriorFromExterior; // Unused for exteriors.
 
-	return true;
+		gameState.nextMap = std::make_unique<MapTransitionState>();
+		gameState.nextMap->init(std::move(mapState), newWorldMapLocationIDs, std::move(citizenGenInfo),
+			startCoord, enteringInteriorFromExterior);
+
+		// @todo: hack to make fast travel not crash when iterating stale distant objects in renderer
+		renderer.clearSky();
+
+		return true;
+	};
+
+	return this->tryLoadMap("city \"" + cityGenInfo.mifName + "\"",
+		MapDefinitionCache::makeCityKey(cityGenInfo, skyGenInfo), std::move(genFunc), std::move(finishFunc),
+		entityDefLibrary, binaryAssetLibrary, textureManager, renderer);
 }
 
 bool GameState::trySetWilderness(const MapGeneration::WildGenInfo &wildGenInfo,
@@ -504,90 +607,109 @@ bool GameState::trySetWilderness(const MapGeneration::WildGenInfo &wildGenInfo,
 	const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
 	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager, Renderer &renderer)
 {
-	DebugAssertMsg(this->nextMap == nullptr, "Already have a map to transition to.");
+	DebugAssertMsg(this->getMapTransitionStage() == MapTransitionStage::None, "Already have a map to transition to.");
 
 	// @todo: try to get gate position if current active map is for city -- need to have saved it from when the
 	// gate was clicked in GameWorldPanel.
-	
-	MapDefinition mapDefinition;
-	if (!mapDefinition.initWild(wildGenInfo, skyGenInfo, charClassLibrary, entityDefLibrary,
-		binaryAssetLibrary, textureManager))
-	{
-		DebugLogError("Couldn't init wild map from generation info.");
-		return false;
-	}
 
-	MapInstance mapInstance;
-	mapInstance.init(mapDefinition, skyGenInfo.currentDay, textureManager);
+	// The caller's generation info might not outlive a background load.
+	std::shared_ptr<const MapGeneration::WildGenInfo> wildGenInfoCopy = CopyWildGenInfo(wildGenInfo);
 
-	// Wilderness start point depends on city gate the player is coming out of.
-	DebugAssert(mapDefinition.getStartPointCount() == 0);
-	const CoordInt2 actualStartCoord = [&startCoord]()
+	MapDefinitionGenFunc genFunc = [wildGenInfoCopy, skyGenInfo, &charClassLibrary, &entityDefLibrary,
+		&binaryAssetLibrary](TextureManager &textureManager, MapDefinition *outMapDefinition)
 	{
-		if (startCoord.has_value())
-		{
-			return CoordInt2(startCoord->chunk, VoxelInt2(startCoord->voxel.x, startCoord->voxel.z));
-		}
-		else
+		if (!outMapDefinition->initWild(*wildGenInfoCopy, skyGenInfo, charClassLibrary, entityDefLibrary,
+			binaryAssetLibrary, textureManager))
 		{
-			// Don't have a city gate reference. Just pick somewhere in the center of the wilderness.
-			return CoordInt2(
-				ChunkInt2(ArenaWildUtils::WILD_WIDTH / 2, ArenaWildUtils::WILD_HEIGHT / 2),
-				VoxelInt2::Zero);
+			DebugLogError("Couldn't init wild map from generation info.");
+			return false;
 		}
-	}();
 
-	const ProvinceDefinition *provinceDefPtr = nullptr;
-	const LocationDefinition *locationDefPtr = nullptr;
-	if (newWorldMapLocationIDs.has_value())
-	{
-		provinceDefPtr = &this->worldMapDef.getProvinceDef(newWorldMapLocationIDs->provinceID);
-		locationDefPtr = &provinceDefPtr->getLocationDef(newWorldMapLocationIDs->locationID);
-	}
-	else
-	{
-		// Use existing world map location (likely a city->wilderness transition).
-		provinceDefPtr = &this->getProvinceDefinition();
-		locationDefPtr = &this->getLocationDefinition();
-	}
+		return true;
+	};
 
-	const LocationDefinition::CityDefinition &cityDef = locationDefPtr->getCityDefinition();
-	WeatherDefinition weatherDef = [&overrideWeather, &cityDef]()
+	const int currentDay = skyGenInfo.currentDay;
+	MapTransitionFinishFunc finishFunc = [overrideWeather, startCoord, newWorldMapLocationIDs, currentDay](
+		GameState &gameState, std::shared_ptr<const MapDefinition> &&mapDefinition,
+		const EntityDefinitionLibrary &entityDefLibrary, TextureManager &textureManager, Renderer &renderer)
 	{
-		if (overrideWeather.has_value())
+		MapInstance mapInstance;
+		mapInstance.init(*mapDefinition, currentDay, textureManager);
+
+		// Wilderness start point depends on city gate the player is coming out of.
+		DebugAssert(mapDefinition->getStartPointCount() == 0);
+		const CoordInt2 actualStartCoord = [&startCoord]()
 		{
-			// Use this when we don't want to randomly generate the weather.
-			return WeatherUtils::getFilteredWeather(*overrideWeather, cityDef.climateType);
+			if (startCoord.has_value())
+			{
+				return CoordInt2(startCoord->chunk, VoxelInt2(startCoord->voxel.x, startCoord->voxel.z));
+			}
+			else
+			{
+				// Don't have a city gate reference. Just pick somewhere in the center of the wilderness.
+				return CoordInt2(
+					ChunkInt2(ArenaWildUtils::WILD_WIDTH / 2, ArenaWildUtils::WILD_HEIGHT / 2),
+					VoxelInt2::Zero);
+			}
+		}();
+
+		const ProvinceDefinition *provinceDefPtr = nullptr;
+		const LocationDefinition *locationDefPtr = nullptr;
+		if (newWorldMapLocationIDs.has_value())
+		{
+			provinceDefPtr = &gameState.worldMapDef.getProvinceDef(newWorldMapLocationIDs->provinceID);
+			locationDefPtr = &provinceDefPtr->getLocationDef(newWorldMapLocationIDs->locationID);
 		}
 		else
 		{
-			WeatherDefinition def;
-			def.initClear(); // @todo: generate the weather for this location.
-			return def;
+			// Use existing world map location (likely a city->wilderness transition).
+			provinceDefPtr = &gameState.getProvinceDefinition();
+			locationDefPtr = &gameState.getLocationDefinition();
 		}
-	}();
 
-	MapState mapState;
-	mapState.init(std::move(mapDefinition), std::move(mapInstance), std::move(weatherDef), std::nullopt);
+		const LocationDefinition::CityDefinition &cityDef = locationDefPtr->getCityDefinition();
+		WeatherDefinition weatherDef = [&overrideWeather, &cityDef]()
+		{
+			if (overrideWeather.has_value())
+			{
+				// Use this when we don't want to randomly generate the weather.
+				return WeatherUtils::getFilteredWeather(*overrideWeather, cityDef.climateType);
+			}
+			else
+			{
+				WeatherDefinition def;
+				def.initClear(); // @todo: generate the weather for this location.
+				return def;
+			}
+		}();
 
-	CitizenUtils::CitizenGenInfo citizenGenInfo = CitizenUtils::makeCitizenGenInfo(
-		provinceDefPtr->getRaceID(), cityDef.climateType, entityDefLibrary, textureManager);
+		MapState mapState;
+		mapState.init(std::move(mapDefinition), std::move(mapInstance), std::move(weatherDef), std::nullopt);
 
-	constexpr std::optional<bool> enteringInteriorFromExterior; // Unused for exteriors.
+		CitizenUtils::CitizenGenInfo citizenGenInfo = CitizenUtils::makeCitizenGenInfo(
+			provinceDefPtr->getRaceID(), cityDef.climateType, entityDefLibrary, textureManager);
 
-	this->nextMap = std::make_unique<MapTransitionState>();
-	this->nextMap->init(std::move(mapState), newWorldMapLocationIDs, std::move(citizenGenInfo),
-		actualStartCoord, enteringInteriorFromExterior);
+		constexpr std::optional<bool> enteringInteriorFromExterior; // Unused for exteriors.
 
-	// @todo: hack to make fast travel not crash when iterating stale distant objects in renderer
-	renderer.clearSky();
+		gameState.nextMap = std::make_unique<MapTransitionState>();
+		gameState.nextMap->init(std::move(mapState), newWorldMapLocationIDs, std::move(citizenGenInfo),
+			actualStartCoord, enteringInteriorFromExterior);
 
-	return true;
+		// @todo: hack to make fast travel not crash when iterating stale distant objects in renderer
+		renderer.clearSky();
+
+		return true;
+	};
+
+	return this->tryLoadMap("wilderness", MapDefinitionCache::makeWildKey(wildGenInfo, skyGenInfo),
+		std::move(genFunc), std::move(finishFunc), entityDefLibrary, binaryAssetLibrary, textureManager, renderer);
 }
 
 bool GameState::tryPopMap(const EntityDefinitionLibrary &entityDefLibrary,
 	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager, Renderer &renderer)
 {
+	DebugAssertMsg(this->getMapTransitionStage() == MapTransitionStage::None, "Already have a map to transition to.");
+
 	if (this->maps.size() == 0)
 	{
 		DebugLogError("No map available to pop.");
@@ -602,7 +724,7 @@ bool GameState::tryPopMap(const EntityDefinitionLibrary &entityDefLibrary,
 	}
 
 	MapState &activeMapState = this->maps.top();
-	const MapDefinition &activeMapDef = activeMapState.definition;
+	const MapDefinition &activeMapDef = *activeMapState.definition;
 	const MapType activeMapType = activeMapDef.getMapType();
 	MapInstance &activeMapInst = activeMapState.instance;
 	const int activeLevelIndex = activeMapInst.getActiveLevelIndex();
@@ -662,6 +784,22 @@ bool GameState::tryPopMap(const EntityDefinitionLibrary &entityDefLibrary,
 	return true;
 }
 
+GameState::MapTransitionStage GameState::getMapTransitionStage() const
+{
+	if (this->mapLoad != nullptr)
+	{
+		return MapTransitionStage::Generating;
+	}
+	else if (this->nextMap != nullptr)
+	{
+		return MapTransitionStage::Ready;
+	}
+	else
+	{
+		return MapTransitionStage::None;
+	}
+}
+
 Player &GameState::getPlayer()
 {
 	return this->player;
@@ -671,13 +809,13 @@ const MapDefinition &GameState::getActiveMapDef() const
 {
 	if (this->nextMap != nullptr)
 	{
-		return this->nextMap->mapState.definition;
+		return *this->nextMap->mapState.definition;
 	}
 	else
 	{
 		DebugAssert(!this->maps.empty());
 		const MapState &activeMapState = this->maps.top();
-		return activeMapState.definition;
+		return *activeMapState.definition;
 	}
 }
 
@@ -806,12 +944,12 @@ double GameState::getAmbientPercent() const
 	const MapDefinition *activeMapDef = nullptr;
 	if (this->nextMap != nullptr)
 	{
-		activeMapDef = &this->nextMap->mapState.definition;
+		activeMapDef = this->nextMap->mapState.definition.get();
 	}
 	else
 	{
 		DebugAssert(!this->maps.empty());
-		activeMapDef = &this->maps.top().definition;
+		activeMapDef = this->maps.top().definition.get();
 	}
 
 	DebugAssert(activeMapDef != nullptr);
@@ -982,7 +1120,7 @@ bool GameState::trySetLevelActive(LevelInstance &levelInst, const std::optional<
 		weatherRandom, textureManager);
 
 	DebugAssert(this->maps.size() > 0);
-	const MapDefinition &mapDefinition = this->maps.top().definition;
+	const MapDefinition &mapDefinition = *this->maps.top().definition;
 
 	if (!levelInst.trySetActive(this->weatherDef, this->nightLightsAreActive(), activeLevelIndex,
 		mapDefinition, citizenGenInfo, textureManager, renderer))
@@ -998,7 +1136,7 @@ bool GameState::trySetSkyActive(SkyInstance &skyInst, const std::optional<int> &
 	TextureManager &textureManager, Renderer &renderer)
 {
 	DebugAssert(this->maps.size() > 0);
-	const MapDefinition &mapDefinition = this->maps.top().definition;
+	const MapDefinition &mapDefinition = *this->maps.top().definition;
 
 	if (!skyInst.trySetActive(activeLevelIndex, mapDefinition, textureManager, renderer))
 	{
@@ -1009,6 +1147,272 @@ bool GameState::trySetSkyActive(SkyInstance &skyInst, const std::optional<int> &
 	return true;
 }
 
+bool GameState::tryLoadMap(std::string &&name, std::string &&cacheKey, MapDefinitionGenFunc &&genFunc,
+	MapTransitionFinishFunc &&finishFunc, const EntityDefinitionLibrary &entityDefLibrary,
+	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager, Renderer &renderer)
+{
+	DebugAssert(this->mapLoad == nullptr);
+
+	// Map generation is deterministic, so a previously generated map with the same inputs can be reused.
+	const auto startTime = std::chrono::high_resolution_clock::now();
+	double cachedGenTime;
+	std::shared_ptr<const MapDefinition> cachedMapDefinition = this->mapDefCache.tryGet(cacheKey, &cachedGenTime);
+	if (cachedMapDefinition != nullptr)
+	{
+		if (!finishFunc(*this, std::move(cachedMapDefinition), entityDefLibrary, textureManager, renderer))
+		{
+			return false;
+		}
+
+		DebugLog("Loaded " + name + " map from cache in " +
+			String::fixedPrecision(GetMillisecondsSince(startTime), 2) + "ms (saved " +
+			String::fixedPrecision(cachedGenTime, 2) + "ms of generation).");
+		return true;
+	}
+
+	// If this map is already being prefetched, wait on that instead of generating it again.
+	if ((this->mapPrefetch != nullptr) && (this->mapPrefetch->cacheKey == cacheKey))
+	{
+		std::unique_ptr<MapPrefetchState> mapPrefetch = std::move(this->mapPrefetch);
+		DebugLog("Loading " + name + " map from in-progress prefetch (started " +
+			String::fixedPrecision(GetMillisecondsSince(mapPrefetch->startTime), 2) + "ms ago).");
+
+		this->mapLoad = std::make_unique<MapLoadState>();
+		this->mapLoad->init(std::move(name), std::move(cacheKey), std::move(mapPrefetch->mapDefinitionFuture),
+			std::move(finishFunc));
+		return true;
+	}
+
+	genFunc = GameState::makeDiskCachedGenFunc(cacheKey, binaryAssetLibrary, std::move(genFunc));
+
+	if (this->maps.empty())
+	{
+		// Nothing to show while waiting (new game, etc.), so just generate it now.
+		auto mapDefinition = std::make_shared<MapDefinition>();
+		if (!genFunc(textureManager, mapDefinition.get()))
+		{
+			return false;
+		}
+
+		const double genTime = GetMillisecondsSince(startTime);
+		this->mapDefCache.add(std::move(cacheKey), std::shared_ptr<const MapDefinition>(mapDefinition), genTime);
+		if (!finishFunc(*this, std::move(mapDefinition), entityDefLibrary, textureManager, renderer))
+		{
+			return false;
+		}
+
+		DebugLog("Loaded " + name + " map in " + String::fixedPrecision(GetMillisecondsSince(startTime), 2) +
+			"ms (generation " + String::fixedPrecision(genTime, 2) + "ms).");
+		return true;
+	}
+
+	// Generate the map definition on a worker thread so the active map keeps updating.
+	std::future<std::unique_ptr<MapDefinition>> mapDefinitionFuture =
+		GameState::launchMapDefinitionGen(std::move(genFunc));
+
+	this->mapLoad = std::make_unique<MapLoadState>();
+	this->mapLoad->init(std::move(name), std::move(cacheKey), std::move(mapDefinitionFuture), std::move(finishFunc));
+	return true;
+}
+
+GameState::MapDefinitionGenFunc GameState::makeInteriorGenFunc(
+	const MapGeneration::InteriorGenInfo &interiorGenInfo, const CharacterClassLibrary &charClassLibrary,
+	const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary)
+{
+	return [interiorGenInfo, &charClassLibrary, &entityDefLibrary, &binaryAssetLibrary](
+		TextureManager &textureManager, MapDefinition *outMapDefinition)
+	{
+		if (!outMapDefinition->initInterior(interiorGenInfo, charClassLibrary, entityDefLibrary,
+			binaryAssetLibrary, textureManager))
+		{
+			DebugLogError("Couldn't init interior map from generation info.");
+			return false;
+		}
+
+		return true;
+	};
+}
+
+GameState::MapDefinitionGenFunc GameState::makeDiskCachedGenFunc(const std::string &cacheKey,
+	const BinaryAssetLibrary &binaryAssetLibrary, MapDefinitionGenFunc &&genFunc)
+{
+	// Files are only valid for the game data they were generated from.
+	const uint64_t assetHash = binaryAssetLibrary.getExeData().getSourceHash();
+	std::string filename = MapDefinitionFile::makeFilename(Platform::getCachePath(), cacheKey);
+
+	return [cacheKey, assetHash, filename = std::move(filename), genFunc = std::move(genFunc)](
+		TextureManager &textureManager, MapDefinition *outMapDefinition)
+	{
+		const auto startTime = std::chrono::high_resolution_clock::now();
+		if (MapDefinitionFile::tryRead(filename, cacheKey, assetHash, outMapDefinition))
+		{
+			DebugLog("Read map definition from \"" + filename + "\" in " +
+				String::fixedPrecision(GetMillisecondsSince(startTime), 2) + "ms (warm).");
+			return true;
+		}
+
+		if (!genFunc(textureManager, outMapDefinition))
+		{
+			return false;
+		}
+
+		const double genTime = GetMillisecondsSince(startTime);
+		const auto writeStartTime = std::chrono::high_resolution_clock::now();
+		if (!MapDefinitionFile::write(filename, cacheKey, assetHash, *outMapDefinition))
+		{
+			DebugLogWarning("Couldn't write map definition to \"" + filename + "\".");
+		}
+
+		DebugLog("Generated map definition in " + String::fixedPrecision(genTime, 2) + "ms (cold), wrote \"" +
+			filename + "\" in " + String::fixedPrecision(GetMillisecondsSince(writeStartTime), 2) + "ms.");
+		return true;
+	};
+}
+
+std::future<std::unique_ptr<MapDefinition>> GameState::launchMapDefinitionGen(MapDefinitionGenFunc &&genFunc)
+{
+	// The texture manager isn't thread-safe, but map definitions only keep texture asset references so the
+	// worker can use its own.
+	return std::async(std::launch::async, [genFunc = std::move(genFunc)]() -> std::unique_ptr<MapDefinition>
+	{
+		TextureManager workerTextureManager;
+		auto mapDefinition = std::make_unique<MapDefinition>();
+		if (!genFunc(workerTextureManager, mapDefinition.get()))
+		{
+			return nullptr;
+		}
+
+		return mapDefinition;
+	});
+}
+
+void GameState::requestInteriorPrefetch(const MapGeneration::InteriorGenInfo &interiorGenInfo,
+	const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
+	const BinaryAssetLibrary &binaryAssetLibrary)
+{
+	std::string cacheKey = MapDefinitionCache::makeInteriorKey(interiorGenInfo);
+	if (this->mapPrefetch != nullptr)
+	{
+		// Only one prefetch at a time. A different request is picked up again once the current one is done.
+		this->mapPrefetch->wanted = this->mapPrefetch->cacheKey == cacheKey;
+		return;
+	}
+
+	if (this->mapDefCache.contains(cacheKey))
+	{
+		return;
+	}
+
+	MapDefinitionGenFunc genFunc = GameState::makeInteriorGenFunc(interiorGenInfo, charClassLibrary,
+		entityDefLibrary, binaryAssetLibrary);
+	genFunc = GameState::makeDiskCachedGenFunc(cacheKey, binaryAssetLibrary, std::move(genFunc));
+
+	this->mapPrefetch = std::make_unique<MapPrefetchState>();
+	this->mapPrefetch->init(std::move(cacheKey), GameState::launchMapDefinitionGen(std::move(genFunc)));
+}
+
+void GameState::setNextMapMusic(const MusicDefinition *musicDef, const MusicDefinition *jingleMusicDef)
+{
+	DebugAssert(this->getMapTransitionStage() != MapTransitionStage::None);
+
+	MapTransitionMusic music;
+	music.musicDef = musicDef;
+	music.jingleMusicDef = jingleMusicDef;
+	this->nextMapMusic = music;
+}
+
+void GameState::cancelMapTransition()
+{
+	if (this->mapLoad != nullptr)
+	{
+		// The worker can't be interrupted, but its map definition is still worth keeping in the cache.
+		std::unique_ptr<MapLoadState> mapLoad = std::move(this->mapLoad);
+		std::unique_ptr<MapDefinition> mapDefinition = mapLoad->mapDefinitionFuture.get();
+		if (mapDefinition != nullptr)
+		{
+			const double genTime = GetMillisecondsSince(mapLoad->startTime);
+			this->mapDefCache.add(std::move(mapLoad->cacheKey), std::move(mapDefinition), genTime);
+		}
+
+		DebugLog("Cancelled " + mapLoad->name + " map transition.");
+	}
+
+	this->nextMap = nullptr;
+	this->nextMapMusic = std::nullopt;
+}
+
+void GameState::clearMapPrefetch()
+{
+	if (this->mapPrefetch != nullptr)
+	{
+		this->mapPrefetch->wanted = false;
+	}
+}
+
+void GameState::updateMapPrefetch()
+{
+	DebugAssert(this->mapPrefetch != nullptr);
+	std::future<std::unique_ptr<MapDefinition>> &mapDefinitionFuture = this->mapPrefetch->mapDefinitionFuture;
+	if (mapDefinitionFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		return;
+	}
+
+	std::unique_ptr<MapPrefetchState> mapPrefetch = std::move(this->mapPrefetch);
+	std::unique_ptr<MapDefinition> mapDefinition = mapDefinitionFuture.get();
+	const double genTime = GetMillisecondsSince(mapPrefetch->startTime);
+	if (mapDefinition == nullptr)
+	{
+		DebugLogWarning("Couldn't prefetch map definition \"" + mapPrefetch->cacheKey + "\".");
+		return;
+	}
+
+	if (!mapPrefetch->wanted)
+	{
+		// The player moved away before it was done. Don't let it evict anything from the cache.
+		DebugLog("Discarded stale map prefetch (" + String::fixedPrecision(genTime, 2) + "ms).");
+		return;
+	}
+
+	DebugLog("Prefetched map definition in " + String::fixedPrecision(genTime, 2) + "ms.");
+	this->mapDefCache.add(std::move(mapPrefetch->cacheKey), std::move(mapDefinition), genTime);
+}
+
+void GameState::updateMapLoad(const EntityDefinitionLibrary &entityDefLibrary, TextureManager &textureManager,
+	Renderer &renderer)
+{
+	DebugAssert(this->mapLoad != nullptr);
+	std::future<std::unique_ptr<MapDefinition>> &mapDefinitionFuture = this->mapLoad->mapDefinitionFuture;
+	if (mapDefinitionFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		return;
+	}
+
+	// Take ownership of the load so a failure doesn't leave it pending.
+	std::unique_ptr<MapLoadState> mapLoad = std::move(this->mapLoad);
+	std::shared_ptr<const MapDefinition> mapDefinition = mapDefinitionFuture.get();
+	const double genTime = GetMillisecondsSince(mapLoad->startTime);
+	if (mapDefinition == nullptr)
+	{
+		DebugLogError("Couldn't generate " + mapLoad->name + " map definition, staying in current map.");
+		this->nextMapMusic = std::nullopt;
+		return;
+	}
+
+	this->mapDefCache.add(std::move(mapLoad->cacheKey), std::shared_ptr<const MapDefinition>(mapDefinition), genTime);
+
+	const auto finishStartTime = std::chrono::high_resolution_clock::now();
+	if (!mapLoad->finishFunc(*this, std::move(mapDefinition), entityDefLibrary, textureManager, renderer))
+	{
+		DebugLogError("Couldn't finish " + mapLoad->name + " map transition, staying in current map.");
+		this->nextMapMusic = std::nullopt;
+		return;
+	}
+
+	DebugLog("Loaded " + mapLoad->name + " map in background (generation " + String::fixedPrecision(genTime, 2) +
+		"ms, finish " + String::fixedPrecision(GetMillisecondsSince(finishStartTime), 2) + "ms).");
+}
+
 bool GameState::tryApplyMapTransition(MapTransitionState &&transitionState,
 	const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
 	TextureManager &textureManager, Renderer &renderer)
@@ -1108,16 +1512,39 @@ void GameState::tick(double dt, Game &game)
 {
 	DebugAssert(dt >= 0.0);
 
+	// See if a map being generated in the background is done.
+	if (this->mapPrefetch != nullptr)
+	{
+		this->updateMapPrefetch();
+	}
+
+	if (this->mapLoad != nullptr)
+	{
+		this->updateMapLoad(game.getEntityDefinitionLibrary(), game.getTextureManager(), game.getRenderer());
+	}
+
 	// See if there is a pending map transition.
 	if (this->nextMap != nullptr)
 	{
+		const auto startTime = std::chrono::high_resolution_clock::now();
 		if (!this->tryApplyMapTransition(std::move(*this->nextMap), game.getEntityDefinitionLibrary(),
 			game.getBinaryAssetLibrary(), game.getTextureManager(), game.getRenderer()))
 		{
 			DebugLogError("Couldn't apply map transition.");
 		}
+		else
+		{
+			DebugLog("Applied map transition in " + String::fixedPrecision(GetMillisecondsSince(startTime), 2) + "ms.");
+
+			if (this->nextMapMusic.has_value())
+			{
+				AudioManager &audioManager = game.getAudioManager();
+				audioManager.setMusic(this->nextMapMusic->musicDef, this->nextMapMusic->jingleMusicDef);
+			}
+		}
 
 		this->nextMap = nullptr;
+		this->nextMapMusic = std::nullopt;
 	}
 
 	// Tick the game clock.
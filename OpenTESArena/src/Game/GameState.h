@@ -1,7 +1,9 @@
 #ifndef GAME_STATE_H
 #define GAME_STATE_H
 
+#include <chrono>
 #include <functional>
+#include <future>
 #include <memory>
 #include <stack>
 #include <string>
@@ -17,6 +19,7 @@
 #include "../Math/Random.h"
 #include "../Math/Vector2.h"
 #include "../World/MapDefinition.h"
+#include "../World/MapDefinitionCache.h"
 #include "../World/MapInstance.h"
 #include "../World/WeatherDefinition.h"
 #include "../World/WeatherInstance.h"
@@ -39,6 +42,7 @@ class INFFile;
 class LocationDefinition;
 class LocationInstance;
 class MIFFile;
+class MusicDefinition;
 class ProvinceDefinition;
 class Renderer;
 class TextAssetLibrary;
@@ -61,16 +65,24 @@ public:
 
 	// One weather for each of the 36 province quadrants (updated hourly).
 	using WeatherList = std::array<ArenaTypes::WeatherType, 36>;
+
+	// Progress of a requested map change (entering a city, interior, etc.).
+	enum class MapTransitionStage
+	{
+		None, // No map change requested.
+		Generating, // Map definition is being generated on a worker thread. The previous map is still active.
+		Ready // Map transition state is complete and will be applied on the next tick.
+	};
 private:
 	struct MapState
 	{
-		MapDefinition definition;
+		std::shared_ptr<const MapDefinition> definition; // Shared with the map definition cache.
 		MapInstance instance;
 		WeatherDefinition weatherDef; // Only ignored if a significant amount of time has passed upon returning to an exterior.
 		std::optional<CoordInt3> returnCoord; // Available when returning from inside an interior.
 		
-		void init(MapDefinition &&mapDefinition, MapInstance &&mapInstance, WeatherDefinition &&weatherDef,
-			const std::optional<CoordInt3> &returnCoord);
+		void init(std::shared_ptr<const MapDefinition> &&mapDefinition, MapInstance &&mapInstance,
+			WeatherDefinition &&weatherDef, const std::optional<CoordInt3> &returnCoord);
 	};
 
 	struct MapTransitionState
@@ -86,6 +98,47 @@ private:
 			const std::optional<bool> &enteringInteriorFromExterior);
 	};
 
+	// Generates a map definition. Since this may run on a worker thread, it must only use the given texture
+	// manager and read-only data.
+	using MapDefinitionGenFunc = std::function<bool(TextureManager &textureManager, MapDefinition *outMapDefinition)>;
+
+	// Makes the next map transition state from a generated map definition. Always runs on the main thread.
+	using MapTransitionFinishFunc = std::function<bool(GameState &gameState,
+		std::shared_ptr<const MapDefinition> &&mapDefinition, const EntityDefinitionLibrary &entityDefLibrary,
+		TextureManager &textureManager, Renderer &renderer)>;
+
+	// A map transition whose map definition is being generated on a worker thread.
+	struct MapLoadState
+	{
+		std::string name; // For logging.
+		std::string cacheKey;
+		std::future<std::unique_ptr<MapDefinition>> mapDefinitionFuture;
+		MapTransitionFinishFunc finishFunc;
+		std::chrono::high_resolution_clock::time_point startTime;
+
+		void init(std::string &&name, std::string &&cacheKey,
+			std::future<std::unique_ptr<MapDefinition>> &&mapDefinitionFuture, MapTransitionFinishFunc &&finishFunc);
+	};
+
+	// Music to start when the next map is swapped in.
+	struct MapTransitionMusic
+	{
+		const MusicDefinition *musicDef;
+		const MusicDefinition *jingleMusicDef;
+	};
+
+	// A map definition being speculatively generated on a worker thread because the player might enter it
+	// soon. It's only added to the map definition cache if it's still wanted when done.
+	struct MapPrefetchState
+	{
+		std::string cacheKey;
+		std::future<std::unique_ptr<MapDefinition>> mapDefinitionFuture;
+		std::chrono::high_resolution_clock::time_point startTime;
+		bool wanted;
+
+		void init(std::string &&cacheKey, std::future<std::unique_ptr<MapDefinition>> &&mapDefinitionFuture);
+	};
+
 	// Determines length of a real-time second in-game. For the original game, one real second is
 	// twenty in-game seconds.
 	static constexpr double GAME_TIME_SCALE = static_cast<double>(Clock::SECONDS_IN_A_DAY) / 4320.0;
@@ -100,6 +153,20 @@ private:
 	// not passed bad data during the frame the map change is requested. When this is non-null, as many things
 	// that depend on the current map should be handled via a special case by the game state that can be.
 	std::unique_ptr<MapTransitionState> nextMap;
+
+	// Non-null while the map definition for the next map is being generated in the background. The next map
+	// transition state is made from it once it's ready.
+	std::unique_ptr<MapLoadState> mapLoad;
+
+	// Set while a map change is in progress so the music doesn't change while the previous map is still shown.
+	std::optional<MapTransitionMusic> nextMapMusic;
+
+	// Recently generated map definitions, so revisited locations don't need generating again.
+	MapDefinitionCache mapDefCache;
+
+	// Non-null while a map the player is likely to enter next is being generated in the background. Only one
+	// prefetch runs at a time, and a finished one goes into the map definition cache.
+	std::unique_ptr<MapPrefetchState> mapPrefetch;
 	
 	// Player's current world map location data.
 	WorldMapDefinition worldMapDef;
@@ -150,6 +217,33 @@ private:
 	bool trySetSkyActive(SkyInstance &skyInst, const std::optional<int> &activeLevelIndex,
 		TextureManager &textureManager, Renderer &renderer);
 
+	// Generates a map definition (or reuses a cached one with the same key) and finishes the next map
+	// transition with it. Generation runs on a worker thread if there is an active map to keep showing in
+	// the meantime, otherwise it runs immediately.
+	bool tryLoadMap(std::string &&name, std::string &&cacheKey, MapDefinitionGenFunc &&genFunc,
+		MapTransitionFinishFunc &&finishFunc, const EntityDefinitionLibrary &entityDefLibrary,
+		const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager, Renderer &renderer);
+
+	// Wraps a generator so it reads the map definition from the on-disk cache if a file from a previous
+	// session matches, otherwise it generates the map definition and writes it there.
+	static MapDefinitionGenFunc makeDiskCachedGenFunc(const std::string &cacheKey,
+		const BinaryAssetLibrary &binaryAssetLibrary, MapDefinitionGenFunc &&genFunc);
+
+	// Makes a generator for the given interior. The generation info is copied so it can be used later.
+	static MapDefinitionGenFunc makeInteriorGenFunc(const MapGeneration::InteriorGenInfo &interiorGenInfo,
+		const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
+		const BinaryAssetLibrary &binaryAssetLibrary);
+
+	// Starts generating a map definition on a worker thread.
+	static std::future<std::unique_ptr<MapDefinition>> launchMapDefinitionGen(MapDefinitionGenFunc &&genFunc);
+
+	// Adds the prefetched map definition to the cache if it's done and still wanted.
+	void updateMapPrefetch();
+
+	// Finishes the in-progress map load if its map definition is done generating.
+	void updateMapLoad(const EntityDefinitionLibrary &entityDefLibrary, TextureManager &textureManager,
+		Renderer &renderer);
+
 	// Attempts to apply the map transition state saved from the previous frame to the current game state.
 	bool tryApplyMapTransition(MapTransitionState &&transitionState,
 		const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
@@ -203,6 +297,24 @@ public:
 	bool tryPopMap(const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
 		TextureManager &textureManager, Renderer &renderer);
 
+	// Gets how far along a requested map change is. While generating, the active map is still the previous one.
+	MapTransitionStage getMapTransitionStage() const;
+
+	// Sets the music to start once the requested map change is applied.
+	void setNextMapMusic(const MusicDefinition *musicDef, const MusicDefinition *jingleMusicDef = nullptr);
+
+	// Discards any requested map change, waiting for its map definition if it's still generating.
+	void cancelMapTransition();
+
+	// Speculatively generates the given interior in the background so entering it soon afterwards can skip
+	// generation. Replaces any previously requested prefetch.
+	void requestInteriorPrefetch(const MapGeneration::InteriorGenInfo &interiorGenInfo,
+		const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
+		const BinaryAssetLibrary &binaryAssetLibrary);
+
+	// Discards any requested prefetch (i.e., the player moved away from it).
+	void clearMapPrefetch();
+
 	Player &getPlayer();
 	const MapDefinition &getActiveMapDef() const; // @todo: this is bad practice since it becomes dangling when changing the active map.
 	MapInstance &getActiveMapInst(); // @todo: this is bad practice since it becomes dangling when changing the active map.
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <array>
 #include <cmath>
 
 #include "Physics.h"
@@ -11,6 +12,7 @@
 #include "../Math/MathUtils.h"
 #include "../Math/Matrix4.h"
 #include "../Math/Quad.h"
+#include "../Utilities/ThreadPool.h"
 #include "../World/ArenaVoxelUtils.h"
 #include "../World/ChunkUtils.h"
 #include "../World/LevelInstance.h"
@@ -23,31 +25,6 @@
 
 namespace Physics
 {
-	// Container of the voxels each entity is touching per chunk. Each chunk needs to look at adjacent chunk
-	// entities in case some of them overlap the chunk edge.
-	struct ChunkEntityMap
-	{
-		ChunkInt2 chunk;
-		std::unordered_map<VoxelInt3, std::vector<EntityVisibilityState3D>> mappings;
-
-		void init(const ChunkInt2 &chunk)
-		{
-			this->chunk = chunk;
-		}
-
-		void add(const VoxelInt3 &voxel, const EntityVisibilityState3D &visState)
-		{
-			auto iter = this->mappings.find(voxel);
-			if (iter == this->mappings.end())
-			{
-				iter = this->mappings.emplace(voxel, std::vector<EntityVisibilityState3D>()).first;
-			}
-
-			std::vector<EntityVisibilityState3D> &visStateList = iter->second;
-			visStateList.emplace_back(visState);
-		}
-	};
-
 	// Converts the normal to the associated voxel facing on success. Not all conversions
 	// exist, for example, diagonals have normals but do not have a voxel facing.
 	bool tryGetFacingFromNormal(const NewDouble3 &normal, VoxelFacing3D *outFacing)
@@ -89,156 +66,22 @@ namespace Physics
 		return success;
 	}
 
-	// Builds a set of voxels for a chunk that are at least partially touched by entities. A point of reference
-	// is needed for evaluating entity animations. Ignores entities behind the camera.
-	Physics::ChunkEntityMap makeChunkEntityMap(const ChunkInt2 &chunk, const CoordDouble3 &viewCoord,
-		double ceilingScale, const ChunkManager &chunkManager, const EntityManager &entityManager,
-		const EntityDefinitionLibrary &entityDefLibrary)
-	{
-		// Include entities within one chunk of the center chunk to get entities that are partially touching
-		// the center chunk.
-		constexpr int chunkDistance = 1;
-		ChunkInt2 minChunk, maxChunk;
-		ChunkUtils::getSurroundingChunks(chunk, chunkDistance, &minChunk, &maxChunk);
-
-		// Gather up entities in nearby chunks.
-		const int totalNearbyEntities = [&entityManager, &minChunk, &maxChunk]()
-		{
-			int count = 0;
-			for (WEInt z = minChunk.y; z <= maxChunk.y; z++)
-			{
-				for (SNInt x = minChunk.x; x <= maxChunk.x; x++)
-				{
-					count += entityManager.getCountInChunk(ChunkInt2(x, z));
-				}
-			}
-
-			return count;
-		}();
-
-		Buffer<const Entity*> entities(totalNearbyEntities);
-		entities.fill(nullptr);
-
-		int entityInsertIndex = 0;
-		auto addEntitiesFromChunk = [&entityManager, &entities, &entityInsertIndex](SNInt chunkX, WEInt chunkZ)
-		{
-			const Entity **entitiesPtr = entities.get() + entityInsertIndex;
-			const int size = entities.getCount() - entityInsertIndex;
-			const int writtenCount = entityManager.getEntitiesInChunk(ChunkInt2(chunkX, chunkZ), entitiesPtr, size);
-			DebugAssert(writtenCount <= size);
-			entityInsertIndex += writtenCount;
-		};
-
-		for (WEInt z = minChunk.y; z <= maxChunk.y; z++)
-		{
-			for (SNInt x = minChunk.x; x <= maxChunk.x; x++)
-			{
-				addEntitiesFromChunk(x, z);
-			}
-		}
-
-		ChunkEntityMap chunkEntityMap;
-		chunkEntityMap.init(chunk);
-
-		// Build mappings of voxels to entities.
-		for (int i = 0; i < entities.getCount(); i++)
-		{
-			const Entity *entityPtr = entities.get(i);
-			if (entityPtr == nullptr)
-			{
-				continue;
-			}
-
-			const Entity &entity = *entityPtr;
-
-			const CoordDouble2 viewCoordXZ(viewCoord.chunk, VoxelDouble2(viewCoord.point.x, viewCoord.point.z));
-			EntityVisibilityState3D visState;
-			entityManager.getEntityVisibilityState3D(entity, viewCoordXZ, ceilingScale, chunkManager,
-				entityDefLibrary, visState);
-
-			// Get the entity's view-independent bounding box to help determine which voxels they are in.
-			CoordDouble3 minCoord, maxCoord;
-			entity.getViewIndependentBBox3D(visState.flatPosition.point.y, entityManager, entityDefLibrary,
-				&minCoord, &maxCoord);
-
-			// Normalize Y values.
-			const VoxelDouble3 minPoint(minCoord.point.x, minCoord.point.y / ceilingScale, minCoord.point.z);
-			const VoxelDouble3 maxPoint(maxCoord.point.x, maxCoord.point.y / ceilingScale, maxCoord.point.z);
-
-			// Get min and max coordinates in chunk space and get the difference for iteration.
-			const CoordInt3 minVoxelCoord(minCoord.chunk, VoxelUtils::pointToVoxel(minPoint));
-			const CoordInt3 maxVoxelCoord(maxCoord.chunk, VoxelUtils::pointToVoxel(maxPoint));
-			const VoxelInt3 voxelCoordDiff = maxVoxelCoord - minVoxelCoord;
-
-			// Iterate over the voxels the entity's bounding box touches.
-			for (WEInt z = 0; z <= voxelCoordDiff.z; z++)
-			{
-				for (int y = 0; y <= voxelCoordDiff.y; y++)
-				{
-					for (SNInt x = 0; x <= voxelCoordDiff.x; x++)
-					{
-						const VoxelInt3 curVoxel(
-							minVoxelCoord.voxel.x + x,
-							minVoxelCoord.voxel.y + y,
-							minVoxelCoord.voxel.z + z);
-						const CoordInt3 curCoord = ChunkUtils::recalculateCoord(minVoxelCoord.chunk, curVoxel);
-
-						// If it's in the center chunk, add a mapping.
-						if (curCoord.chunk == chunk)
-						{
-							chunkEntityMap.add(curCoord.voxel, visState);
-						}
-					}
-				}
-			}
-		}
-
-		return chunkEntityMap;
-	}
-
-	// The given chunk coordinate is known to be loaded.
-	const ChunkEntityMap &getOrAddChunkEntityMap(const ChunkInt2 &chunk, const CoordDouble3 &viewCoord,
-		double ceilingScale, const ChunkManager &chunkManager, const EntityManager &entityManager,
-		const EntityDefinitionLibrary &entityDefLibrary, std::vector<ChunkEntityMap> &chunkEntityMaps)
-	{
-		for (const ChunkEntityMap &map : chunkEntityMaps)
-		{
-			if (map.chunk == chunk)
-			{
-				return map;
-			}
-		}
-
-		ChunkEntityMap newMap = Physics::makeChunkEntityMap(chunk, viewCoord, ceilingScale, chunkManager,
-			entityManager, entityDefLibrary);
-		chunkEntityMaps.emplace_back(std::move(newMap));
-		return chunkEntityMaps.back();
-	}
-
-	// Checks an initial voxel for ray hits and writes them into the output parameter.
+	// Checks an initial voxel in the ray's chunk for ray hits and writes them into the output parameter.
 	// Returns true if the ray hit something.
 	bool testInitialVoxelRay(const CoordDouble3 &rayCoord, const VoxelDouble3 &rayDirection, const VoxelInt3 &voxel,
-		VoxelFacing3D farFacing, const VoxelDouble3 &farPoint, double ceilingScale, const LevelInstance &levelInst,
+		VoxelFacing3D farFacing, const VoxelDouble3 &farPoint, double ceilingScale, const Chunk &chunk,
 		Physics::Hit &hit)
 	{
-		const ChunkManager &chunkManager = levelInst.getChunkManager();
-		const Chunk *chunk = chunkManager.tryGetChunk(rayCoord.chunk);
-		if (chunk == nullptr)
-		{
-			// Nothing to intersect with.
-			return false;
-		}
-
-		if (!chunk->isValidVoxel(voxel.x, voxel.y, voxel.z))
+		if (!chunk.isValidVoxel(voxel.x, voxel.y, voxel.z))
 		{
 			// Not in the chunk.
 			return false;
 		}
 
-		const Chunk::VoxelID voxelID = chunk->getVoxel(voxel.x, voxel.y, voxel.z);
+		const Chunk::VoxelID voxelID = chunk.getVoxel(voxel.x, voxel.y, voxel.z);
 
 		// Get the voxel definition associated with the voxel.
-		const VoxelDefinition &voxelDef = chunk->getVoxelDef(voxelID);
+		const VoxelDefinition &voxelDef = chunk.getVoxelDef(voxelID);
 		const ArenaTypes::VoxelType voxelType = voxelDef.type;
 
 		// Determine which type the voxel data is and run the associated calculation.
@@ -514,7 +357,7 @@ namespace Physics
 				// Get any non-default state for this chasm voxel.
 				const VoxelInstance::ChasmState *chasmState = [&voxel, &chunk]() -> const VoxelInstance::ChasmState*
 				{
-					const VoxelInstance *voxelInst = chunk->tryGetVoxelInst(voxel, VoxelInstance::Type::Chasm);
+					const VoxelInstance *voxelInst = chunk.tryGetVoxelInst(voxel, VoxelInstance::Type::Chasm);
 					if (voxelInst != nullptr)
 					{
 						return &voxelInst->getChasmState();
@@ -605,31 +448,23 @@ namespace Physics
 		}
 	}
 
-	// Checks a voxel for ray hits and writes them into the output parameter. The near point and far point
-	// are in the voxel coord's chunk, not necessarily the ray's. Returns true if the ray hit something.
+	// Checks a voxel in the given chunk for ray hits and writes them into the output parameter. The near point
+	// and far point are in the voxel coord's chunk, not necessarily the ray's. Returns true if the ray hit something.
 	bool testVoxelRay(const CoordDouble3 &rayCoord, const VoxelDouble3 &rayDirection, const CoordInt3 &voxelCoord,
 		VoxelFacing3D nearFacing, const CoordDouble3 &nearCoord, const CoordDouble3 &farCoord,
-		double ceilingScale, const LevelInstance &levelInst, Physics::Hit &hit)
+		double ceilingScale, const Chunk &chunk, Physics::Hit &hit)
 	{
-		const ChunkManager &chunkManager = levelInst.getChunkManager();
-		const Chunk *chunk = chunkManager.tryGetChunk(voxelCoord.chunk);
-		if (chunk == nullptr)
-		{
-			// Nothing to intersect with.
-			return false;
-		}
-
 		const VoxelInt3 &voxel = voxelCoord.voxel;
-		if (!chunk->isValidVoxel(voxel.x, voxel.y, voxel.z))
+		if (!chunk.isValidVoxel(voxel.x, voxel.y, voxel.z))
 		{
 			// Not in the chunk.
 			return false;
 		}
 
-		const Chunk::VoxelID voxelID = chunk->getVoxel(voxel.x, voxel.y, voxel.z);
+		const Chunk::VoxelID voxelID = chunk.getVoxel(voxel.x, voxel.y, voxel.z);
 
 		// Get the voxel definition associated with the voxel.
-		const VoxelDefinition &voxelDef = chunk->getVoxelDef(voxelID);
+		const VoxelDefinition &voxelDef = chunk.getVoxelDef(voxelID);
 		const ArenaTypes::VoxelType voxelType = voxelDef.type;
 
 		// Use absolute voxel when generating quads for ray intersection.
@@ -875,7 +710,7 @@ namespace Physics
 		}
 		else if (voxelType == ArenaTypes::VoxelType::Chasm)
 		{
-			const VoxelInstance *voxelInst = chunk->tryGetVoxelInst(voxel, VoxelInstance::Type::Chasm);
+			const VoxelInstance *voxelInst = chunk.tryGetVoxelInst(voxel, VoxelInstance::Type::Chasm);
 
 			// Intersect each face and find the closest one (if any).
 			int quadCount;
@@ -938,7 +773,7 @@ namespace Physics
 			// it's the calling code's responsibility to decide what to do based on the door's open
 			// state, but for now it will assume closed doors only, for simplicity.
 
-			const VoxelInstance *voxelInst = chunk->tryGetVoxelInst(voxel, VoxelInstance::Type::OpenDoor);
+			const VoxelInstance *voxelInst = chunk.tryGetVoxelInst(voxel, VoxelInstance::Type::OpenDoor);
 
 			// Intersect each face and find the closest one (if any).
 			int quadCount;
@@ -1004,40 +839,47 @@ namespace Physics
 	// Helper function for testing which entities in a voxel are intersected by a ray.
 	bool testEntitiesInVoxel(const CoordDouble3 &rayCoord, const VoxelDouble3 &rayDirection,
 		const VoxelDouble3 &flatForward, const VoxelDouble3 &flatRight, const VoxelDouble3 &flatUp,
-		const VoxelInt3 &voxel, const ChunkEntityMap &chunkEntityMap, bool pixelPerfect, const Palette &palette,
-		const EntityManager &entityManager, const EntityDefinitionLibrary &entityDefLibrary,
-		const Renderer &renderer, Physics::Hit &hit)
+		const CoordInt3 &voxelCoord, double ceilingScale, bool pixelPerfect,
+		const ChunkManager &chunkManager, const EntityManager &entityManager,
+		const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer, Physics::Hit &hit)
 	{
 		// Use a separate hit variable so we can determine whether an entity was closer.
 		Physics::Hit entityHit;
 		entityHit.setT(Hit::MAX_T);
 
-		const auto &entityMappings = chunkEntityMap.mappings;
-		const auto iter = entityMappings.find(voxel);
-		if (iter != entityMappings.end())
+		// Iterate over all the entities that cross this voxel and ray test them.
+		const CoordDouble2 rayCoordXZ(rayCoord.chunk, VoxelDouble2(rayCoord.point.x, rayCoord.point.z));
+		const BufferView<const EntityID> entityIDs = entityManager.getEntityIDsInVoxel(voxelCoord);
+		for (int i = 0; i < entityIDs.getCount(); i++)
 		{
-			// Iterate over all the entities that cross this voxel and ray test them.
-			const std::vector<EntityVisibilityState3D> &entityVisStateList = iter->second;
-			for (const EntityVisibilityState3D &visState : entityVisStateList)
+			const Entity *entityPtr = entityManager.getEntityHandle(entityIDs.get(i));
+			if (entityPtr == nullptr)
+			{
+				// Removed since the voxel look-up was built.
+				continue;
+			}
+
+			const Entity &entity = *entityPtr;
+			EntityVisibilityState3D visState;
+			entityManager.getEntityVisibilityState3D(entity, rayCoordXZ, ceilingScale, chunkManager,
+				entityDefLibrary, visState);
+
+			const EntityDefinition &entityDef = entityManager.getEntityDef(
+				entity.getDefinitionID(), entityDefLibrary);
+			const EntityAnimationDefinition::Keyframe &animKeyframe =
+				entityManager.getEntityAnimKeyframe(entity, visState, entityDefLibrary);
+
+			const double flatWidth = animKeyframe.getWidth();
+			const double flatHeight = animKeyframe.getHeight();
+
+			CoordDouble3 hitCoord;
+			if (renderer.getEntityRayIntersection(visState, entityDef, flatForward, flatRight, flatUp,
+				flatWidth, flatHeight, rayCoord, rayDirection, pixelPerfect, &hitCoord))
 			{
-				const Entity &entity = *visState.entity;
-				const EntityDefinition &entityDef = entityManager.getEntityDef(
-					entity.getDefinitionID(), entityDefLibrary);
-				const EntityAnimationDefinition::Keyframe &animKeyframe =
-					entityManager.getEntityAnimKeyframe(entity, visState, entityDefLibrary);
-
-				const double flatWidth = animKeyframe.getWidth();
-				const double flatHeight = animKeyframe.getHeight();
-
-				CoordDouble3 hitCoord;
-				if (renderer.getEntityRayIntersection(visState, entityDef, flatForward, flatRight, flatUp,
-					flatWidth, flatHeight, rayCoord, rayDirection, pixelPerfect, palette, &hitCoord))
+				const double distance = (hitCoord - rayCoord).length();
+				if (distance < entityHit.getT())
 				{
-					const double distance = (hitCoord - rayCoord).length();
-					if (distance < entityHit.getT())
-					{
-						entityHit.initEntity(distance, hitCoord, entity.getID(), entity.getEntityType());
-					}
+					entityHit.initEntity(distance, hitCoord, entity.getID(), entity.getEntityType());
 				}
 			}
 		}
@@ -1054,13 +896,86 @@ namespace Physics
 		}
 	}
 
+	// Chunk look-up for a ray cast. Batches lay the active chunks out in a grid over their bounding box so a ray
+	// entering another chunk doesn't have to search the chunk manager's list. A single ray searches the list
+	// instead, since building the grid costs more than it saves for one ray.
+	struct RayCastChunkGrid
+	{
+		const ChunkManager *chunkManager;
+		std::vector<const Chunk*> chunks; // Null where no chunk is active. Empty if not using a grid.
+		ChunkInt2 minChunk;
+		int width, depth;
+
+		void init(const ChunkManager &chunkManager)
+		{
+			this->chunkManager = &chunkManager;
+			this->chunks.clear();
+			this->minChunk = ChunkInt2();
+			this->width = 0;
+			this->depth = 0;
+		}
+
+		void initGrid(const ChunkManager &chunkManager)
+		{
+			this->chunkManager = &chunkManager;
+			this->chunks.clear();
+			this->minChunk = ChunkInt2();
+			this->width = 0;
+			this->depth = 0;
+
+			const int chunkCount = chunkManager.getChunkCount();
+			if (chunkCount == 0)
+			{
+				return;
+			}
+
+			this->minChunk = chunkManager.getChunk(0).getCoord();
+			ChunkInt2 maxChunk = this->minChunk;
+			for (int i = 1; i < chunkCount; i++)
+			{
+				const ChunkInt2 &chunkCoord = chunkManager.getChunk(i).getCoord();
+				this->minChunk = ChunkInt2(std::min(this->minChunk.x, chunkCoord.x), std::min(this->minChunk.y, chunkCoord.y));
+				maxChunk = ChunkInt2(std::max(maxChunk.x, chunkCoord.x), std::max(maxChunk.y, chunkCoord.y));
+			}
+
+			this->width = (maxChunk.x - this->minChunk.x) + 1;
+			this->depth = (maxChunk.y - this->minChunk.y) + 1;
+			this->chunks.resize(this->width * this->depth, nullptr);
+
+			for (int i = 0; i < chunkCount; i++)
+			{
+				const Chunk &chunk = chunkManager.getChunk(i);
+				const ChunkInt2 &chunkCoord = chunk.getCoord();
+				const int index = (chunkCoord.x - this->minChunk.x) + ((chunkCoord.y - this->minChunk.y) * this->width);
+				this->chunks[index] = &chunk;
+			}
+		}
+
+		const Chunk *tryGetChunk(const ChunkInt2 &coord) const
+		{
+			if (this->chunks.empty())
+			{
+				return this->chunkManager->tryGetChunk(coord);
+			}
+
+			const int x = coord.x - this->minChunk.x;
+			const int y = coord.y - this->minChunk.y;
+			if ((x < 0) || (x >= this->width) || (y < 0) || (y >= this->depth))
+			{
+				return nullptr;
+			}
+
+			return this->chunks[x + (y * this->width)];
+		}
+	};
+
 	// Internal ray casting loop for stepping through individual voxels and checking ray intersections
 	// against voxels and entities.
 	template <bool NonNegativeDirX, bool NonNegativeDirY, bool NonNegativeDirZ>
 	void rayCastInternal(const CoordDouble3 &rayCoord, const VoxelDouble3 &rayDirection,
-		const VoxelDouble3 &cameraForward, double ceilingScale, const LevelInstance &levelInst, bool pixelPerfect,
-		bool includeEntities, const Palette &palette, const EntityDefinitionLibrary &entityDefLibrary,
-		const Renderer &renderer, std::vector<ChunkEntityMap> &chunkEntityMaps, Physics::Hit &hit)
+		const VoxelDouble3 &cameraForward, double ceilingScale, const LevelInstance &levelInst,
+		const RayCastChunkGrid &chunkGrid, bool pixelPerfect, bool includeEntities,
+		const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer, Physics::Hit &hit)
 	{
 		const ChunkManager &chunkManager = levelInst.getChunkManager();
 		const EntityManager &entityManager = levelInst.getEntityManager();
@@ -1142,7 +1057,7 @@ namespace Physics
 
 		// Check whether the initial voxel is in a loaded chunk.
 		ChunkInt2 currentChunk = rayCoord.chunk;
-		const Chunk *currentChunkPtr = chunkManager.tryGetChunk(currentChunk);
+		const Chunk *currentChunkPtr = chunkGrid.tryGetChunk(currentChunk);
 
 		// The initial DDA step is a special case, so it's brought outside the DDA loop. This complicates things
 		// a little bit, but it's important enough that it should be kept.
@@ -1171,15 +1086,14 @@ namespace Physics
 
 			// Test the initial voxel's geometry for ray intersections.
 			bool success = Physics::testInitialVoxelRay(rayCoord, rayDirection, rayVoxel, facing,
-				initialFarPoint, ceilingScale, levelInst, hit);
+				initialFarPoint, ceilingScale, *currentChunkPtr, hit);
 
 			if (includeEntities)
 			{
 				// Test the initial voxel's entities for ray intersections.
-				const ChunkEntityMap &chunkEntityMap = Physics::getOrAddChunkEntityMap(currentChunk, rayCoord,
-					ceilingScale, chunkManager, entityManager, entityDefLibrary, chunkEntityMaps);
 				success |= Physics::testEntitiesInVoxel(rayCoord, rayDirection, flatForward, flatRight, flatUp,
-					rayVoxel, chunkEntityMap, pixelPerfect, palette, entityManager, entityDefLibrary, renderer, hit);
+					CoordInt3(currentChunk, rayVoxel), ceilingScale, pixelPerfect, chunkManager,
+					entityManager, entityDefLibrary, renderer, hit);
 			}
 
 			if (success)
@@ -1210,7 +1124,7 @@ namespace Physics
 		constexpr WEDouble halfOneMinusStepZReal = static_cast<WEDouble>((1 - stepZ) / 2);
 
 		// Lambda for stepping to the next voxel in the grid and updating various values.
-		auto doDDAStep = [&rayCoord, &rayDirection, &chunkManager, &deltaDist, stepX, stepY, stepZ, initialDeltaDistX,
+		auto doDDAStep = [&rayCoord, &rayDirection, &chunkGrid, &deltaDist, stepX, stepY, stepZ, initialDeltaDistX,
 			initialDeltaDistY, initialDeltaDistZ, &visibleWallFacings, &rayDistance, &facing, &currentChunk,
 			&currentChunkPtr, &currentVoxel, &deltaDistSumX, &deltaDistSumY, &deltaDistSumZ, &canDoYStep,
 			halfOneMinusStepXReal, halfOneMinusStepYReal, halfOneMinusStepZReal]()
@@ -1284,7 +1198,7 @@ namespace Physics
 
 			if (currentChunk != oldChunk)
 			{
-				currentChunkPtr = chunkManager.tryGetChunk(currentChunk);
+				currentChunkPtr = chunkGrid.tryGetChunk(currentChunk);
 			}
 		};
 
@@ -1298,6 +1212,7 @@ namespace Physics
 			// Store part of the current DDA state. The loop needs to do another DDA step to calculate
 			// the point on the far side of this voxel.
 			const CoordInt3 savedVoxelCoord(currentChunk, currentVoxel);
+			const Chunk &savedChunk = *currentChunkPtr;
 			const VoxelFacing3D savedFacing = facing;
 			const double savedDistance = rayDistance;
 
@@ -1313,16 +1228,14 @@ namespace Physics
 
 			// Test the current voxel's geometry for ray intersections.
 			bool success = Physics::testVoxelRay(rayCoord, rayDirection, savedVoxelCoord, savedFacing,
-				nearCoord, farCoord, ceilingScale, levelInst, hit);
+				nearCoord, farCoord, ceilingScale, savedChunk, hit);
 
 			if (includeEntities)
 			{
 				// Test the current voxel's entities for ray intersections.
-				const ChunkEntityMap &chunkEntityMap = Physics::getOrAddChunkEntityMap(savedVoxelCoord.chunk, rayCoord,
-					ceilingScale, chunkManager, entityManager, entityDefLibrary, chunkEntityMaps);
 				success |= Physics::testEntitiesInVoxel(rayCoord, rayDirection, flatForward, flatRight, flatUp,
-					savedVoxelCoord.voxel, chunkEntityMap, pixelPerfect, palette, entityManager, entityDefLibrary,
-					renderer, hit);
+					savedVoxelCoord, ceilingScale, pixelPerfect, chunkManager, entityManager,
+					entityDefLibrary, renderer, hit);
 			}
 
 			if (success)
@@ -1332,6 +1245,36 @@ namespace Physics
 			}
 		}
 	}
+
+	using RayCastInternalFunc = void(*)(const CoordDouble3&, const VoxelDouble3&, const VoxelDouble3&, double,
+		const LevelInstance&, const RayCastChunkGrid&, bool, bool, const EntityDefinitionLibrary&,
+		const Renderer&, Physics::Hit&);
+
+	// Ray direction sign combinations, one per ray casting loop.
+	constexpr int RAY_OCTANT_COUNT = 8;
+
+	// Ray casting loops indexed by ray direction octant. Using the direction signs as template parameters
+	// gives better code generation.
+	constexpr std::array<RayCastInternalFunc, RAY_OCTANT_COUNT> RayCastInternalFuncs =
+	{
+		Physics::rayCastInternal<false, false, false>,
+		Physics::rayCastInternal<true, false, false>,
+		Physics::rayCastInternal<false, true, false>,
+		Physics::rayCastInternal<true, true, false>,
+		Physics::rayCastInternal<false, false, true>,
+		Physics::rayCastInternal<true, false, true>,
+		Physics::rayCastInternal<false, true, true>,
+		Physics::rayCastInternal<true, true, true>
+	};
+
+	// Batches smaller than this per thread are cheaper to cast on the calling thread.
+	constexpr int MIN_RAYS_PER_THREAD = 256;
+
+	// Gets the index of the ray casting loop for a ray direction.
+	int getRayOctant(const VoxelDouble3 &rayDirection)
+	{
+		return (rayDirection.x >= 0.0 ? 1 : 0) | (rayDirection.y >= 0.0 ? 2 : 0) | (rayDirection.z >= 0.0 ? 4 : 0);
+	}
 }
 
 void Physics::Hit::initVoxel(double t, const CoordDouble3 &coord, uint16_t id, const VoxelInt3 &voxel,
@@ -1399,101 +1342,113 @@ void Physics::Hit::setT(double t)
 	this->t = t;
 }
 
-bool Physics::rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection, double ceilingScale,
-	const VoxelDouble3 &cameraForward, bool pixelPerfect, const Palette &palette, bool includeEntities,
-	const LevelInstance &levelInst, const EntityDefinitionLibrary &entityDefLibrary,
-	const Renderer &renderer, Physics::Hit &hit)
+int Physics::rayCastBatch(const BufferView<const CoordDouble3> &rayStarts,
+	const BufferView<const VoxelDouble3> &rayDirections, double ceilingScale, const VoxelDouble3 &cameraForward,
+	bool pixelPerfect, bool includeEntities, const LevelInstance &levelInst,
+	const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer, ThreadPool &threadPool,
+	BufferView<Physics::Hit> hits)
 {
-	// Set the hit distance to max. This will ensure that if we don't hit a voxel but do hit an
-	// entity, the distance can still be used.
-	hit.setT(Hit::MAX_T);
-
-	// Voxel->entity mappings for each chunk touched by the ray casting loop.
-	std::vector<ChunkEntityMap> chunkEntityMaps;
+	const int rayCount = rayStarts.getCount();
+	DebugAssert(rayDirections.getCount() == rayCount);
+	DebugAssert(hits.getCount() == rayCount);
+
+	// Chunk look-ups are shared by all rays. Entities come from the entity manager's per-frame voxel look-up,
+	// which is also shared.
+	RayCastChunkGrid chunkGrid;
+	chunkGrid.initGrid(levelInst.getChunkManager());
+
+	// Group rays by direction octant so each packet runs through the same ray casting loop back-to-back
+	// instead of branching per ray.
+	std::array<int, RAY_OCTANT_COUNT + 1> octantOffsets;
+	octantOffsets.fill(0);
+	for (int i = 0; i < rayCount; i++)
+	{
+		octantOffsets[Physics::getRayOctant(rayDirections.get(i)) + 1]++;
+	}
 
-	// Ray cast through the voxel grid, populating the output hit data. Use the ray direction booleans for
-	// better code generation (at the expense of having a pile of if/else branches here).
-	const bool nonNegativeDirX = rayDirection.x >= 0.0;
-	const bool nonNegativeDirY = rayDirection.y >= 0.0;
-	const bool nonNegativeDirZ = rayDirection.z >= 0.0;
+	for (int i = 1; i < static_cast<int>(octantOffsets.size()); i++)
+	{
+		octantOffsets[i] += octantOffsets[i - 1];
+	}
 
-	if (nonNegativeDirX)
+	std::vector<int> rayIndices(rayCount);
+	std::array<int, RAY_OCTANT_COUNT + 1> octantInsertIndices = octantOffsets;
+	for (int i = 0; i < rayCount; i++)
 	{
-		if (nonNegativeDirY)
-		{
-			if (nonNegativeDirZ)
-			{
-				Physics::rayCastInternal<true, true, true>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
-			}
-			else
-			{
-				Physics::rayCastInternal<true, true, false>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
-			}
-		}
-		else
-		{
-			if (nonNegativeDirZ)
-			{
-				Physics::rayCastInternal<true, false, true>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
-			}
-			else
-			{
-				Physics::rayCastInternal<true, false, false>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
-			}
-		}
+		const int octant = Physics::getRayOctant(rayDirections.get(i));
+		rayIndices[octantInsertIndices[octant]] = i;
+		octantInsertIndices[octant]++;
 	}
-	else
+
+	// Each thread takes a contiguous run of sorted rays so it stays within as few octants as possible.
+	auto castRayRange = [&](int threadIndex, int threadCount)
 	{
-		if (nonNegativeDirY)
+		const int startIndex = (rayCount * threadIndex) / threadCount;
+		const int endIndex = (rayCount * (threadIndex + 1)) / threadCount;
+
+		int octant = 0;
+		for (int i = startIndex; i < endIndex; i++)
 		{
-			if (nonNegativeDirZ)
+			while (i >= octantOffsets[octant + 1])
 			{
-				Physics::rayCastInternal<false, true, true>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
-			}
-			else
-			{
-				Physics::rayCastInternal<false, true, false>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
+				octant++;
 			}
+
+			const int rayIndex = rayIndices[i];
+			Physics::Hit &hit = hits.get(rayIndex);
+
+			// Set the hit distance to max. This will ensure that if we don't hit a voxel but do hit an
+			// entity, the distance can still be used.
+			hit.setT(Hit::MAX_T);
+
+			RayCastInternalFuncs[octant](rayStarts.get(rayIndex), rayDirections.get(rayIndex), cameraForward,
+				ceilingScale, levelInst, chunkGrid, pixelPerfect, includeEntities, entityDefLibrary,
+				renderer, hit);
 		}
-		else
+	};
+
+	// Only use worker threads when there are enough rays to be worth waking them.
+	const int rayThreadCount = std::max(rayCount / MIN_RAYS_PER_THREAD, 1);
+	threadPool.run(rayThreadCount, castRayRange);
+
+	int hitCount = 0;
+	for (int i = 0; i < rayCount; i++)
+	{
+		if (hits.get(i).getT() < Hit::MAX_T)
 		{
-			if (nonNegativeDirZ)
-			{
-				Physics::rayCastInternal<false, false, true>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
-			}
-			else
-			{
-				Physics::rayCastInternal<false, false, false>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
-			}
+			hitCount++;
 		}
 	}
 
+	return hitCount;
+}
+
+bool Physics::rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection, double ceilingScale,
+	const VoxelDouble3 &cameraForward, bool pixelPerfect, bool includeEntities,
+	const LevelInstance &levelInst, const EntityDefinitionLibrary &entityDefLibrary,
+	const Renderer &renderer, Physics::Hit &hit)
+{
+	// Set the hit distance to max. This will ensure that if we don't hit a voxel but do hit an
+	// entity, the distance can still be used.
+	hit.setT(Hit::MAX_T);
+
+	RayCastChunkGrid chunkGrid;
+	chunkGrid.init(levelInst.getChunkManager());
+
+	const int octant = Physics::getRayOctant(rayDirection);
+	RayCastInternalFuncs[octant](rayStart, rayDirection, cameraForward, ceilingScale, levelInst, chunkGrid,
+		pixelPerfect, includeEntities, entityDefLibrary, renderer, hit);
+
 	// Return whether the ray hit something.
 	return hit.getT() < Hit::MAX_T;
 }
 
 bool Physics::rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection,
-	const VoxelDouble3 &cameraForward, bool pixelPerfect, const Palette &palette, bool includeEntities,
+	const VoxelDouble3 &cameraForward, bool pixelPerfect, bool includeEntities,
 	const LevelInstance &levelInst, const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer,
 	Physics::Hit &hit)
 {
 	constexpr double ceilingScale = 1.0;
-	return Physics::rayCast(rayStart, rayDirection, ceilingScale, cameraForward, pixelPerfect, palette,
-		includeEntities, levelInst, entityDefLibrary, renderer, hit);
+	return Physics::rayCast(rayStart, rayDirection, ceilingScale, cameraForward, pixelPerfect, includeEntities,
+		levelInst, entityDefLibrary, renderer, hit);
 }
@@ -13,9 +13,12 @@
 #include "../World/VoxelDefinition.h"
 #include "../World/VoxelUtils.h"
 
+#include "components/utilities/BufferView.h"
+
 // Namespace for physics-related calculations like ray casting.
 
 class LevelInstance;
+class ThreadPool;
 
 namespace Physics
 {
@@ -67,12 +70,21 @@ namespace Physics
 	// Casts a ray through the world and writes any intersection data into the output parameter. Returns true
 	// if the ray hit something.
 	bool rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection, double ceilingScale,
-		const VoxelDouble3 &cameraForward, bool pixelPerfect, const Palette &palette, bool includeEntities,
+		const VoxelDouble3 &cameraForward, bool pixelPerfect, bool includeEntities,
 		const LevelInstance &levelInst, const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer,
 		Physics::Hit &hit);
 	bool rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection, const VoxelDouble3 &cameraForward,
-		bool pixelPerfect, const Palette &palette, bool includeEntities, const LevelInstance &levelInst,
+		bool pixelPerfect, bool includeEntities, const LevelInstance &levelInst,
 		const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer, Physics::Hit &hit);
+
+	// Casts each ray through the world and writes its intersection data into the hit at the same index.
+	// Chunk and entity look-ups are shared by all rays, and large batches are split between the thread pool's
+	// threads. Returns the number of rays that hit something.
+	int rayCastBatch(const BufferView<const CoordDouble3> &rayStarts,
+		const BufferView<const VoxelDouble3> &rayDirections, double ceilingScale, const VoxelDouble3 &cameraForward,
+		bool pixelPerfect, bool includeEntities, const LevelInstance &levelInst,
+		const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer, ThreadPool &threadPool,
+		BufferView<Physics::Hit> hits);
 };
 
 #endif
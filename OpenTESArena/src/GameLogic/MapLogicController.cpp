@@ -1,9 +1,12 @@
+#include <limits>
+
 #include "MapLogicController.h"
 #include "../Assets/ArenaPaletteName.h"
 #include "../Audio/MusicUtils.h"
 #include "../Entities/EntityType.h"
 #include "../Game/Game.h"
 #include "../Interface/WorldMapPanel.h"
+#include "../Math/Constants.h"
 #include "../UI/TextBox.h"
 #include "../World/MapType.h"
 #include "../World/SkyUtils.h"
@@ -31,14 +34,14 @@ void MapLogicController::handleNightLightChange(Game &game, bool active)
 
 		if (EntityUtils::isStreetlight(entityDef))
 		{
-			const std::string &newStateName = active ?
-				EntityAnimationUtils::STATE_ACTIVATED : EntityAnimationUtils::STATE_IDLE;
+			const EntityAnimationStateType newStateType = active ?
+				EntityAnimationStateType::Activated : EntityAnimationStateType::Idle;
 
 			const EntityAnimationDefinition &animDef = entityDef.getAnimDef();
-			const std::optional<int> newStateIndex = animDef.tryGetStateIndex(newStateName.c_str());
+			const std::optional<int> newStateIndex = animDef.tryGetStateIndex(newStateType);
 			if (!newStateIndex.has_value())
 			{
-				DebugLogWarning("Missing entity animation state \"" + newStateName + "\".");
+				DebugLogWarning(std::string("Missing streetlight ") + (active ? "activated" : "idle") + " animation state.");
 				continue;
 			}
 
@@ -121,6 +124,12 @@ void MapLogicController::handleMapTransition(Game &game, const Physics::Hit &hit
 	const CoordInt3 hitCoord(hit.getCoord().chunk, voxelHit.voxel);
 
 	auto &gameState = game.getGameState();
+	if (gameState.getMapTransitionStage() != GameState::MapTransitionStage::None)
+	{
+		// Already changing maps (i.e., the next map is still generating).
+		return;
+	}
+
 	auto &textureManager = game.getTextureManager();
 	auto &renderer = game.getRenderer();
 	const MapDefinition &activeMapDef = gameState.getActiveMapDef();
@@ -251,7 +260,7 @@ void MapLogicController::handleMapTransition(Game &game, const Physics::Hit &hit
 				return;
 			}
 
-			// Change to interior music.
+			// Change to interior music once the interior is swapped in.
 			const MusicLibrary &musicLibrary = game.getMusicLibrary();
 			const MusicDefinition::InteriorMusicDefinition::Type interiorMusicType =
 				MusicUtils::getInteriorMusicType(interiorGenInfo.getInteriorType());
@@ -268,8 +277,7 @@ void MapLogicController::handleMapTransition(Game &game, const Physics::Hit &hit
 				DebugLogWarning("Missing interior music.");
 			}
 
-			AudioManager &audioManager = game.getAudioManager();
-			audioManager.setMusic(musicDef);
+			gameState.setNextMapMusic(musicDef);
 		}
 		else if (transitionType == TransitionType::CityGate)
 		{
@@ -407,7 +415,7 @@ void MapLogicController::handleMapTransition(Game &game, const Physics::Hit &hit
 				return;
 			}
 
-			// Reset the current music (even if it's the same one).
+			// Reset the current music (even if it's the same one) once the new map is swapped in.
 			const MusicLibrary &musicLibrary = game.getMusicLibrary();
 			const MusicDefinition *musicDef = [&game, &gameState, &musicLibrary]()
 			{
@@ -453,8 +461,7 @@ void MapLogicController::handleMapTransition(Game &game, const Physics::Hit &hit
 				}
 			}
 
-			AudioManager &audioManager = game.getAudioManager();
-			audioManager.setMusic(musicDef, jingleMusicDef);
+			gameState.setNextMapMusic(musicDef, jingleMusicDef);
 		}
 		else
 		{
@@ -463,6 +470,83 @@ void MapLogicController::handleMapTransition(Game &game, const Physics::Hit &hit
 	}
 }
 
+void MapLogicController::handleMapPrefetch(Game &game, const CoordDouble3 &playerCoord)
+{
+	GameState &gameState = game.getGameState();
+	if (gameState.getMapTransitionStage() != GameState::MapTransitionStage::None)
+	{
+		return;
+	}
+
+	const MapDefinition &mapDef = gameState.getActiveMapDef();
+	if (mapDef.getMapType() == MapType::Interior)
+	{
+		// Level changes don't generate anything, and exiting returns to a map that's still loaded.
+		gameState.clearMapPrefetch();
+		return;
+	}
+
+	const MapInstance &mapInst = gameState.getActiveMapInst();
+	const LevelInstance &levelInst = mapInst.getActiveLevel();
+	const ChunkManager &chunkManager = levelInst.getChunkManager();
+	const double ceilingScale = levelInst.getCeilingScale();
+	const VoxelInt3 playerVoxel = VoxelUtils::pointToVoxel(playerCoord.point, ceilingScale);
+	const Double2 groundDirection = gameState.getPlayer().getGroundDirection();
+
+	// Only nearby entrances are worth generating early; anything farther can wait.
+	constexpr int searchDistance = 4;
+	constexpr int entranceY = 1; // Exterior entrances are on the ground floor.
+
+	const TransitionDefinition *bestTransitionDef = nullptr;
+	double bestScore = std::numeric_limits<double>::infinity();
+	for (int z = -searchDistance; z <= searchDistance; z++)
+	{
+		for (int x = -searchDistance; x <= searchDistance; x++)
+		{
+			const VoxelInt3 voxel(playerVoxel.x + x, entranceY, playerVoxel.z + z);
+			const CoordInt3 coord = ChunkUtils::recalculateCoord(playerCoord.chunk, voxel);
+			const Chunk *chunkPtr = chunkManager.tryGetChunk(coord.chunk);
+			if (chunkPtr == nullptr)
+			{
+				continue;
+			}
+
+			const TransitionDefinition *transitionDef = chunkPtr->tryGetTransition(coord.voxel);
+			if ((transitionDef == nullptr) || (transitionDef->getType() != TransitionType::EnterInterior))
+			{
+				continue;
+			}
+
+			const CoordDouble3 voxelCenter(coord.chunk, VoxelUtils::getVoxelCenter(coord.voxel, ceilingScale));
+			const VoxelDouble3 diff = voxelCenter - playerCoord;
+			const Double2 groundDiff(diff.x, diff.z);
+			const double distance = groundDiff.length();
+			const double facingPercent = (distance > Constants::Epsilon) ?
+				groundDirection.dot(groundDiff / distance) : 1.0;
+
+			// Entrances behind the player count as up to three times farther away.
+			const double score = distance * (2.0 - facingPercent);
+			if (score < bestScore)
+			{
+				bestTransitionDef = transitionDef;
+				bestScore = score;
+			}
+		}
+	}
+
+	if (bestTransitionDef != nullptr)
+	{
+		const TransitionDefinition::InteriorEntranceDef &interiorEntranceDef =
+			bestTransitionDef->getInteriorEntrance();
+		gameState.requestInteriorPrefetch(interiorEntranceDef.interiorGenInfo, game.getCharacterClassLibrary(),
+			game.getEntityDefinitionLibrary(), game.getBinaryAssetLibrary());
+	}
+	else
+	{
+		gameState.clearMapPrefetch();
+	}
+}
+
 void MapLogicController::handleLevelTransition(Game &game, const CoordInt3 &playerCoord,
 	const CoordInt3 &transitionCoord)
 {
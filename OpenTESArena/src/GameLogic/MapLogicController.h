@@ -20,6 +20,11 @@ namespace MapLogicController
 	// to another (i.e., from an interior to an exterior). This does not handle level transitions.
 	void handleMapTransition(Game &game, const Physics::Hit &hit, const TransitionDefinition &transitionDef);
 
+	// Looks for interior entrances near the player, weighted toward where they're facing, and asks the game
+	// state to generate the most likely one in the background so entering it is faster. Only needs calling
+	// when the player changes voxels.
+	void handleMapPrefetch(Game &game, const CoordDouble3 &playerCoord);
+
 	// Checks the given transition voxel to see if it's a level transition (i.e., level up/down), and changes
 	// the current level if it is.
 	void handleLevelTransition(Game &game, const CoordInt3 &playerCoord, const CoordInt3 &transitionCoord);
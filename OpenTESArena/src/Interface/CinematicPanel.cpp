@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <chrono>
+
 #include "CinematicPanel.h"
 #include "../Game/Game.h"
 #include "../Input/InputActionMapName.h"
@@ -7,6 +10,8 @@
 #include "../Rendering/Renderer.h"
 #include "../UI/Texture.h"
 
+#include "components/utilities/String.h"
+
 CinematicPanel::CinematicPanel(Game &game)
 	: Panel(game) { }
 
@@ -35,37 +40,66 @@ bool CinematicPanel::init(const std::string &paletteName, const std::string &seq
 		}
 	});
 
-	auto &textureManager = game.getTextureManager();
-	const std::optional<TextureFileMetadataID> metadataID = textureManager.tryGetMetadataID(sequenceName.c_str());
-	if (!metadataID.has_value())
+	// Measure how long it takes to get the first frame on screen.
+	const auto startTime = std::chrono::high_resolution_clock::now();
+
+	if (!this->frameStream.init(sequenceName.c_str()))
 	{
-		DebugLogError("Couldn't get texture file metadata for \"" + sequenceName + "\".");
+		DebugLogError("Couldn't init frame stream for sequence \"" + sequenceName + "\".");
 		return false;
 	}
 
-	const TextureFileMetadata &textureFileMetadata = textureManager.getMetadataHandle(*metadataID);
-	const TextureAssetReference paletteTextureAssetRef = TextureAssetReference(std::string(paletteName));
-
-	auto &renderer = game.getRenderer();
-	this->textureRefs.init(textureFileMetadata.getTextureCount());
-	for (int i = 0; i < textureFileMetadata.getTextureCount(); i++)
+	if (this->frameStream.getFrameCount() == 0)
 	{
-		const TextureAssetReference textureAssetRef = TextureAssetReference(std::string(sequenceName), i);
+		DebugLogError("No frames in sequence \"" + sequenceName + "\".");
+		return false;
+	}
 
-		UiTextureID textureID;
-		if (!TextureUtils::tryAllocUiTexture(textureAssetRef, paletteTextureAssetRef, textureManager, renderer, &textureID))
+	// Frames use their own palette unless a different palette file is given.
+	auto &textureManager = game.getTextureManager();
+	if (!String::caseInsensitiveEquals(paletteName, sequenceName))
+	{
+		const std::optional<PaletteID> paletteID = textureManager.tryGetPaletteID(paletteName.c_str());
+		if (!paletteID.has_value())
 		{
-			DebugLogError("Couldn't create UI texture for sequence \"" + sequenceName + "\" frame " + std::to_string(i) + ".");
+			DebugLogError("Couldn't get palette ID for \"" + paletteName + "\".");
 			return false;
 		}
 
-		this->textureRefs.set(i, ScopedUiTextureRef(textureID, renderer));
+		this->paletteOverride = textureManager.getPaletteHandle(*paletteID);
 	}
 
+	auto &renderer = game.getRenderer();
+	UiTextureID textureID;
+	if (!renderer.tryCreateUiTexture(this->frameStream.getWidth(), this->frameStream.getHeight(), &textureID))
+	{
+		DebugLogError("Couldn't create UI texture for sequence \"" + sequenceName + "\".");
+		return false;
+	}
+
+	this->textureRef.init(textureID, renderer);
+	this->imageIndex = 0;
+	this->textureImageIndex = -1;
+	if (!this->tryUpdateTexture())
+	{
+		DebugLogError("Couldn't show first frame of sequence \"" + sequenceName + "\".");
+		return false;
+	}
+
+	const auto endTime = std::chrono::high_resolution_clock::now();
+	const double firstFrameMilliseconds = static_cast<double>((endTime - startTime).count()) /
+		static_cast<double>(std::nano::den) * 1000.0;
+	const int frameByteCount = this->frameStream.getWidth() * this->frameStream.getHeight();
+	const int allFramesByteCount = this->frameStream.getFrameCount() * frameByteCount;
+	DebugLog("Streaming \"" + sequenceName + "\": first frame in " +
+		String::fixedPrecision(firstFrameMilliseconds, 2) + "ms, " +
+		std::to_string(this->frameStream.getBufferedByteCount() / 1024) + "KB buffered (" +
+		std::to_string(allFramesByteCount / 1024) + "KB for all " +
+		std::to_string(this->frameStream.getFrameCount()) + " frames).");
+
 	UiDrawCall::TextureFunc textureFunc = [this]()
 	{
-		const ScopedUiTextureRef &textureRef = this->textureRefs.get(this->imageIndex);
-		return textureRef.get();
+		return this->textureRef.get();
 	};
 
 	this->addDrawCall(
@@ -76,7 +110,44 @@ bool CinematicPanel::init(const std::string &paletteName, const std::string &seq
 	
 	this->secondsPerImage = secondsPerImage;
 	this->currentSeconds = 0.0;
-	this->imageIndex = 0;
+	return true;
+}
+
+bool CinematicPanel::tryUpdateTexture()
+{
+	if (this->imageIndex == this->textureImageIndex)
+	{
+		return true;
+	}
+
+	const uint8_t *srcPixels;
+	const Palette *palette;
+	if (!this->frameStream.tryAcquireFrame(this->imageIndex, &srcPixels, &palette))
+	{
+		return false;
+	}
+
+	if (this->paletteOverride.has_value())
+	{
+		palette = &(*this->paletteOverride);
+	}
+
+	uint32_t *dstTexels = this->textureRef.lockTexels();
+	if (dstTexels == nullptr)
+	{
+		DebugLogError("Couldn't lock cinematic texels for writing.");
+		return false;
+	}
+
+	const int pixelCount = this->frameStream.getWidth() * this->frameStream.getHeight();
+	std::transform(srcPixels, srcPixels + pixelCount, dstTexels,
+		[palette](const uint8_t pixel)
+	{
+		return (*palette)[pixel].toARGB();
+	});
+
+	this->textureRef.unlockTexels();
+	this->textureImageIndex = this->imageIndex;
 	return true;
 }
 
@@ -91,10 +162,15 @@ void CinematicPanel::tick(double dt)
 	}
 
 	// If at the end, then prepare for the next panel.
-	const int textureCount = this->textureRefs.getCount();
-	if (this->imageIndex >= textureCount)
+	const int frameCount = this->frameStream.getFrameCount();
+	if (this->imageIndex >= frameCount)
 	{
-		this->imageIndex = textureCount - 1;
+		this->imageIndex = frameCount - 1;
 		this->skipButton.click(this->getGame());
 	}
+
+	if (!this->tryUpdateTexture())
+	{
+		DebugLogError("Couldn't update cinematic frame " + std::to_string(this->imageIndex) + ".");
+	}
 }
@@ -2,15 +2,17 @@
 #define CINEMATIC_PANEL_H
 
 #include <functional>
+#include <optional>
 #include <string>
 
 #include "Panel.h"
 #include "../Assets/TextureAssetReference.h"
-
-#include "components/utilities/Buffer.h"
+#include "../Media/FLCFrameStream.h"
+#include "../Media/Palette.h"
 
 // Designed for sets of images (i.e., videos) that play one after another and
-// eventually lead to another panel. Skipping is available, too.
+// eventually lead to another panel. Skipping is available, too. Frames are streamed
+// from the .FLC/.CEL file into a single texture instead of all being loaded up front.
 
 class Game;
 class Renderer;
@@ -21,9 +23,14 @@ public:
 	using OnFinishedFunction = std::function<void(Game&)>;
 private:
 	Button<Game&> skipButton;
-	Buffer<ScopedUiTextureRef> textureRefs;
+	FLCFrameStream frameStream;
+	ScopedUiTextureRef textureRef;
+	std::optional<Palette> paletteOverride; // Used instead of each frame's own palette if set.
 	double secondsPerImage, currentSeconds;
-	int imageIndex;
+	int imageIndex, textureImageIndex;
+
+	// Writes the current image's frame into the texture if it isn't there already.
+	bool tryUpdateTexture();
 public:
 	CinematicPanel(Game &game);
 	~CinematicPanel() override = default;
@@ -996,8 +996,8 @@ void GameWorldPanel::tick(double dt)
 		game.getOptions().getMisc_ChunkDistance(), entityGenInfo, citizenGenInfo, entityDefLibrary,
 		game.getBinaryAssetLibrary(), textureManager, game.getAudioManager());
 
-	// See if the player changed voxels in the XZ plane. If so, trigger text and sound events,
-	// and handle any level transition.
+	// See if the player changed voxels in the XZ plane. If so, look for an interior they're likely to
+	// enter next, trigger text and sound events, and handle any level transition.
 	const LevelInstance &levelInst = mapInst.getActiveLevel();
 	const double ceilingScale = levelInst.getCeilingScale();
 	const CoordInt3 oldPlayerVoxelCoord(
@@ -1006,6 +1006,7 @@ void GameWorldPanel::tick(double dt)
 		newPlayerCoord.chunk, VoxelUtils::pointToVoxel(newPlayerCoord.point, ceilingScale));
 	if (newPlayerVoxelCoord != oldPlayerVoxelCoord)
 	{
+		MapLogicController::handleMapPrefetch(game, newPlayerCoord);
 		MapLogicController::handleTriggers(game, newPlayerVoxelCoord, this->triggerText);
 
 		if (mapType == MapType::Interior)
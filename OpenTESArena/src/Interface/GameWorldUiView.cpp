@@ -528,16 +528,6 @@ void GameWorldUiView::DEBUG_ColorRaycastPixel(Game &game)
 	const EntityManager &entityManager = levelInst.getEntityManager();
 	const double ceilingScale = levelInst.getCeilingScale();
 
-	const std::string &paletteFilename = ArenaPaletteName::Default;
-	auto &textureManager = game.getTextureManager();
-	const std::optional<PaletteID> paletteID = textureManager.tryGetPaletteID(paletteFilename.c_str());
-	if (!paletteID.has_value())
-	{
-		DebugCrash("Couldn't get palette ID for \"" + paletteFilename + "\".");
-	}
-
-	const Palette &palette = textureManager.getPaletteHandle(*paletteID);
-
 	for (int y = 0; y < windowDims.y; y += yOffset)
 	{
 		for (int x = 0; x < windowDims.x; x += xOffset)
@@ -549,7 +539,7 @@ void GameWorldUiView::DEBUG_ColorRaycastPixel(Game &game)
 			constexpr bool includeEntities = false;
 			Physics::Hit hit;
 			const bool success = Physics::rayCast(rayStart, rayDirection, ceilingScale, cameraDirection,
-				pixelPerfect, palette, includeEntities, levelInst, game.getEntityDefinitionLibrary(),
+				pixelPerfect, includeEntities, levelInst, game.getEntityDefinitionLibrary(),
 				renderer, hit);
 
 			if (success)
@@ -607,20 +597,10 @@ void GameWorldUiView::DEBUG_PhysicsRaycast(Game &game)
 	const EntityManager &entityManager = levelInst.getEntityManager();
 	const double ceilingScale = levelInst.getCeilingScale();
 
-	const std::string &paletteFilename = ArenaPaletteName::Default;
-	auto &textureManager = game.getTextureManager();
-	const std::optional<PaletteID> paletteID = textureManager.tryGetPaletteID(paletteFilename.c_str());
-	if (!paletteID.has_value())
-	{
-		DebugCrash("Couldn't get palette ID for \"" + paletteFilename + "\".");
-	}
-
-	const Palette &palette = textureManager.getPaletteHandle(*paletteID);
-
 	constexpr bool includeEntities = true;
 	Physics::Hit hit;
 	const bool success = Physics::rayCast(rayStart, rayDirection, ceilingScale, cameraDirection,
-		options.getInput_PixelPerfectSelection(), palette, includeEntities, levelInst,
+		options.getInput_PixelPerfectSelection(), includeEntities, levelInst,
 		game.getEntityDefinitionLibrary(), renderer, hit);
 
 	std::string text;
@@ -29,6 +29,9 @@ void FastTravelUiController::onAnimationFinished(Game &game, int targetProvinceI
 	auto &gameState = game.getGameState();
 	gameState.setTravelData(nullptr);
 
+	// The world map can be opened while the next map is still generating. Fast travel replaces that map change.
+	gameState.cancelMapTransition();
+
 	// Handle fast travel behavior and decide which panel to switch to.
 	const auto &binaryAssetLibrary = game.getBinaryAssetLibrary();
 	const auto &exeData = binaryAssetLibrary.getExeData();
@@ -167,8 +170,7 @@ void FastTravelUiController::onAnimationFinished(Game &game, int targetProvinceI
 			DebugLogWarning("Missing jingle music.");
 		}
 
-		AudioManager &audioManager = game.getAudioManager();
-		audioManager.setMusic(musicDef, jingleMusicDef);
+		gameState.setNextMapMusic(musicDef, jingleMusicDef);
 
 		game.setPanel<GameWorldPanel>();
 
@@ -215,8 +217,7 @@ void FastTravelUiController::onAnimationFinished(Game &game, int targetProvinceI
 			DebugLogWarning("Missing dungeon music.");
 		}
 
-		AudioManager &audioManager = game.getAudioManager();
-		audioManager.setMusic(musicDef);
+		gameState.setNextMapMusic(musicDef);
 
 		game.setPanel<GameWorldPanel>();
 	}
@@ -264,8 +265,7 @@ void FastTravelUiController::onAnimationFinished(Game &game, int targetProvinceI
 				DebugLogWarning("Missing dungeon music.");
 			}
 
-			AudioManager &audioManager = game.getAudioManager();
-			audioManager.setMusic(musicDef);
+			gameState.setNextMapMusic(musicDef);
 
 			game.setPanel<GameWorldPanel>();
 		}
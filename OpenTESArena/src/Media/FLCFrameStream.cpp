@@ -0,0 +1,159 @@
+#include <algorithm>
+
+#include "FLCFrameStream.h"
+
+#include "components/debug/Debug.h"
+
+FLCFrameStream::FLCFrameStream()
+{
+	this->decodedCount = 0;
+	this->acquiredIndex = 0;
+	this->stopRequested = false;
+	this->failed = false;
+}
+
+FLCFrameStream::~FLCFrameStream()
+{
+	this->stop();
+}
+
+bool FLCFrameStream::init(const char *filename, int lookAheadCount)
+{
+	DebugAssert(lookAheadCount > 0);
+	DebugAssert(!this->thread.joinable());
+
+	if (!this->decoder.init(filename))
+	{
+		DebugLogError("Couldn't init .FLC/.CEL decoder for \"" + std::string(filename) + "\".");
+		return false;
+	}
+
+	const int frameSlotCount = std::min(lookAheadCount, std::max(this->decoder.getFrameCount(), 1));
+	this->frames.resize(frameSlotCount);
+	for (Frame &frame : this->frames)
+	{
+		frame.pixels.init(this->decoder.getWidth(), this->decoder.getHeight());
+	}
+
+	this->thread = std::thread(&FLCFrameStream::decodeLoop, this);
+	return true;
+}
+
+void FLCFrameStream::decodeLoop()
+{
+	const int frameCount = this->decoder.getFrameCount();
+	const int frameSlotCount = static_cast<int>(this->frames.size());
+	const int pixelCount = this->decoder.getWidth() * this->decoder.getHeight();
+
+	for (int i = 0; i < frameCount; i++)
+	{
+		// Wait for the consumer to move past the frame in this slot.
+		{
+			std::unique_lock<std::mutex> lock(this->mutex);
+			this->condition.wait(lock, [this, i, frameSlotCount]()
+			{
+				return this->stopRequested || (i < (this->acquiredIndex + frameSlotCount));
+			});
+
+			if (this->stopRequested)
+			{
+				return;
+			}
+		}
+
+		// Delta frames build on the previous one, so every frame is decoded even if playback skips it.
+		const bool success = this->decoder.readNextFrame();
+		if (success)
+		{
+			Frame &frame = this->frames[i % frameSlotCount];
+			const uint8_t *srcPixels = this->decoder.getPixels();
+			std::copy(srcPixels, srcPixels + pixelCount, frame.pixels.get());
+			frame.palette = this->decoder.getPalette();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			if (success)
+			{
+				this->decodedCount = i + 1;
+			}
+			else
+			{
+				this->failed = true;
+			}
+		}
+
+		this->condition.notify_all();
+
+		if (!success)
+		{
+			return;
+		}
+	}
+}
+
+void FLCFrameStream::stop()
+{
+	if (this->thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->stopRequested = true;
+		}
+
+		this->condition.notify_all();
+		this->thread.join();
+	}
+}
+
+int FLCFrameStream::getFrameCount() const
+{
+	return this->decoder.getFrameCount();
+}
+
+double FLCFrameStream::getFrameDuration() const
+{
+	return this->decoder.getFrameDuration();
+}
+
+int FLCFrameStream::getWidth() const
+{
+	return this->decoder.getWidth();
+}
+
+int FLCFrameStream::getHeight() const
+{
+	return this->decoder.getHeight();
+}
+
+int FLCFrameStream::getBufferedByteCount() const
+{
+	const int frameByteCount = (this->decoder.getWidth() * this->decoder.getHeight()) + sizeof(Palette);
+	return static_cast<int>(this->frames.size()) * frameByteCount;
+}
+
+bool FLCFrameStream::tryAcquireFrame(int index, const uint8_t **outPixels, const Palette **outPalette)
+{
+	DebugAssert(index >= 0);
+	DebugAssert(index < this->getFrameCount());
+
+	std::unique_lock<std::mutex> lock(this->mutex);
+	DebugAssert(index >= this->acquiredIndex);
+	this->acquiredIndex = index;
+	this->condition.notify_all();
+	this->condition.wait(lock, [this, index]()
+	{
+		return (index < this->decodedCount) || this->failed;
+	});
+
+	if (index >= this->decodedCount)
+	{
+		DebugLogError("Couldn't decode .FLC/.CEL frame " + std::to_string(index) + ".");
+		return false;
+	}
+
+	const Frame &frame = this->frames[index % this->frames.size()];
+	*outPixels = frame.pixels.get();
+	*outPalette = &frame.palette;
+	return true;
+}
@@ -0,0 +1,64 @@
+#ifndef FLC_FRAME_STREAM_H
+#define FLC_FRAME_STREAM_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Palette.h"
+#include "../Assets/FLCDecoder.h"
+
+#include "components/utilities/Buffer2D.h"
+
+// Plays back an .FLC/.CEL file by decoding frames on a worker thread into a small ring of look-ahead
+// frames, so a long cinematic only holds a few frames in memory and the first one is ready right away.
+
+class FLCFrameStream
+{
+public:
+	static constexpr int DEFAULT_LOOK_AHEAD_COUNT = 4;
+private:
+	struct Frame
+	{
+		Buffer2D<uint8_t> pixels;
+		Palette palette;
+	};
+
+	FLCDecoder decoder; // Only used by the worker thread after init.
+	std::vector<Frame> frames; // Ring buffer; frame N is in slot N % size.
+	int decodedCount; // Number of frames the worker has finished.
+	int acquiredIndex; // Most recent frame handed to the consumer. Older frames can be overwritten.
+	bool stopRequested;
+	bool failed;
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::thread thread;
+
+	void decodeLoop();
+	void stop();
+public:
+	FLCFrameStream();
+	FLCFrameStream(const FLCFrameStream&) = delete;
+	~FLCFrameStream();
+
+	FLCFrameStream &operator=(const FLCFrameStream&) = delete;
+
+	// Reads the file's header and starts decoding frames in the background.
+	bool init(const char *filename, int lookAheadCount = DEFAULT_LOOK_AHEAD_COUNT);
+
+	int getFrameCount() const;
+	double getFrameDuration() const;
+	int getWidth() const;
+	int getHeight() const;
+
+	// Gets the number of bytes held by decoded frames.
+	int getBufferedByteCount() const;
+
+	// Waits until the given frame is decoded. Frames must be acquired in non-decreasing order. The returned
+	// pointers stay valid until the next acquire.
+	bool tryAcquireFrame(int index, const uint8_t **outPixels, const Palette **outPalette);
+};
+
+#endif
@@ -7,6 +7,7 @@
 #include "../Assets/COLFile.h"
 #include "../Assets/Compression.h"
 #include "../Assets/DFAFile.h"
+#include "../Assets/FLCDecoder.h"
 #include "../Assets/FLCFile.h"
 #include "../Assets/IMGFile.h"
 #include "../Assets/LGTFile.h"
@@ -238,7 +239,9 @@ bool TextureManager::tryLoadTextureData(const char *filename, Buffer<TextureBuil
 	else if (TextureManager::matchesExtension(filename, ArenaAssetUtils::EXTENSION_FLC) ||
 		TextureManager::matchesExtension(filename, ArenaAssetUtils::EXTENSION_CEL))
 	{
-		FLCFile flc;
+		// Frames are decoded one at a time straight into texture builders, and not at all when only the
+		// metadata is wanted.
+		FLCDecoder flc;
 		if (!flc.init(filename))
 		{
 			DebugLogWarning("Couldn't init .FLC/.CEL file \"" + std::string(filename) + "\".");
@@ -250,7 +253,13 @@ bool TextureManager::tryLoadTextureData(const char *filename, Buffer<TextureBuil
 			outTextures->init(flc.getFrameCount());
 			for (int i = 0; i < flc.getFrameCount(); i++)
 			{
-				TextureBuilder textureBuilder = makePaletted(flc.getWidth(), flc.getHeight(), flc.getPixels(i));
+				if (!flc.readNextFrame())
+				{
+					DebugLogWarning("Couldn't decode frame " + std::to_string(i) + " of \"" + std::string(filename) + "\".");
+					return false;
+				}
+
+				TextureBuilder textureBuilder = makePaletted(flc.getWidth(), flc.getHeight(), flc.getPixels());
 				outTextures->set(i, std::move(textureBuilder));
 			}
 		}
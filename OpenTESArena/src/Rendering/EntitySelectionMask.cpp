@@ -0,0 +1,67 @@
+#include "EntitySelectionMask.h"
+
+#include "components/debug/Debug.h"
+
+namespace
+{
+	constexpr int BITS_PER_WORD = 64;
+}
+
+EntitySelectionMask::EntitySelectionMask()
+{
+	this->width = 0;
+	this->height = 0;
+	this->wordsPerRow = 0;
+}
+
+void EntitySelectionMask::init(int width, int height, const uint8_t *srcTexels)
+{
+	DebugAssert(width > 0);
+	DebugAssert(height > 0);
+	DebugAssert(srcTexels != nullptr);
+
+	this->width = width;
+	this->height = height;
+	this->wordsPerRow = (width + (BITS_PER_WORD - 1)) / BITS_PER_WORD;
+	this->bits.assign(this->wordsPerRow * height, 0);
+
+	for (int y = 0; y < height; y++)
+	{
+		uint64_t *row = this->bits.data() + (y * this->wordsPerRow);
+		for (int x = 0; x < width; x++)
+		{
+			const uint8_t srcTexel = srcTexels[x + (y * width)];
+			if (srcTexel != 0)
+			{
+				row[x / BITS_PER_WORD] |= static_cast<uint64_t>(1) << (x % BITS_PER_WORD);
+			}
+		}
+	}
+}
+
+int EntitySelectionMask::getWidth() const
+{
+	return this->width;
+}
+
+int EntitySelectionMask::getHeight() const
+{
+	return this->height;
+}
+
+int EntitySelectionMask::getByteCount() const
+{
+	return static_cast<int>(this->bits.size() * sizeof(uint64_t));
+}
+
+bool EntitySelectionMask::isOpaque(int x, int y, bool flipped) const
+{
+	DebugAssert(x >= 0);
+	DebugAssert(x < this->width);
+	DebugAssert(y >= 0);
+	DebugAssert(y < this->height);
+
+	const int maskX = !flipped ? x : ((this->width - 1) - x);
+	const uint64_t word = this->bits[(maskX / BITS_PER_WORD) + (y * this->wordsPerRow)];
+	return ((word >> (maskX % BITS_PER_WORD)) & 1) != 0;
+}
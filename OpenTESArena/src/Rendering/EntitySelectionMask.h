@@ -0,0 +1,29 @@
+#ifndef ENTITY_SELECTION_MASK_H
+#define ENTITY_SELECTION_MASK_H
+
+#include <cstdint>
+#include <vector>
+
+// One bit per texel of an entity texture telling whether the texel is opaque. Used for pixel-perfect
+// selection so ray casts don't need the renderer's texture data or a palette.
+
+class EntitySelectionMask
+{
+private:
+	std::vector<uint64_t> bits; // Row-major, each row padded to a whole number of words.
+	int width, height, wordsPerRow;
+public:
+	EntitySelectionMask();
+
+	// Transparent texels are the ones with palette index 0.
+	void init(int width, int height, const uint8_t *srcTexels);
+
+	int getWidth() const;
+	int getHeight() const;
+	int getByteCount() const;
+
+	// Gets whether the texel at the given coordinate is opaque. Flipped entities are mirrored horizontally.
+	bool isOpaque(int x, int y, bool flipped) const;
+};
+
+#endif
@@ -360,10 +360,16 @@ const Renderer::ProfilerData &Renderer::getProfilerData() const
 	return this->profilerData;
 }
 
+RendererSystem3D::TextureResidencyStats Renderer::getTextureResidencyStats() const
+{
+	DebugAssert(this->renderer3D->isInited());
+	return this->renderer3D->getTextureResidencyStats();
+}
+
 bool Renderer::getEntityRayIntersection(const EntityVisibilityState3D &visState,
 	const EntityDefinition &entityDef, const VoxelDouble3 &entityForward, const VoxelDouble3 &entityRight,
 	const VoxelDouble3 &entityUp, double entityWidth, double entityHeight, const CoordDouble3 &rayPoint,
-	const VoxelDouble3 &rayDirection, bool pixelPerfect, const Palette &palette, CoordDouble3 *outHitPoint) const
+	const VoxelDouble3 &rayDirection, bool pixelPerfect, CoordDouble3 *outHitPoint) const
 {
 	DebugAssert(this->renderer3D->isInited());
 	const Entity &entity = *visState.entity;
@@ -388,16 +394,41 @@ bool Renderer::getEntityRayIntersection(const EntityVisibilityState3D &visState,
 		const EntityAnimationDefinition::Keyframe &animKeyframe = animKeyframeList.getKeyframe(visState.keyframeIndex);
 		const TextureAssetReference &textureAssetRef = animKeyframe.getTextureAssetRef();
 		const bool flipped = animKeyframeList.isFlipped();
-		const bool reflective = (entityDef.getType() == EntityDefinition::Type::Doodad) && entityDef.getDoodad().puddle;
 
 		// See if the ray successfully hit a point on the entity, and that point is considered
 		// selectable (i.e. it's not transparent).
 		bool isSelected;
-		const bool withinEntity = this->renderer3D->tryGetEntitySelectionData(uv, textureAssetRef, flipped,
-			reflective, pixelPerfect, palette, &isSelected);
+		if (pixelPerfect)
+		{
+			const auto maskIter = this->entitySelectionMasks.find(textureAssetRef);
+			if (maskIter == this->entitySelectionMasks.end())
+			{
+				// Texture was never created for this entity.
+				return false;
+			}
+
+			// Convert texture coordinates to a texel. Don't need to clamp; just fail if it's out-of-bounds.
+			const EntitySelectionMask &selectionMask = maskIter->second;
+			const int textureX = static_cast<int>(uv.x * static_cast<double>(selectionMask.getWidth()));
+			const int textureY = static_cast<int>(uv.y * static_cast<double>(selectionMask.getHeight()));
+			if ((textureX < 0) || (textureX >= selectionMask.getWidth()) ||
+				(textureY < 0) || (textureY >= selectionMask.getHeight()))
+			{
+				// Outside the texture.
+				return false;
+			}
+
+			isSelected = selectionMask.isOpaque(textureX, textureY, flipped);
+		}
+		else
+		{
+			// If not pixel perfect, the entity's projected rectangle is hit if the texture coordinates
+			// are valid.
+			isSelected = (uv.x >= 0.0) && (uv.x <= 1.0) && (uv.y >= 0.0) && (uv.y <= 1.0);
+		}
 
 		*outHitPoint = VoxelUtils::newPointToCoord(absoluteHitPoint);
-		return withinEntity && isSelected;
+		return isSelected;
 	}
 	else
 	{
@@ -777,7 +808,26 @@ bool Renderer::tryCreateVoxelTexture(const TextureAssetReference &textureAssetRe
 bool Renderer::tryCreateEntityTexture(const TextureAssetReference &textureAssetRef, bool flipped,
 	bool reflective, TextureManager &textureManager)
 {
-	return this->renderer3D->tryCreateEntityTexture(textureAssetRef, flipped, reflective, textureManager);
+	if (!this->renderer3D->tryCreateEntityTexture(textureAssetRef, flipped, reflective, textureManager))
+	{
+		return false;
+	}
+
+	// Flipped and reflective variants share one selection mask.
+	if (this->entitySelectionMasks.find(textureAssetRef) == this->entitySelectionMasks.end())
+	{
+		const std::optional<TextureBuilderID> textureBuilderID = textureManager.tryGetTextureBuilderID(textureAssetRef);
+		DebugAssert(textureBuilderID.has_value());
+		const TextureBuilder &textureBuilder = textureManager.getTextureBuilderHandle(*textureBuilderID);
+		DebugAssert(textureBuilder.getType() == TextureBuilder::Type::Paletted);
+		const TextureBuilder::PalettedTexture &palettedTexture = textureBuilder.getPaletted();
+
+		EntitySelectionMask selectionMask;
+		selectionMask.init(textureBuilder.getWidth(), textureBuilder.getHeight(), palettedTexture.texels.get());
+		this->entitySelectionMasks.emplace(textureAssetRef, std::move(selectionMask));
+	}
+
+	return true;
 }
 
 bool Renderer::tryCreateSkyTexture(const TextureAssetReference &textureAssetRef, TextureManager &textureManager)
@@ -875,6 +925,13 @@ void Renderer::clearTextures()
 {
 	DebugAssert(this->renderer3D->isInited());
 	this->renderer3D->clearTextures();
+	this->entitySelectionMasks.clear();
+}
+
+void Renderer::releaseLevelTextures()
+{
+	DebugAssert(this->renderer3D->isInited());
+	this->renderer3D->releaseLevelTextures();
 }
 
 void Renderer::clearSky()
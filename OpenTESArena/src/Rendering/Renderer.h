@@ -5,8 +5,10 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
+#include "EntitySelectionMask.h"
 #include "RendererSystem2D.h"
 #include "RendererSystem3D.h"
 #include "RendererSystemType.h"
@@ -80,6 +82,7 @@ private:
 
 	std::unique_ptr<RendererSystem2D> renderer2D;
 	std::unique_ptr<RendererSystem3D> renderer3D;
+	std::unordered_map<TextureAssetReference, EntitySelectionMask> entitySelectionMasks; // For pixel-perfect selection.
 	std::vector<DisplayMode> displayModes;
 	SDL_Window *window;
 	SDL_Renderer *renderer;
@@ -135,6 +138,9 @@ public:
 	// Gets profiler data (timings, renderer properties, etc.).
 	const ProfilerData &getProfilerData() const;
 
+	// Gets how many voxel and entity textures are resident and how often they were reused.
+	RendererSystem3D::TextureResidencyStats getTextureResidencyStats() const;
+
 	// Tests whether an entity is intersected by the given ray. Intended for ray cast selection.
 	// 'pixelPerfect' determines whether the entity's texture is involved in the calculation.
 	// Returns whether the entity was able to be tested and was hit by the ray. This is a renderer
@@ -142,7 +148,7 @@ public:
 	bool getEntityRayIntersection(const EntityVisibilityState3D &visState, const EntityDefinition &entityDef,
 		const VoxelDouble3 &entityForward, const VoxelDouble3 &entityRight, const VoxelDouble3 &entityUp,
 		double entityWidth, double entityHeight, const CoordDouble3 &rayPoint, const VoxelDouble3 &rayDirection,
-		bool pixelPerfect, const Palette &palette, CoordDouble3 *outHitPoint) const;
+		bool pixelPerfect, CoordDouble3 *outHitPoint) const;
 
 	// Converts a [0, 1] screen point to a ray through the world. The exact direction is
 	// dependent on renderer details.
@@ -234,6 +240,7 @@ public:
 	void setSkyColors(const uint32_t *colors, int count);
 	void setNightLightsActive(bool active, const Palette &palette);
 	void clearTextures();
+	void releaseLevelTextures();
 	void clearSky();
 
 	// Fills the native frame buffer with the draw color, or default black/transparent.
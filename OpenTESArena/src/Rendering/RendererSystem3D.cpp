@@ -11,6 +11,16 @@ RendererSystem3D::ProfilerData::ProfilerData(int width, int height, int threadCo
 	this->visLightCount = visLightCount;
 }
 
+RendererSystem3D::TextureResidencyStats::TextureResidencyStats(int residentCount, int referencedCount,
+	int byteCount, int hitCount, int missCount)
+{
+	this->residentCount = residentCount;
+	this->referencedCount = referencedCount;
+	this->byteCount = byteCount;
+	this->hitCount = hitCount;
+	this->missCount = missCount;
+}
+
 RendererSystem3D::~RendererSystem3D()
 {
 	// Do nothing.
@@ -47,6 +47,16 @@ public:
 			int visFlatCount, int visLightCount);
 	};
 
+	// Voxel and entity textures kept resident across level changes.
+	struct TextureResidencyStats
+	{
+		int residentCount, referencedCount;
+		int byteCount;
+		int hitCount, missCount; // Texture requests that reused a resident texture vs. created one.
+
+		TextureResidencyStats(int residentCount, int referencedCount, int byteCount, int hitCount, int missCount);
+	};
+
 	virtual ~RendererSystem3D();
 
 	virtual void init(const RenderInitSettings &settings) = 0;
@@ -73,11 +83,6 @@ public:
 
 	virtual void resize(int width, int height) = 0;
 
-	// Tries to write out selection data for the given entity. Returns whether selection data was
-	// successfully written.
-	virtual bool tryGetEntitySelectionData(const Double2 &uv, const TextureAssetReference &textureAssetRef,
-		bool flipped, bool reflective, bool pixelPerfect, const Palette &palette, bool *outIsSelected) const = 0;
-
 	// Converts a screen point into a ray in the game world.
 	virtual Double3 screenPointToRay(double xPercent, double yPercent, const Double3 &cameraDirection,
 		Degrees fovY, double aspect) const = 0;
@@ -85,6 +90,9 @@ public:
 	// Gets various profiler information about internal renderer state.
 	virtual ProfilerData getProfilerData() const = 0;
 
+	// Gets texture residency information accumulated across level changes.
+	virtual TextureResidencyStats getTextureResidencyStats() const = 0;
+
 	// Legacy functions (remove these eventually).
 	virtual void setRenderThreadsMode(int mode) = 0;
 	virtual void setFogDistance(double fogDistance) = 0;
@@ -94,6 +102,7 @@ public:
 	virtual void setSkyColors(const uint32_t *colors, int count) = 0;
 	virtual void setNightLightsActive(bool active, const Palette &palette) = 0;
 	virtual void clearTextures() = 0;
+	virtual void releaseLevelTextures() = 0;
 	virtual void clearSky() = 0;
 	virtual void render(const CoordDouble3 &eye, const Double3 &direction, double fovY, double ambient,
 		double daytimePercent, double chasmAnimPercent, double latitude, bool nightLightsAreActive,
@@ -19,6 +19,18 @@ void RendererUtils::LoadedEntityTextureEntry::init(TextureAssetReference &&textu
 	this->reflective = reflective;
 }
 
+bool RendererUtils::LoadedEntityTextureEntry::operator==(const LoadedEntityTextureEntry &other) const
+{
+	return (this->textureAssetRef == other.textureAssetRef) && (this->flipped == other.flipped) &&
+		(this->reflective == other.reflective);
+}
+
+size_t RendererUtils::LoadedEntityTextureEntryHash::operator()(const LoadedEntityTextureEntry &entry) const
+{
+	const size_t refHash = std::hash<TextureAssetReference>()(entry.textureAssetRef);
+	return refHash ^ (static_cast<size_t>(entry.flipped) << 1) ^ (static_cast<size_t>(entry.reflective) << 2);
+}
+
 int RendererUtils::getRenderThreadsFromMode(int mode)
 {
 	if (mode == 0)
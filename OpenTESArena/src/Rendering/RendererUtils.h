@@ -3,9 +3,11 @@
 
 #include <array>
 #include <optional>
+#include <unordered_set>
 #include <vector>
 
 #include "../Assets/ArenaTypes.h"
+#include "../Assets/TextureAssetReference.h"
 #include "../Math/MathUtils.h"
 #include "../Math/Matrix4.h"
 #include "../Math/Vector3.h"
@@ -26,13 +28,20 @@ namespace RendererUtils
 		bool reflective;
 
 		void init(TextureAssetReference &&textureAssetRef, bool flipped, bool reflective);
+
+		bool operator==(const LoadedEntityTextureEntry &other) const;
+	};
+
+	struct LoadedEntityTextureEntryHash
+	{
+		size_t operator()(const LoadedEntityTextureEntry &entry) const;
 	};
 
 	// Loaded texture asset caches so the rest of the engine can see what texture assets are already loaded
 	// in the renderer.
-	// @todo: this should eventually be a hash table of texture asset refs to texture handles
-	using LoadedVoxelTextureCache = std::vector<TextureAssetReference>;
-	using LoadedEntityTextureCache = std::vector<LoadedEntityTextureEntry>;
+	// @todo: these should eventually map texture asset refs to texture handles
+	using LoadedVoxelTextureCache = std::unordered_set<TextureAssetReference>;
+	using LoadedEntityTextureCache = std::unordered_set<LoadedEntityTextureEntry, LoadedEntityTextureEntryHash>;
 
 	// Vertices used with fog geometry in screen-space around the player.
 	constexpr int FOG_GEOMETRY_VERTEX_COUNT = 8;
@@ -42,6 +42,14 @@ namespace
 	constexpr bool LightContributionCap = true;
 
 	constexpr double DEPTH_BUFFER_INFINITY = std::numeric_limits<double>::infinity();
+
+	RendererUtils::LoadedEntityTextureEntry MakeEntityTextureKey(const TextureAssetReference &textureAssetRef,
+		bool flipped, bool reflective)
+	{
+		RendererUtils::LoadedEntityTextureEntry key;
+		key.init(TextureAssetReference(textureAssetRef), flipped, reflective);
+		return key;
+	}
 }
 
 void SoftwareRenderer::VoxelTexel::init(double r, double g, double b, double emission,
@@ -268,87 +276,6 @@ void SoftwareRenderer::ChasmTexture::init(int width, int height, const uint8_t *
 	}
 }
 
-SoftwareRenderer::VoxelTextureMapping::VoxelTextureMapping(TextureAssetReference &&textureAssetRef, int textureIndex)
-	: textureAssetRef(std::move(textureAssetRef))
-{
-	this->textureIndex = textureIndex;
-}
-
-void SoftwareRenderer::VoxelTextures::addTexture(VoxelTexture &&texture, TextureAssetReference &&textureAssetRef)
-{
-	this->textures.emplace_back(std::move(texture));
-
-	const int index = static_cast<int>(this->textures.size()) - 1;
-	this->mappings.emplace_back(VoxelTextureMapping(std::move(textureAssetRef), index));
-}
-
-const SoftwareRenderer::VoxelTexture &SoftwareRenderer::VoxelTextures::getTexture(
-	const TextureAssetReference &textureAssetRef) const
-{
-	int index = -1;
-	for (int i = 0; i < static_cast<int>(this->mappings.size()); i++)
-	{
-		const VoxelTextureMapping &mapping = this->mappings[i];
-		if (mapping.textureAssetRef == textureAssetRef)
-		{
-			index = mapping.textureIndex;
-			break;
-		}
-	}
-
-	DebugAssertIndex(this->textures, index);
-	return this->textures[index];
-}
-
-void SoftwareRenderer::VoxelTextures::clear()
-{
-	this->textures.clear();
-	this->mappings.clear();
-}
-
-SoftwareRenderer::EntityTextureMapping::EntityTextureMapping(TextureAssetReference &&textureAssetRef,
-	bool flipped, bool reflective, int textureIndex)
-	: textureAssetRef(std::move(textureAssetRef))
-{
-	this->flipped = flipped;
-	this->reflective = reflective;
-	this->textureIndex = textureIndex;
-}
-
-void SoftwareRenderer::EntityTextures::addTexture(FlatTexture &&texture,
-	TextureAssetReference &&textureAssetRef, bool flipped, bool reflective)
-{
-	this->textures.emplace_back(std::move(texture));
-
-	const int index = static_cast<int>(this->textures.size()) - 1;
-	this->mappings.emplace_back(EntityTextureMapping(std::move(textureAssetRef), flipped, reflective, index));
-}
-
-const SoftwareRenderer::FlatTexture &SoftwareRenderer::EntityTextures::getTexture(
-	const TextureAssetReference &textureAssetRef, bool flipped, bool reflective) const
-{
-	int index = -1;
-	for (int i = 0; i < static_cast<int>(this->mappings.size()); i++)
-	{
-		const EntityTextureMapping &mapping = this->mappings[i];
-		if ((mapping.textureAssetRef == textureAssetRef) && (mapping.flipped == flipped) &&
-			(mapping.reflective == reflective))
-		{
-			index = mapping.textureIndex;
-			break;
-		}
-	}
-
-	DebugAssertIndex(this->textures, index);
-	return this->textures[index];
-}
-
-void SoftwareRenderer::EntityTextures::clear()
-{
-	this->textures.clear();
-	this->mappings.clear();
-}
-
 SoftwareRenderer::Camera::Camera(const CoordDouble3 &eye, const VoxelDouble3 &direction,
 	Degrees fovY, double aspect, double projectionModifier)
 	: eye(eye), direction(direction)
@@ -998,45 +925,6 @@ SoftwareRenderer::ProfilerData SoftwareRenderer::getProfilerData() const
 		static_cast<int>(this->visibleLights.size()));
 }
 
-bool SoftwareRenderer::tryGetEntitySelectionData(const Double2 &uv, const TextureAssetReference &textureAssetRef,
-	bool flipped, bool reflective, bool pixelPerfect, const Palette &palette, bool *outIsSelected) const
-{
-	// Branch depending on whether the selection request needs to include texture data.
-	if (pixelPerfect)
-	{
-		// Get the texture list from the texture group at the given animation state and angle.
-		const FlatTexture &texture = this->entityTextures.getTexture(textureAssetRef, flipped, reflective);
-
-		// Convert texture coordinates to a texture index. Don't need to clamp; just return
-		// failure if it's out-of-bounds.
-		const int textureX = static_cast<int>(uv.x * static_cast<double>(texture.width));
-		const int textureY = static_cast<int>(uv.y * static_cast<double>(texture.height));
-
-		if ((textureX < 0) || (textureX >= texture.width) ||
-			(textureY < 0) || (textureY >= texture.height))
-		{
-			// Outside the texture.
-			return false;
-		}
-
-		const int textureIndex = textureX + (textureY * texture.width);
-
-		// Check if the texel is non-transparent.
-		const FlatTexel &texel = texture.texels[textureIndex];
-		const Color &texelColor = palette[texel.value];
-		*outIsSelected = texelColor.a > 0;
-		return true;
-	}
-	else
-	{
-		// If not pixel perfect, the entity's projected rectangle is hit if the texture coordinates
-		// are valid.
-		const bool withinEntity = (uv.x >= 0.0) && (uv.x <= 1.0) && (uv.y >= 0.0) && (uv.y <= 1.0);
-		*outIsSelected = withinEntity;
-		return true;
-	}
-}
-
 Double3 SoftwareRenderer::screenPointToRay(double xPercent, double yPercent,
 	const Double3 &cameraDirection, double fovY, double aspect) const
 {
@@ -1153,8 +1041,9 @@ void SoftwareRenderer::setNightLightsActive(bool active, const Palette &palette)
 {
 	// @todo: activate lights (don't worry about textures).
 
-	for (VoxelTexture &voxelTexture : this->voxelTextures.textures)
+	for (auto &pair : this->voxelTextures.entries)
 	{
+		VoxelTexture &voxelTexture = pair.second.texture;
 		voxelTexture.setLightTexelsActive(active, palette);
 	}
 }
@@ -1167,6 +1056,34 @@ void SoftwareRenderer::clearTextures()
 	this->chasmTextureGroups.clear();
 }
 
+void SoftwareRenderer::releaseLevelTextures()
+{
+	this->voxelTextures.releaseAll();
+	this->entityTextures.releaseAll();
+	this->skyTextures.clear();
+	this->chasmTextureGroups.clear();
+}
+
+SoftwareRenderer::TextureResidencyStats SoftwareRenderer::getTextureResidencyStats() const
+{
+	int referencedCount = 0;
+	for (const auto &pair : this->voxelTextures.entries)
+	{
+		referencedCount += (pair.second.refCount > 0) ? 1 : 0;
+	}
+
+	for (const auto &pair : this->entityTextures.entries)
+	{
+		referencedCount += (pair.second.refCount > 0) ? 1 : 0;
+	}
+
+	const int residentCount = static_cast<int>(this->voxelTextures.entries.size() + this->entityTextures.entries.size());
+	const int byteCount = this->voxelTextures.byteCount + this->entityTextures.byteCount;
+	const int hitCount = this->voxelTextures.hitCount + this->entityTextures.hitCount;
+	const int missCount = this->voxelTextures.missCount + this->entityTextures.missCount;
+	return TextureResidencyStats(residentCount, referencedCount, byteCount, hitCount, missCount);
+}
+
 void SoftwareRenderer::clearSky()
 {
 	this->distantObjects.clear();
@@ -1194,7 +1111,10 @@ void SoftwareRenderer::resize(int width, int height)
 bool SoftwareRenderer::tryCreateVoxelTexture(const TextureAssetReference &textureAssetRef,
 	TextureManager &textureManager)
 {
-	// @todo: protect against duplicate textures.
+	if (this->voxelTextures.tryAcquire(textureAssetRef))
+	{
+		return true;
+	}
 
 	const std::optional<TextureBuilderID> textureBuilderID = textureManager.tryGetTextureBuilderID(textureAssetRef);
 	if (!textureBuilderID.has_value())
@@ -1223,7 +1143,10 @@ bool SoftwareRenderer::tryCreateVoxelTexture(const TextureAssetReference &textur
 		voxelTexture.init(textureBuilder.getWidth(), textureBuilder.getHeight(),
 			palettedTexture.texels.get(), palette);
 
-		this->voxelTextures.addTexture(std::move(voxelTexture), TextureAssetReference(textureAssetRef));
+		const int byteCount = static_cast<int>((voxelTexture.texels.size() * sizeof(VoxelTexel)) +
+			(voxelTexture.lightTexels.size() * sizeof(Int2)));
+		this->voxelTextures.add(TextureAssetReference(textureAssetRef), std::move(voxelTexture), byteCount);
+		this->voxelTextures.evict(VOXEL_TEXTURE_BUDGET_BYTES);
 		return true;
 	}
 	else if (textureBuilderType == TextureBuilder::Type::TrueColor)
@@ -1240,6 +1163,12 @@ bool SoftwareRenderer::tryCreateVoxelTexture(const TextureAssetReference &textur
 bool SoftwareRenderer::tryCreateEntityTexture(const TextureAssetReference &textureAssetRef, bool flipped,
 	bool reflective, TextureManager &textureManager)
 {
+	RendererUtils::LoadedEntityTextureEntry key = MakeEntityTextureKey(textureAssetRef, flipped, reflective);
+	if (this->entityTextures.tryAcquire(key))
+	{
+		return true;
+	}
+
 	const std::optional<TextureBuilderID> textureBuilderID = textureManager.tryGetTextureBuilderID(textureAssetRef);
 	if (!textureBuilderID.has_value())
 	{
@@ -1257,8 +1186,9 @@ bool SoftwareRenderer::tryCreateEntityTexture(const TextureAssetReference &textu
 		flatTexture.init(textureBuilder.getWidth(), textureBuilder.getHeight(),
 			palettedTexture.texels.get(), flipped, reflective);
 
-		this->entityTextures.addTexture(std::move(flatTexture), TextureAssetReference(textureAssetRef),
-			flipped, reflective);
+		const int byteCount = static_cast<int>(flatTexture.texels.size() * sizeof(FlatTexel));
+		this->entityTextures.add(std::move(key), std::move(flatTexture), byteCount);
+		this->entityTextures.evict(ENTITY_TEXTURE_BUDGET_BYTES);
 		return true;
 	}
 	else if (textureBuilderType == TextureBuilder::Type::TrueColor)
@@ -1302,13 +1232,13 @@ bool SoftwareRenderer::tryCreateSkyTexture(const TextureAssetReference &textureA
 
 void SoftwareRenderer::freeVoxelTexture(const TextureAssetReference &textureAssetRef)
 {
-	DebugNotImplemented();
+	this->voxelTextures.release(textureAssetRef);
 }
 
 void SoftwareRenderer::freeEntityTexture(const TextureAssetReference &textureAssetRef, bool flipped,
 	bool reflective)
 {
-	DebugNotImplemented();
+	this->entityTextures.release(MakeEntityTextureKey(textureAssetRef, flipped, reflective));
 }
 
 void SoftwareRenderer::freeSkyTexture(const TextureAssetReference &textureAssetRef)
@@ -1870,12 +1800,13 @@ void SoftwareRenderer::updateVisibleFlats(const Camera &camera, const ShadingInf
 				const bool flipped = animDefKeyframeList.isFlipped();
 				const bool reflective = (entityDef.getType() == EntityDefinition::Type::Doodad) &&
 					entityDef.getDoodad().puddle;
-				visFlat.texture = &this->entityTextures.getTexture(textureAssetRef, flipped, reflective);
+				visFlat.texture = &this->entityTextures.useTexture(MakeEntityTextureKey(textureAssetRef, flipped, reflective));
 
 				// Add palette override if it is a citizen entity.
 				const EntityAnimationInstance &animInst = entity->getAnimInstance();
-				const EntityAnimationInstance::CitizenParams *citizenParams = animInst.getCitizenParams();
-				visFlat.overridePalette = (citizenParams != nullptr) ? &citizenParams->palette : nullptr;
+				const EntityPaletteID paletteID = animInst.getPaletteID();
+				visFlat.overridePalette = (paletteID != EntityManager::NO_PALETTE_ID) ?
+					&entityManager.getEntityPalette(paletteID) : nullptr;
 
 				// Add the flat data to the draw list.
 				this->visibleFlats.emplace_back(std::move(visFlat));
@@ -5862,8 +5793,11 @@ void SoftwareRenderer::drawInitialVoxelColumn(int x, const CoordInt2 &coord, con
 	// Relative Y voxel coordinate of the camera, compensating for the ceiling height.
 	const int adjustedVoxelY = camera.getAdjustedEyeVoxelY(ceilingScale);
 
+	// Voxels at or above the column height are empty and can be skipped.
+	const int columnHeight = chunkPtr->getColumnHeight(coord.voxel.x, coord.voxel.y);
+
 	// Try to draw the player's current voxel first.
-	if ((adjustedVoxelY >= 0) && (adjustedVoxelY < chunkPtr->getHeight()))
+	if ((adjustedVoxelY >= 0) && (adjustedVoxelY < columnHeight))
 	{
 		const VoxelInt3 sameFloorVoxel(coord.voxel.x, adjustedVoxelY, coord.voxel.y);
 		SoftwareRenderer::drawInitialVoxelSameFloor(x, *chunkPtr, sameFloorVoxel, camera, ray, facing, nearPoint,
@@ -5872,7 +5806,7 @@ void SoftwareRenderer::drawInitialVoxelColumn(int x, const CoordInt2 &coord, con
 	}
 
 	// Try to draw voxels below the player's voxel (clamping in case the player is above the chunk).
-	for (int voxelY = std::min(adjustedVoxelY - 1, chunkPtr->getHeight() - 1); voxelY >= 0; voxelY--)
+	for (int voxelY = std::min(adjustedVoxelY - 1, columnHeight - 1); voxelY >= 0; voxelY--)
 	{
 		const VoxelInt3 belowVoxel(coord.voxel.x, voxelY, coord.voxel.y);
 		SoftwareRenderer::drawInitialVoxelBelow(x, *chunkPtr, belowVoxel, camera, ray, facing, nearPoint,
@@ -5881,7 +5815,7 @@ void SoftwareRenderer::drawInitialVoxelColumn(int x, const CoordInt2 &coord, con
 	}
 
 	// Try to draw voxels above the player's voxel (clamping in case the player is below the chunk).
-	for (int voxelY = std::max(adjustedVoxelY + 1, 0); voxelY < chunkPtr->getHeight(); voxelY++)
+	for (int voxelY = std::max(adjustedVoxelY + 1, 0); voxelY < columnHeight; voxelY++)
 	{
 		const VoxelInt3 aboveVoxel(coord.voxel.x, voxelY, coord.voxel.y);
 		SoftwareRenderer::drawInitialVoxelAbove(x, *chunkPtr, aboveVoxel, camera, ray, facing, nearPoint,
@@ -7188,8 +7122,11 @@ void SoftwareRenderer::drawVoxelColumn(int x, const CoordInt2 &coord, const Came
 	// Relative Y voxel coordinate of the camera, compensating for the ceiling height.
 	const int adjustedVoxelY = camera.getAdjustedEyeVoxelY(ceilingScale);
 
+	// Voxels at or above the column height are empty and can be skipped.
+	const int columnHeight = chunkPtr->getColumnHeight(coord.voxel.x, coord.voxel.y);
+
 	// Try to draw voxel straight ahead first.
-	if ((adjustedVoxelY >= 0) && (adjustedVoxelY < chunkPtr->getHeight()))
+	if ((adjustedVoxelY >= 0) && (adjustedVoxelY < columnHeight))
 	{
 		const VoxelInt3 sameFloorVoxel(coord.voxel.x, adjustedVoxelY, coord.voxel.y);
 		SoftwareRenderer::drawVoxelSameFloor(x, *chunkPtr, sameFloorVoxel, camera, ray, facing, nearPoint, farPoint,
@@ -7198,7 +7135,7 @@ void SoftwareRenderer::drawVoxelColumn(int x, const CoordInt2 &coord, const Came
 	}
 
 	// Try to draw voxels below the player's voxel (clamping in case the player is above the chunk).
-	for (int voxelY = std::min(adjustedVoxelY - 1, chunkPtr->getHeight() - 1); voxelY >= 0; voxelY--)
+	for (int voxelY = std::min(adjustedVoxelY - 1, columnHeight - 1); voxelY >= 0; voxelY--)
 	{
 		const VoxelInt3 belowVoxel(coord.voxel.x, voxelY, coord.voxel.y);
 		SoftwareRenderer::drawVoxelBelow(x, *chunkPtr, belowVoxel, camera, ray, facing, nearPoint, farPoint,
@@ -7207,7 +7144,7 @@ void SoftwareRenderer::drawVoxelColumn(int x, const CoordInt2 &coord, const Came
 	}
 	
 	// Try to draw voxels above the player's voxel (clamping in case the player is below the chunk).
-	for (int voxelY = std::max(adjustedVoxelY + 1, 0); voxelY < chunkPtr->getHeight(); voxelY++)
+	for (int voxelY = std::max(adjustedVoxelY + 1, 0); voxelY < columnHeight; voxelY++)
 	{
 		const VoxelInt3 aboveVoxel(coord.voxel.x, voxelY, coord.voxel.y);
 		SoftwareRenderer::drawVoxelAbove(x, *chunkPtr, aboveVoxel, camera, ray, facing, nearPoint, farPoint,
@@ -1,17 +1,21 @@
 #ifndef SOFTWARE_RENDERER_H
 #define SOFTWARE_RENDERER_H
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <list>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "RendererSystem3D.h"
+#include "RendererUtils.h"
 #include "../Assets/ArenaTypes.h"
+#include "../Assets/TextureAssetReference.h"
 #include "../Entities/EntityManager.h"
 #include "../Game/Options.h"
 #include "../Math/MathUtils.h"
@@ -23,6 +27,7 @@
 #include "../World/VoxelDefinition.h"
 #include "../World/VoxelUtils.h"
 
+#include "components/debug/Debug.h"
 #include "components/utilities/Buffer2D.h"
 #include "components/utilities/BufferView.h"
 #include "components/utilities/BufferView2D.h"
@@ -114,53 +119,170 @@ private:
 		void init(int width, int height, const uint8_t *srcTexels, const Palette &palette);
 	};
 
-	// @temp: this is a temporary solution to voxel texture allocation management -- ideally the renderer
-	// would take texture builders and return texture handles and those would be bound to instance voxel
-	// geometry.
-	struct VoxelTextureMapping
+	// @temp: this is a temporary solution to voxel and entity texture allocation management -- ideally the
+	// renderer would take texture builders and return texture handles and those would be bound to instance
+	// geometry. Textures are reference-counted by the active level and stay resident after being released so
+	// the next level can reuse them without rebuilding. Unreferenced textures are kept in least-recently-used
+	// order and evicted from the front once the cache is over its byte budget.
+	template <typename KeyT, typename TextureT, typename HashT = std::hash<KeyT>>
+	struct ResidentTextureCache
 	{
-		TextureAssetReference textureAssetRef;
-		int textureIndex; // Index in voxel textures list.
+		// Keys are owned by the entries map, whose elements don't move when it rehashes.
+		using EvictableList = std::list<const KeyT*>;
 
-		VoxelTextureMapping(TextureAssetReference &&textureAssetRef, int textureIndex);
-	};
-
-	struct VoxelTextures
-	{
-		std::vector<VoxelTexture> textures;
-		std::vector<VoxelTextureMapping> mappings;
+		struct Entry
+		{
+			TextureT texture;
+			int refCount;
+			uint64_t lastUseStamp; // Use clock value when the texture was last acquired or drawn.
+			int byteCount;
+			typename EvictableList::iterator evictableIter; // Only valid when unreferenced.
+		};
 
-		void addTexture(VoxelTexture &&texture, TextureAssetReference &&textureAssetRef);
+		std::unordered_map<KeyT, Entry, HashT> entries;
+		EvictableList evictableKeys; // Unreferenced textures, least recently used first.
+		int byteCount; // Total bytes of resident textures.
+		uint64_t useClock; // Incremented each time a texture is used. Voxel textures are only drawn on render
+		// threads, so they're stamped when acquired.
+		int hitCount, missCount; // References to already-resident textures vs. ones that had to be created.
 
-		const VoxelTexture &getTexture(const TextureAssetReference &textureAssetRef) const;
+		ResidentTextureCache()
+		{
+			this->byteCount = 0;
+			this->useClock = 0;
+			this->hitCount = 0;
+			this->missCount = 0;
+		}
 
-		void clear();
-	};
+		void stamp(Entry &entry)
+		{
+			this->useClock++;
+			entry.lastUseStamp = this->useClock;
+		}
 
-	// @temp: this is a temporary solution to entity texture allocation management -- ideally the renderer
-	// would take texture builders and return texture handles and those would be bound to instance entity
-	// geometry.
-	struct EntityTextureMapping
-	{
-		TextureAssetReference textureAssetRef;
-		bool flipped;
-		bool reflective;
-		int textureIndex; // Index in entity textures list.
+		// Adds a reference to the texture if it is resident. Returns whether it was.
+		bool tryAcquire(const KeyT &key)
+		{
+			const auto iter = this->entries.find(key);
+			if (iter == this->entries.end())
+			{
+				this->missCount++;
+				return false;
+			}
+
+			Entry &entry = iter->second;
+			if (entry.refCount == 0)
+			{
+				this->evictableKeys.erase(entry.evictableIter);
+			}
+
+			entry.refCount++;
+			this->stamp(entry);
+			this->hitCount++;
+			return true;
+		}
+
+		// Makes a newly-created texture resident with one reference.
+		void add(KeyT &&key, TextureT &&texture, int byteCount)
+		{
+			DebugAssert(this->entries.find(key) == this->entries.end());
+
+			Entry entry;
+			entry.texture = std::move(texture);
+			entry.refCount = 1;
+			entry.byteCount = byteCount;
+			this->stamp(entry);
+			this->entries.emplace(std::move(key), std::move(entry));
+			this->byteCount += byteCount;
+		}
+
+		// Removes a reference to the texture. It stays resident until evicted.
+		void release(const KeyT &key)
+		{
+			const auto iter = this->entries.find(key);
+			if (iter == this->entries.end())
+			{
+				DebugLogWarning("Texture to release is not resident.");
+				return;
+			}
+
+			Entry &entry = iter->second;
+			DebugAssert(entry.refCount > 0);
+			entry.refCount--;
+			if (entry.refCount == 0)
+			{
+				entry.evictableIter = this->evictableKeys.insert(this->evictableKeys.end(), &iter->first);
+			}
+		}
+
+		void releaseAll()
+		{
+			// Textures released together are ordered by when they were last used, so the ones the previous
+			// level drew most recently are evicted last.
+			std::vector<std::pair<uint64_t, typename std::unordered_map<KeyT, Entry, HashT>::iterator>> releasedIters;
+			for (auto iter = this->entries.begin(); iter != this->entries.end(); ++iter)
+			{
+				Entry &entry = iter->second;
+				if (entry.refCount > 0)
+				{
+					entry.refCount = 0;
+					releasedIters.emplace_back(entry.lastUseStamp, iter);
+				}
+			}
+
+			std::sort(releasedIters.begin(), releasedIters.end(),
+				[](const auto &a, const auto &b) { return a.first < b.first; });
+
+			for (const auto &pair : releasedIters)
+			{
+				const auto iter = pair.second;
+				iter->second.evictableIter = this->evictableKeys.insert(this->evictableKeys.end(), &iter->first);
+			}
+		}
+
+		// Evicts unreferenced textures least-recently-used first until the cache fits in the byte budget or
+		// nothing else can be evicted.
+		void evict(int budgetByteCount)
+		{
+			while ((this->byteCount > budgetByteCount) && !this->evictableKeys.empty())
+			{
+				const auto iter = this->entries.find(*this->evictableKeys.front());
+				DebugAssert(iter != this->entries.end());
+				DebugAssert(iter->second.refCount == 0);
+				this->evictableKeys.pop_front();
+				this->byteCount -= iter->second.byteCount;
+				this->entries.erase(iter);
+			}
+		}
+
+		const TextureT &getTexture(const KeyT &key) const
+		{
+			const auto iter = this->entries.find(key);
+			DebugAssert(iter != this->entries.end());
+			return iter->second.texture;
+		}
 
-		EntityTextureMapping(TextureAssetReference &&textureAssetRef, bool flipped, bool reflective, int textureIndex);
+		// Gets the texture for drawing this frame and marks it as recently used. Only for the main thread.
+		const TextureT &useTexture(const KeyT &key)
+		{
+			const auto iter = this->entries.find(key);
+			DebugAssert(iter != this->entries.end());
+			Entry &entry = iter->second;
+			this->stamp(entry);
+			return entry.texture;
+		}
+
+		void clear()
+		{
+			this->entries.clear();
+			this->evictableKeys.clear();
+			this->byteCount = 0;
+		}
 	};
 
-	struct EntityTextures
-	{
-		std::vector<FlatTexture> textures;
-		std::vector<EntityTextureMapping> mappings;
-
-		void addTexture(FlatTexture &&texture, TextureAssetReference &&textureAssetRef, bool flipped, bool reflective);
-
-		const FlatTexture &getTexture(const TextureAssetReference &textureAssetRef, bool flipped, bool reflective) const;
-
-		void clear();
-	};
+	using VoxelTextures = ResidentTextureCache<TextureAssetReference, VoxelTexture>;
+	using EntityTextures = ResidentTextureCache<RendererUtils::LoadedEntityTextureEntry, FlatTexture,
+		RendererUtils::LoadedEntityTextureEntryHash>;
 
 	// Camera for 2.5D ray casting (with some pre-calculated values to avoid duplicating work).
 	struct Camera
@@ -541,6 +663,10 @@ private:
 	// Max angle of distant clouds above the horizon, in degrees.
 	static constexpr double DISTANT_CLOUDS_MAX_ANGLE = 25.0;
 
+	// Memory budgets for resident textures. Only unreferenced textures are evicted to stay within them.
+	static constexpr int VOXEL_TEXTURE_BUDGET_BYTES = 64 * 1024 * 1024;
+	static constexpr int ENTITY_TEXTURE_BUDGET_BYTES = 16 * 1024 * 1024;
+
 	Buffer2D<double> depthBuffer;
 	Buffer<OcclusionData> occlusion; // 1D buffer, min and max Y for each pixel column.
 	std::vector<const Entity*> potentiallyVisibleFlats; // Updated every frame.
@@ -930,11 +1056,6 @@ public:
 	// Gets profiling information about renderer internals.
 	ProfilerData getProfilerData() const override;
 
-	// Tries to write out selection data for the given entity. Returns whether selection data was
-	// successfully written.
-	bool tryGetEntitySelectionData(const Double2 &uv, const TextureAssetReference &textureAssetRef,
-		bool flipped, bool reflective, bool pixelPerfect, const Palette &palette, bool *outIsSelected) const override;
-
 	// Converts a screen point to a ray into the game world.
 	Double3 screenPointToRay(double xPercent, double yPercent, const Double3 &cameraDirection,
 		Degrees fovY, double aspect) const override;
@@ -964,6 +1085,12 @@ public:
 	// Zeroes out all renderer textures and entity render ID mappings to textures.
 	void clearTextures() override;
 
+	// Releases the active level's voxel and entity texture references, keeping them resident for the next
+	// level, and clears the sky and chasm textures.
+	void releaseLevelTextures() override;
+
+	TextureResidencyStats getTextureResidencyStats() const override;
+
 	// Removes all sky objects.
 	void clearSky() override;
 
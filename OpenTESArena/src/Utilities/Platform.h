@@ -19,6 +19,9 @@ namespace Platform
 	// Gets the screenshot folder path via SDL_GetPrefPath().
 	std::string getScreenshotPath();
 
+	// Gets the folder path for data generated by the engine that can be regenerated if deleted.
+	std::string getCachePath();
+
 	// Gets the log folder path for logging program messages.
 	std::string getLogPath();
 
@@ -0,0 +1,109 @@
+#include <algorithm>
+
+#include "ThreadPool.h"
+
+#include "components/debug/Debug.h"
+
+ThreadPool::ThreadPool()
+{
+	this->jobFunc = nullptr;
+	this->jobThreadCount = 0;
+	this->jobGeneration = 0;
+	this->workersDone = 0;
+	this->isDestructing = false;
+}
+
+ThreadPool::~ThreadPool()
+{
+	// Tell each worker it needs to terminate.
+	std::unique_lock<std::mutex> lk(this->mutex);
+	this->isDestructing = true;
+	lk.unlock();
+	this->condVar.notify_all();
+
+	for (std::thread &thread : this->threads)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+}
+
+void ThreadPool::init(int threadCount)
+{
+	DebugAssert(threadCount >= 1);
+	DebugAssert(this->threads.empty());
+
+	this->threads.reserve(threadCount - 1);
+	for (int i = 1; i < threadCount; i++)
+	{
+		this->threads.emplace_back(&ThreadPool::workerLoop, this, i);
+	}
+}
+
+int ThreadPool::getThreadCount() const
+{
+	return static_cast<int>(this->threads.size()) + 1;
+}
+
+void ThreadPool::run(int threadCount, const JobFunc &jobFunc)
+{
+	threadCount = std::clamp(threadCount, 1, this->getThreadCount());
+	if (threadCount == 1)
+	{
+		jobFunc(0, 1);
+		return;
+	}
+
+	std::unique_lock<std::mutex> lk(this->mutex);
+	DebugAssertMsg(this->jobFunc == nullptr, "Thread pool is already running a job.");
+	this->jobFunc = &jobFunc;
+	this->jobThreadCount = threadCount;
+	this->jobGeneration++;
+	this->workersDone = 0;
+	lk.unlock();
+	this->condVar.notify_all();
+
+	jobFunc(0, threadCount);
+
+	lk.lock();
+	this->condVar.wait(lk, [this]() { return this->workersDone == (this->jobThreadCount - 1); });
+	this->jobFunc = nullptr;
+}
+
+void ThreadPool::workerLoop(int threadIndex)
+{
+	int lastJobGeneration = 0;
+	while (true)
+	{
+		std::unique_lock<std::mutex> lk(this->mutex);
+		this->condVar.wait(lk, [this, lastJobGeneration]()
+		{
+			return this->isDestructing || (this->jobGeneration != lastJobGeneration);
+		});
+
+		if (this->isDestructing)
+		{
+			break;
+		}
+
+		lastJobGeneration = this->jobGeneration;
+		if (threadIndex >= this->jobThreadCount)
+		{
+			// Not needed for this job.
+			continue;
+		}
+
+		const JobFunc &jobFunc = *this->jobFunc;
+		const int jobThreadCount = this->jobThreadCount;
+		lk.unlock();
+
+		jobFunc(threadIndex, jobThreadCount);
+
+		lk.lock();
+		this->workersDone++;
+		lk.unlock();
+		this->condVar.notify_all();
+	}
+}
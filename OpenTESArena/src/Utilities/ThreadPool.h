@@ -0,0 +1,48 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Worker threads that stay alive between jobs, for splitting independent work across the CPU without
+// starting new threads every time. The calling thread does a share of each job too. Jobs must only be
+// run from one thread at a time.
+
+class ThreadPool
+{
+public:
+	// Called once on each participating thread with its index (the calling thread is 0) and the number of
+	// participating threads.
+	using JobFunc = std::function<void(int threadIndex, int threadCount)>;
+private:
+	std::vector<std::thread> threads;
+	std::condition_variable condVar;
+	std::mutex mutex;
+	const JobFunc *jobFunc; // Non-null while a job is running.
+	int jobThreadCount; // Threads participating in the current job, including the calling thread.
+	int jobGeneration; // Incremented for each job so a worker can tell when there's a new one.
+	int workersDone;
+	bool isDestructing;
+
+	void workerLoop(int threadIndex);
+public:
+	ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	~ThreadPool();
+
+	ThreadPool &operator=(const ThreadPool&) = delete;
+
+	// Starts the worker threads. The calling thread counts as one, so a count of one starts none.
+	void init(int threadCount);
+
+	// Gets the most threads a job can run on, including the calling thread.
+	int getThreadCount() const;
+
+	// Runs the job on up to the given number of threads and waits for all of them to finish.
+	void run(int threadCount, const JobFunc &jobFunc);
+};
+
+#endif
@@ -11,6 +11,22 @@ void Chunk::init(const ChunkInt2 &coord, int height)
 	this->voxels.init(Chunk::WIDTH, height, Chunk::DEPTH);
 	this->voxels.fill(Chunk::AIR_VOXEL_ID);
 
+	DebugAssert(height <= std::numeric_limits<uint8_t>::max());
+	this->columnHeights.init(Chunk::WIDTH, Chunk::DEPTH);
+	this->columnHeights.fill(0);
+
+	const int voxelTraitWordCount = Chunk::WIDTH * height;
+	for (std::vector<uint64_t> &traitBits : this->voxelTraitBits)
+	{
+		traitBits.assign(voxelTraitWordCount, 0);
+	}
+
+	std::vector<uint64_t> &emptyTraitBits = this->voxelTraitBits[static_cast<int>(VoxelTraitType::Empty)];
+	std::fill(emptyTraitBits.begin(), emptyTraitBits.end(), std::numeric_limits<uint64_t>::max());
+
+	this->citizenSpawnVoxels.clear();
+	this->citizenSpawnVoxelIndices.assign(Chunk::WIDTH * Chunk::DEPTH, -1);
+
 	this->voxelDefs.fill(VoxelDefinition());
 	this->activeVoxelDefs.fill(false);
 
@@ -19,6 +35,7 @@ void Chunk::init(const ChunkInt2 &coord, int height)
 	this->activeVoxelDefs.front() = true;
 
 	this->coord = coord;
+	this->clearDirtyEdges();
 }
 
 const ChunkInt2 &Chunk::getCoord() const
@@ -41,6 +58,34 @@ Chunk::VoxelID Chunk::getVoxel(SNInt x, int y, WEInt z) const
 	return this->voxels.get(x, y, z);
 }
 
+bool Chunk::hasVoxelTrait(SNInt x, int y, WEInt z, VoxelTraitType traitType) const
+{
+	DebugAssert(this->isValidVoxel(x, y, z));
+	const std::vector<uint64_t> &traitBits = this->voxelTraitBits[static_cast<int>(traitType)];
+	const uint64_t traitWord = traitBits[x + (y * Chunk::WIDTH)];
+	return ((traitWord >> z) & 1) != 0;
+}
+
+BufferView<const VoxelInt2> Chunk::getCitizenSpawnVoxels() const
+{
+	return BufferView<const VoxelInt2>(this->citizenSpawnVoxels.data(),
+		static_cast<int>(this->citizenSpawnVoxels.size()));
+}
+
+int Chunk::getColumnHeight(SNInt x, WEInt z) const
+{
+	return static_cast<int>(this->columnHeights.get(x, z));
+}
+
+int Chunk::getVoxelByteCount() const
+{
+	const int voxelCount = this->voxels.getWidth() * this->voxels.getHeight() * this->voxels.getDepth();
+	const int columnCount = this->columnHeights.getWidth() * this->columnHeights.getHeight();
+	const int voxelTraitWordCount = static_cast<int>(this->voxelTraitBits.size() * this->voxelTraitBits.front().size());
+	return (voxelCount * static_cast<int>(sizeof(VoxelID))) + (columnCount * static_cast<int>(sizeof(uint8_t))) +
+		(voxelTraitWordCount * static_cast<int>(sizeof(uint64_t)));
+}
+
 int Chunk::getVoxelDefCount() const
 {
 	return static_cast<int>(std::count(this->activeVoxelDefs.begin(),
@@ -59,6 +104,11 @@ int Chunk::getVoxelInstCount() const
 	return static_cast<int>(this->voxelInsts.size());
 }
 
+int Chunk::getActiveVoxelInstCount() const
+{
+	return static_cast<int>(this->activeVoxelInstIndices.size());
+}
+
 VoxelInstance &Chunk::getVoxelInst(int index)
 {
 	DebugAssertIndex(this->voxelInsts, index);
@@ -208,9 +258,136 @@ void Chunk::getAdjacentVoxelDefs(const VoxelInt3 &voxel, const VoxelDefinition *
 	tryWriteVoxelDef(westVoxel, outWest);
 }
 
+bool Chunk::isEmptyVoxel(VoxelID id) const
+{
+	DebugAssert(id < this->voxelDefs.size());
+	return this->voxelDefs[id].type == ArenaTypes::VoxelType::None;
+}
+
+void Chunk::updateVoxelTraits(SNInt x, int y, WEInt z)
+{
+	const VoxelDefinition &voxelDef = this->getVoxelDef(this->getVoxel(x, y, z));
+	const ArenaTypes::VoxelType voxelType = voxelDef.type;
+
+	bool isSolid;
+	if (voxelType == ArenaTypes::VoxelType::None)
+	{
+		isSolid = false;
+	}
+	else if (voxelType == ArenaTypes::VoxelType::TransparentWall)
+	{
+		isSolid = voxelDef.transparentWall.collider;
+	}
+	else if (voxelType == ArenaTypes::VoxelType::Edge)
+	{
+		// @todo: treat as edge, not solid voxel.
+		isSolid = voxelDef.edge.collider;
+	}
+	else if (voxelType == ArenaTypes::VoxelType::Wall)
+	{
+		// Level change walls are entered to trigger the transition.
+		const TransitionDefinition *transitionDef = this->tryGetTransition(VoxelInt3(x, y, z));
+		isSolid = (transitionDef == nullptr) || (transitionDef->getType() != TransitionType::LevelChange);
+	}
+	else
+	{
+		isSolid = true;
+	}
+
+	const std::array<bool, VOXEL_TRAIT_TYPE_COUNT> hasTraits =
+	{
+		voxelType == ArenaTypes::VoxelType::None,
+		isSolid,
+		voxelType == ArenaTypes::VoxelType::Floor,
+		voxelType == ArenaTypes::VoxelType::Chasm,
+		voxelType == ArenaTypes::VoxelType::Door
+	};
+
+	const int traitWordIndex = x + (y * Chunk::WIDTH);
+	const uint64_t traitBit = static_cast<uint64_t>(1) << z;
+	for (int i = 0; i < VOXEL_TRAIT_TYPE_COUNT; i++)
+	{
+		uint64_t &traitWord = this->voxelTraitBits[i][traitWordIndex];
+		traitWord = hasTraits[i] ? (traitWord | traitBit) : (traitWord & ~traitBit);
+	}
+
+	// Citizens only care about the ground and the voxel above it.
+	if (y <= 1)
+	{
+		this->updateCitizenSpawnVoxel(x, z);
+	}
+}
+
+void Chunk::updateCitizenSpawnVoxel(SNInt x, WEInt z)
+{
+	const bool isSpawnVoxel = (this->getHeight() >= 2) &&
+		this->hasVoxelTrait(x, 1, z, VoxelTraitType::Empty) &&
+		this->hasVoxelTrait(x, 0, z, VoxelTraitType::Floor);
+
+	int &spawnVoxelIndex = this->citizenSpawnVoxelIndices[x + (z * Chunk::WIDTH)];
+	const bool isInList = spawnVoxelIndex >= 0;
+	if (isSpawnVoxel && !isInList)
+	{
+		spawnVoxelIndex = static_cast<int>(this->citizenSpawnVoxels.size());
+		this->citizenSpawnVoxels.emplace_back(x, z);
+	}
+	else if (!isSpawnVoxel && isInList)
+	{
+		// Swap-remove, keeping the moved column's index valid.
+		const VoxelInt2 lastSpawnVoxel = this->citizenSpawnVoxels.back();
+		this->citizenSpawnVoxels[spawnVoxelIndex] = lastSpawnVoxel;
+		this->citizenSpawnVoxelIndices[lastSpawnVoxel.x + (lastSpawnVoxel.y * Chunk::WIDTH)] = spawnVoxelIndex;
+		this->citizenSpawnVoxels.pop_back();
+		spawnVoxelIndex = -1;
+	}
+}
+
+void Chunk::getDirtyEdges(bool *outNorth, bool *outEast, bool *outSouth, bool *outWest) const
+{
+	*outNorth = this->dirtyNorthEdge;
+	*outEast = this->dirtyEastEdge;
+	*outSouth = this->dirtySouthEdge;
+	*outWest = this->dirtyWestEdge;
+}
+
 void Chunk::setVoxel(SNInt x, int y, WEInt z, VoxelID value)
 {
+	if (this->voxels.get(x, y, z) == value)
+	{
+		return;
+	}
+
 	this->voxels.set(x, y, z, value);
+	this->updateVoxelTraits(x, y, z);
+
+	// Keep the column's non-empty span up to date.
+	const int columnHeight = this->getColumnHeight(x, z);
+	if (!this->isEmptyVoxel(value))
+	{
+		if (y >= columnHeight)
+		{
+			this->columnHeights.set(x, z, static_cast<uint8_t>(y + 1));
+		}
+	}
+	else if (y == (columnHeight - 1))
+	{
+		// The top of the column was emptied. Find the next highest non-empty voxel.
+		int newColumnHeight = y;
+		while ((newColumnHeight > 0) && this->isEmptyVoxel(this->voxels.get(x, newColumnHeight - 1, z)))
+		{
+			newColumnHeight--;
+		}
+
+		this->columnHeights.set(x, z, static_cast<uint8_t>(newColumnHeight));
+	}
+
+	// Edges follow the same orientation as the chunk manager's perimeter (north is X=0, east is Z=0). A change
+	// one voxel inside an edge also dirties it, since a context-sensitive edge voxel next to it (i.e., a chasm)
+	// can only be recalculated correctly by the chunk manager, which sees the adjacent chunk.
+	this->dirtyNorthEdge |= (x <= 1);
+	this->dirtyEastEdge |= (z <= 1);
+	this->dirtySouthEdge |= (x >= (Chunk::WIDTH - 2));
+	this->dirtyWestEdge |= (z >= (Chunk::DEPTH - 2));
 }
 
 bool Chunk::tryAddVoxelDef(VoxelDefinition &&voxelDef, Chunk::VoxelID *outID)
@@ -233,7 +410,41 @@ bool Chunk::tryAddVoxelDef(VoxelDefinition &&voxelDef, Chunk::VoxelID *outID)
 
 void Chunk::addVoxelInst(VoxelInstance &&voxelInst)
 {
+	const bool isAnimating = voxelInst.isAnimating();
 	this->voxelInsts.emplace_back(std::move(voxelInst));
+
+	if (isAnimating)
+	{
+		// Always the highest index so the active list stays sorted.
+		const int index = static_cast<int>(this->voxelInsts.size()) - 1;
+		this->activeVoxelInstIndices.push_back(index);
+	}
+}
+
+void Chunk::eraseVoxelInst(int index)
+{
+	DebugAssertIndex(this->voxelInsts, index);
+	this->voxelInsts.erase(this->voxelInsts.begin() + index);
+
+	// Shift active indices above the erased one down to match. They are sorted, so the walk can stop
+	// at the first lower index.
+	for (int i = static_cast<int>(this->activeVoxelInstIndices.size()) - 1; i >= 0; i--)
+	{
+		int &activeIndex = this->activeVoxelInstIndices[i];
+		if (activeIndex > index)
+		{
+			activeIndex--;
+		}
+		else
+		{
+			if (activeIndex == index)
+			{
+				this->activeVoxelInstIndices.erase(this->activeVoxelInstIndices.begin() + i);
+			}
+
+			break;
+		}
+	}
 }
 
 Chunk::TransitionID Chunk::addTransition(TransitionDefinition &&transition)
@@ -275,6 +486,12 @@ void Chunk::addTransitionPosition(Chunk::TransitionID id, const VoxelInt3 &voxel
 {
 	DebugAssert(this->transitionDefIndices.find(voxel) == this->transitionDefIndices.end());
 	this->transitionDefIndices.emplace(voxel, id);
+
+	// Level change transitions make walls enterable.
+	if (this->isValidVoxel(voxel.x, voxel.y, voxel.z))
+	{
+		this->updateVoxelTraits(voxel.x, voxel.y, voxel.z);
+	}
 }
 
 void Chunk::addTriggerPosition(Chunk::TriggerID id, const VoxelInt3 &voxel)
@@ -306,6 +523,26 @@ void Chunk::removeVoxelDef(VoxelID id)
 	DebugAssert(id < this->voxelDefs.size());
 	this->voxelDefs[id] = VoxelDefinition();
 	this->activeVoxelDefs[id] = false;
+
+	// Any voxels still pointing at the definition are air now.
+	for (WEInt z = 0; z < this->voxels.getDepth(); z++)
+	{
+		for (int y = 0; y < this->voxels.getHeight(); y++)
+		{
+			for (SNInt x = 0; x < this->voxels.getWidth(); x++)
+			{
+				if (this->voxels.get(x, y, z) == id)
+				{
+					this->updateVoxelTraits(x, y, z);
+				}
+			}
+		}
+	}
+
+	this->dirtyNorthEdge = true;
+	this->dirtyEastEdge = true;
+	this->dirtySouthEdge = true;
+	this->dirtyWestEdge = true;
 }
 
 void Chunk::removeVoxelInst(const VoxelInt3 &voxel, VoxelInstance::Type type)
@@ -316,18 +553,36 @@ void Chunk::removeVoxelInst(const VoxelInt3 &voxel, VoxelInstance::Type type)
 		if ((voxelInst.getX() == voxel.x) && (voxelInst.getY() == voxel.y) &&
 			(voxelInst.getZ() == voxel.z) && (voxelInst.getType() == type))
 		{
-			this->voxelInsts.erase(this->voxelInsts.begin() + i);
+			this->eraseVoxelInst(i);
 			break;
 		}
 	}
 }
 
+void Chunk::clearDirtyEdges()
+{
+	this->dirtyNorthEdge = false;
+	this->dirtyEastEdge = false;
+	this->dirtySouthEdge = false;
+	this->dirtyWestEdge = false;
+}
+
 void Chunk::clear()
 {
 	this->voxels.clear();
+	this->columnHeights.clear();
+
+	for (std::vector<uint64_t> &traitBits : this->voxelTraitBits)
+	{
+		traitBits.clear();
+	}
+
+	this->citizenSpawnVoxels.clear();
+	this->citizenSpawnVoxelIndices.clear();
 	this->voxelDefs.fill(VoxelDefinition());
 	this->activeVoxelDefs.fill(false);
 	this->voxelInsts.clear();
+	this->activeVoxelInstIndices.clear();
 	this->transitionDefs.clear();
 	this->triggerDefs.clear();
 	this->lockDefs.clear();
@@ -337,6 +592,7 @@ void Chunk::clear()
 	this->lockDefIndices.clear();
 	this->buildingNameIndices.clear();
 	this->coord = ChunkInt2();
+	this->clearDirtyEdges();
 }
 
 void Chunk::handleVoxelInstState(VoxelInstance &voxelInst, const CoordDouble3 &playerCoord,
@@ -463,7 +719,7 @@ void Chunk::handleVoxelInstFinished(VoxelInstance &voxelInst, double ceilingScal
 	}
 }
 
-void Chunk::handleVoxelInstPostFinished(VoxelInstance &voxelInst, std::vector<int> &voxelInstIndicesToDestroy)
+void Chunk::handleVoxelInstPostFinished(const VoxelInstance &voxelInst, std::vector<int> &voxelInstIndicesToDestroy)
 {
 	if (voxelInst.getType() == VoxelInstance::Type::Fading)
 	{
@@ -556,12 +812,14 @@ void Chunk::update(double dt, const CoordDouble3 &playerCoord, double ceilingSca
 {
 	// Need to track voxel instances that finished fading because certain ones are converted to
 	// context-sensitive voxels on completion.
-	std::vector<VoxelInstance*> voxelInstsToPostFinish;
+	std::vector<int> voxelInstIndicesToPostFinish;
 	std::vector<int> voxelInstIndicesToDestroy;
 
-	for (int i = static_cast<int>(this->voxelInsts.size()) - 1; i >= 0; i--)
+	// Only animating voxel instances are updated. Voxel instance indices stay valid until the erase at the end.
+	for (int i = static_cast<int>(this->activeVoxelInstIndices.size()) - 1; i >= 0; i--)
 	{
-		VoxelInstance &voxelInst = this->voxelInsts[i];
+		const int voxelInstIndex = this->activeVoxelInstIndices[i];
+		VoxelInstance &voxelInst = this->voxelInsts[voxelInstIndex];
 		voxelInst.update(dt);
 
 		// See if the voxel instance is in a state that needs more behavior to be run, or if it can be
@@ -580,16 +838,18 @@ void Chunk::update(double dt, const CoordDouble3 &playerCoord, double ceilingSca
 			const bool needsPostShutdown = (voxelInst.getType() == VoxelInstance::Type::Fading) && (voxelInst.getY() == 0);
 			if (needsPostShutdown)
 			{
-				voxelInstsToPostFinish.push_back(&voxelInst);
+				voxelInstIndicesToPostFinish.push_back(voxelInstIndex);
 			}
 
-			voxelInstIndicesToDestroy.push_back(i);
+			voxelInstIndicesToDestroy.push_back(voxelInstIndex);
 		}
 	}
 
-	for (VoxelInstance *voxelInst : voxelInstsToPostFinish)
+	for (const int voxelInstIndex : voxelInstIndicesToPostFinish)
 	{
-		this->handleVoxelInstPostFinished(*voxelInst, voxelInstIndicesToDestroy);
+		// Copy since adding chasm voxel instances during post-finish can reallocate the voxel instances.
+		const VoxelInstance voxelInst = this->voxelInsts[voxelInstIndex];
+		this->handleVoxelInstPostFinished(voxelInst, voxelInstIndicesToDestroy);
 	}
 
 	// Due to the extra complexity of adjacent voxel instances potentially being destroyed during post-finish,
@@ -601,6 +861,6 @@ void Chunk::update(double dt, const CoordDouble3 &playerCoord, double ceilingSca
 	for (int i = static_cast<int>(voxelInstIndicesToDestroy.size()) - 1; i >= 0; i--)
 	{
 		const int index = voxelInstIndicesToDestroy[i];
-		this->voxelInsts.erase(this->voxelInsts.begin() + index);
+		this->eraseVoxelInst(index);
 	}
 }
@@ -17,10 +17,13 @@
 #include "TriggerDefinition.h"
 #include "VoxelDefinition.h"
 #include "VoxelInstance.h"
+#include "VoxelTraitType.h"
 #include "VoxelUtils.h"
 #include "../Math/MathUtils.h"
 
+#include "components/utilities/Buffer2D.h"
 #include "components/utilities/Buffer3D.h"
+#include "components/utilities/BufferView.h"
 
 // A 3D set of voxels for a portion of the game world.
 
@@ -44,9 +47,24 @@ private:
 
 	static constexpr int MAX_VOXEL_DEFS = 1 << BITS_PER_VOXEL;
 
+	static constexpr int VOXEL_TRAIT_TYPE_COUNT = 5;
+
 	// Indices into voxel definitions.
 	Buffer3D<VoxelID> voxels;
 
+	// Span of each XZ voxel column from the bottom up to and including its highest non-empty voxel. Everything
+	// at or above this height is empty, so the renderer's ray caster can skip that part of the column.
+	Buffer2D<uint8_t> columnHeights;
+
+	// One bit per voxel for each voxel trait type, updated whenever a voxel changes. Each floor is a run of
+	// WIDTH words with one bit per Z voxel.
+	std::array<std::vector<uint64_t>, VOXEL_TRAIT_TYPE_COUNT> voxelTraitBits;
+
+	// XZ voxels citizens can spawn in (floor with air above), in no particular order. Each column's index
+	// into the list is kept so a column can be removed in constant time when its voxels change.
+	std::vector<VoxelInt2> citizenSpawnVoxels;
+	std::vector<int> citizenSpawnVoxelIndices; // -1 if the column isn't in the list.
+
 	// Voxel definitions, pointed to by voxel IDs. If the associated bool is true,
 	// the voxel data is in use by the voxel grid.
 	std::array<VoxelDefinition, MAX_VOXEL_DEFS> voxelDefs;
@@ -55,6 +73,10 @@ private:
 	// Instance data for voxels that are uniquely different in some way.
 	std::vector<VoxelInstance> voxelInsts;
 
+	// Indices of voxel instances that animate (doors, fading voxels), in ascending order. Only these are
+	// visited each frame; idle instances like chasms cost nothing until something else changes them.
+	std::vector<int> activeVoxelInstIndices;
+
 	// Chunk decorators.
 	std::vector<TransitionDefinition> transitionDefs;
 	std::vector<TriggerDefinition> triggerDefs;
@@ -72,12 +94,28 @@ private:
 	// Chunk coordinates in the world.
 	ChunkInt2 coord;
 
+	// Whether any voxels on each chunk edge have changed since the chunk manager last looked at them.
+	// Context-sensitive voxels (i.e., chasms) in adjacent chunks only need updating when an edge is dirty.
+	bool dirtyNorthEdge, dirtyEastEdge, dirtySouthEdge, dirtyWestEdge;
+
 	// Gets the voxel definitions adjacent to a voxel. Useful with context-sensitive voxels like chasms.
 	// This is slightly different than the chunk manager's version since it is chunk-independent (but as
 	// a result, voxels on a chunk edge must be updated by the chunk manager).
 	void getAdjacentVoxelDefs(const VoxelInt3 &voxel, const VoxelDefinition **outNorth,
 		const VoxelDefinition **outEast, const VoxelDefinition **outSouth, const VoxelDefinition **outWest);
 
+	// Returns whether the voxel ID points to a voxel definition with nothing in it (i.e., air).
+	bool isEmptyVoxel(VoxelID id) const;
+
+	// Recalculates the voxel trait bits of a voxel from its voxel definition and decorators.
+	void updateVoxelTraits(SNInt x, int y, WEInt z);
+
+	// Adds or removes the XZ column from the citizen spawn voxels depending on its current voxels.
+	void updateCitizenSpawnVoxel(SNInt x, WEInt z);
+
+	// Removes the voxel instance at the given index and keeps active voxel instance indices valid.
+	void eraseVoxelInst(int index);
+
 	// Runs any voxel instance behavior based on its current state that cannot be done by the voxel
 	// instance itself.
 	void handleVoxelInstState(VoxelInstance &voxelInst, const CoordDouble3 &playerCoord,
@@ -89,12 +127,13 @@ private:
 	// Runs any context-sensitive voxel instance shutdown behavior based on its current state that cannot
 	// be done by the voxel instance itself. This is needed because of chasms that rely on adjacent voxels
 	// for which chasm faces they have.
-	void handleVoxelInstPostFinished(VoxelInstance &voxelInst, std::vector<int> &voxelInstIndicesToDestroy);
+	void handleVoxelInstPostFinished(const VoxelInstance &voxelInst, std::vector<int> &voxelInstIndicesToDestroy);
 public:
 	static constexpr VoxelID AIR_VOXEL_ID = 0;
 	static constexpr SNInt WIDTH = ChunkUtils::CHUNK_DIM;
 	static constexpr WEInt DEPTH = WIDTH;
 	static_assert(MathUtils::isPowerOf2(WIDTH));
+	static_assert(DEPTH == 64); // One voxel trait word per X row.
 
 	void init(const ChunkInt2 &coord, int height);
 
@@ -109,6 +148,19 @@ public:
 	// Gets the voxel ID at the given coordinate.
 	VoxelID getVoxel(SNInt x, int y, WEInt z) const;
 
+	// Returns whether the voxel has the given trait. The voxel must be in the chunk.
+	bool hasVoxelTrait(SNInt x, int y, WEInt z, VoxelTraitType traitType) const;
+
+	// Gets every XZ voxel a citizen can currently spawn in.
+	BufferView<const VoxelInt2> getCitizenSpawnVoxels() const;
+
+	// Gets the number of voxels in the given XZ column up to and including the highest non-empty one.
+	// Zero if the column is entirely empty.
+	int getColumnHeight(SNInt x, WEInt z) const;
+
+	// Gets the number of bytes used by the chunk's voxel storage, for profiling.
+	int getVoxelByteCount() const;
+
 	// Gets the number of active voxel definitions.
 	int getVoxelDefCount() const;
 
@@ -118,6 +170,9 @@ public:
 	// Gets the number of voxel instances.
 	int getVoxelInstCount() const;
 
+	// Gets the number of voxel instances that are updated every frame.
+	int getActiveVoxelInstCount() const;
+
 	// Gets the voxel instance at the given index.
 	VoxelInstance &getVoxelInst(int index);
 	const VoxelInstance &getVoxelInst(int index) const;
@@ -133,7 +188,10 @@ public:
 	const std::string *tryGetBuildingName(const VoxelInt3 &voxel) const;
 	const DoorDefinition *tryGetDoor(const VoxelInt3 &voxel) const;
 
-	// Sets the voxel at the given coordinate.
+	// Gets which chunk edges have had voxel changes since the dirty edges were last cleared.
+	void getDirtyEdges(bool *outNorth, bool *outEast, bool *outSouth, bool *outWest) const;
+
+	// Sets the voxel at the given coordinate. Marks the chunk edge dirty if the voxel is on or next to one.
 	void setVoxel(SNInt x, int y, WEInt z, VoxelID id);
 
 	// Attempts to add a voxel definition and returns its assigned ID.
@@ -156,17 +214,21 @@ public:
 	void addBuildingNamePosition(BuildingNameID id, const VoxelInt3 &voxel);
 	void addDoorPosition(DoorID id, const VoxelInt3 &voxel);
 
-	// Removes a voxel definition so its corresponding voxel ID can be reused.
+	// Removes a voxel definition so its corresponding voxel ID can be reused. Marks all chunk edges dirty
+	// since any edge voxel might have been using it.
 	void removeVoxelDef(VoxelID id);
 
 	// Removes a certain type of voxel instance from the given voxel (if any). This might be useful when
 	// updating a chunk edge due to adjacent chunks changing.
 	void removeVoxelInst(const VoxelInt3 &voxel, VoxelInstance::Type type);
 
+	// Resets the dirty state of all chunk edges. Intended for the chunk manager once it has handled them.
+	void clearDirtyEdges();
+
 	// Clears all chunk state.
 	void clear();
 
-	// Animates the chunk's voxels by delta time.
+	// Animates the chunk's active voxel instances by delta time.
 	// @todo: evaluate just letting the chunk manager do all the updating for the chunk, due to the complexity
 	// of chunk perimeters, etc. and the amount of almost-identical problem solving between the two classes.
 	void update(double dt, const CoordDouble3 &playerCoord, double ceilingScale, AudioManager &audioManager);
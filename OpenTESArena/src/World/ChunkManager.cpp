@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <chrono>
 #include <unordered_map>
 
 #include "ChunkManager.h"
@@ -52,6 +53,12 @@ namespace
 			levelPosition.z - static_cast<WEDouble>(chunkStartZ));
 	}
 
+	// Gets the level-space chunk that a chunk's level offset points to, for looking up bucketed placements.
+	ChunkInt2 GetLevelChunk(const LevelInt2 &levelOffset)
+	{
+		return ChunkInt2(levelOffset.x / ChunkUtils::CHUNK_DIM, levelOffset.y / ChunkUtils::CHUNK_DIM);
+	}
+
 	Chunk::VoxelID LevelVoxelDefIdToChunkVoxelID(LevelDefinition::VoxelDefID voxelDefID)
 	{
 		// Chunks have an air definition at ID 0.
@@ -59,6 +66,17 @@ namespace
 	}
 }
 
+void ChunkManager::ChunkEdgeUpdate::init(const ChunkInt2 &chunk, const VoxelInt2 &direction)
+{
+	this->chunk = chunk;
+	this->direction = direction;
+}
+
+ChunkManager::ChunkManager()
+{
+	this->voxelInstUpdateTime = 0.0;
+}
+
 int ChunkManager::getChunkCount() const
 {
 	return static_cast<int>(this->activeChunks.size());
@@ -119,6 +137,33 @@ int ChunkManager::getCenterChunkIndex() const
 	return *index;
 }
 
+void ChunkManager::getVoxelInstCounts(int *outTotalCount, int *outActiveCount) const
+{
+	*outTotalCount = 0;
+	*outActiveCount = 0;
+	for (const ChunkPtr &chunkPtr : this->activeChunks)
+	{
+		*outTotalCount += chunkPtr->getVoxelInstCount();
+		*outActiveCount += chunkPtr->getActiveVoxelInstCount();
+	}
+}
+
+double ChunkManager::getVoxelInstUpdateTime() const
+{
+	return this->voxelInstUpdateTime;
+}
+
+int ChunkManager::getVoxelByteCount() const
+{
+	int byteCount = 0;
+	for (const ChunkPtr &chunkPtr : this->activeChunks)
+	{
+		byteCount += chunkPtr->getVoxelByteCount();
+	}
+
+	return byteCount;
+}
+
 void ChunkManager::getAdjacentVoxelDefs(const CoordInt3 &coord, const VoxelDefinition **outNorth,
 	const VoxelDefinition **outEast, const VoxelDefinition **outSouth, const VoxelDefinition **outWest)
 {
@@ -184,6 +229,9 @@ void ChunkManager::recycleChunk(int index)
 	chunkPtr->clear();
 	this->chunkPool.emplace_back(std::move(chunkPtr));
 	this->activeChunks.erase(this->activeChunks.begin() + index);
+
+	// Adjacent chunks no longer have anything on this side of their edge.
+	this->queueChunkPerimeterUpdates(coord, true, true, true, true);
 }
 
 void ChunkManager::populateChunkVoxelDefs(Chunk &chunk, const LevelInfoDefinition &levelInfoDefinition)
@@ -245,10 +293,17 @@ void ChunkManager::populateChunkDecorators(Chunk &chunk, const LevelDefinition &
 	GetChunkWritingRanges(levelOffset, levelDefinition.getWidth(), levelDefinition.getHeight(),
 		levelDefinition.getDepth(), &startX, &startY, &startZ, &endX, &endY, &endZ);
 
+	// Only look at placements in the part of the level this chunk overlaps.
+	const LevelDefinition::ChunkPlacementDefs *chunkPlacementDefs =
+		levelDefinition.tryGetChunkPlacementDefs(GetLevelChunk(levelOffset));
+	if (chunkPlacementDefs == nullptr)
+	{
+		return;
+	}
+
 	// Add transitions.
-	for (int i = 0; i < levelDefinition.getTransitionPlacementDefCount(); i++)
+	for (const LevelDefinition::TransitionPlacementDef &placementDef : chunkPlacementDefs->transitionPlacementDefs)
 	{
-		const LevelDefinition::TransitionPlacementDef &placementDef = levelDefinition.getTransitionPlacementDef(i);
 		const TransitionDefinition &transitionDef = levelInfoDefinition.getTransitionDef(placementDef.id);
 		
 		std::optional<Chunk::TransitionID> transitionID;
@@ -268,9 +323,8 @@ void ChunkManager::populateChunkDecorators(Chunk &chunk, const LevelDefinition &
 	}
 
 	// Add triggers.
-	for (int i = 0; i < levelDefinition.getTriggerPlacementDefCount(); i++)
+	for (const LevelDefinition::TriggerPlacementDef &placementDef : chunkPlacementDefs->triggerPlacementDefs)
 	{
-		const LevelDefinition::TriggerPlacementDef &placementDef = levelDefinition.getTriggerPlacementDef(i);
 		const TriggerDefinition &triggerDef = levelInfoDefinition.getTriggerDef(placementDef.id);
 		
 		std::optional<Chunk::TriggerID> triggerID;
@@ -290,9 +344,8 @@ void ChunkManager::populateChunkDecorators(Chunk &chunk, const LevelDefinition &
 	}
 
 	// Add locks.
-	for (int i = 0; i < levelDefinition.getLockPlacementDefCount(); i++)
+	for (const LevelDefinition::LockPlacementDef &placementDef : chunkPlacementDefs->lockPlacementDefs)
 	{
-		const LevelDefinition::LockPlacementDef &placementDef = levelDefinition.getLockPlacementDef(i);
 		const LockDefinition &lockDef = levelInfoDefinition.getLockDef(placementDef.id);
 		
 		std::optional<Chunk::LockID> lockID;
@@ -313,9 +366,8 @@ void ChunkManager::populateChunkDecorators(Chunk &chunk, const LevelDefinition &
 
 	// Add building names (note that this doesn't apply to wilderness chunks because they can't rely on just the
 	// level definition; they also need the chunk coordinate).
-	for (int i = 0; i < levelDefinition.getBuildingNamePlacementDefCount(); i++)
+	for (const LevelDefinition::BuildingNamePlacementDef &placementDef : chunkPlacementDefs->buildingNamePlacementDefs)
 	{
-		const LevelDefinition::BuildingNamePlacementDef &placementDef = levelDefinition.getBuildingNamePlacementDef(i);
 		const std::string &buildingName = levelInfoDefinition.getBuildingName(placementDef.id);
 		
 		std::optional<Chunk::BuildingNameID> buildingNameID;
@@ -335,9 +387,8 @@ void ChunkManager::populateChunkDecorators(Chunk &chunk, const LevelDefinition &
 	}
 
 	// Add door definitions.
-	for (int i = 0; i < levelDefinition.getDoorPlacementDefCount(); i++)
+	for (const LevelDefinition::DoorPlacementDef &placementDef : chunkPlacementDefs->doorPlacementDefs)
 	{
-		const LevelDefinition::DoorPlacementDef &placementDef = levelDefinition.getDoorPlacementDef(i);
 		const DoorDefinition &doorDef = levelInfoDefinition.getDoorDef(placementDef.id);
 
 		std::optional<Chunk::DoorID> doorID;
@@ -455,9 +506,15 @@ void ChunkManager::populateChunkEntities(Chunk &chunk, const LevelDefinition &le
 	// Cosmetic random (initial creature sound timing, etc.).
 	Random random;
 
-	for (int i = 0; i < levelDefinition.getEntityPlacementDefCount(); i++)
+	// Only look at placements in the part of the level this chunk overlaps.
+	const LevelDefinition::ChunkPlacementDefs *chunkPlacementDefs =
+		levelDefinition.tryGetChunkPlacementDefs(GetLevelChunk(levelOffset));
+	const int entityPlacementDefCount = (chunkPlacementDefs != nullptr) ?
+		static_cast<int>(chunkPlacementDefs->entityPlacementDefs.size()) : 0;
+
+	for (int i = 0; i < entityPlacementDefCount; i++)
 	{
-		const LevelDefinition::EntityPlacementDef &placementDef = levelDefinition.getEntityPlacementDef(i);
+		const LevelDefinition::EntityPlacementDef &placementDef = chunkPlacementDefs->entityPlacementDefs[i];
 		const LevelDefinition::EntityDefID levelEntityDefID = placementDef.id;
 		const EntityDefinition &entityDef = levelInfoDefinition.getEntityDef(levelEntityDefID);
 		const EntityDefinition::Type entityDefType = entityDef.getType();
@@ -488,7 +545,7 @@ void ChunkManager::populateChunkEntities(Chunk &chunk, const LevelDefinition &le
 		}
 	}
 
-	if (citizenGenInfo.has_value())
+	if (citizenGenInfo.has_value() && (chunk.getCitizenSpawnVoxels().getCount() > 0))
 	{
 		// Spawn citizens if the total active limit has not been reached.
 		const int currentCitizenCount = CitizenUtils::getCitizenCount(entityManager);
@@ -662,7 +719,54 @@ void ChunkManager::populateChunk(int index, const ChunkInt2 &chunkCoord, const s
 	}
 }
 
-void ChunkManager::updateChunkPerimeter(Chunk &chunk)
+void ChunkManager::queueChunkEdgeUpdate(const ChunkInt2 &chunkCoord, const VoxelInt2 &direction)
+{
+	const auto iter = std::find_if(this->edgeUpdates.begin(), this->edgeUpdates.end(),
+		[&chunkCoord, &direction](const ChunkEdgeUpdate &edgeUpdate)
+	{
+		return (edgeUpdate.chunk == chunkCoord) && (edgeUpdate.direction == direction);
+	});
+
+	if (iter == this->edgeUpdates.end())
+	{
+		ChunkEdgeUpdate edgeUpdate;
+		edgeUpdate.init(chunkCoord, direction);
+		this->edgeUpdates.emplace_back(std::move(edgeUpdate));
+	}
+}
+
+void ChunkManager::queueChunkPerimeterUpdates(const ChunkInt2 &chunkCoord, bool north, bool east, bool south, bool west)
+{
+	auto queueEdge = [this, &chunkCoord](const VoxelInt2 &direction)
+	{
+		// The adjacent chunk's touching edge faces the opposite direction.
+		const ChunkInt2 adjacentChunkCoord = chunkCoord + direction;
+		this->queueChunkEdgeUpdate(chunkCoord, direction);
+		this->queueChunkEdgeUpdate(adjacentChunkCoord, -direction);
+	};
+
+	if (north)
+	{
+		queueEdge(VoxelUtils::North);
+	}
+
+	if (east)
+	{
+		queueEdge(VoxelUtils::East);
+	}
+
+	if (south)
+	{
+		queueEdge(VoxelUtils::South);
+	}
+
+	if (west)
+	{
+		queueEdge(VoxelUtils::West);
+	}
+}
+
+void ChunkManager::updateChunkEdge(Chunk &chunk, const VoxelInt2 &direction)
 {
 	auto tryUpdateChasm = [this, &chunk](const VoxelInt3 &voxel)
 	{
@@ -717,27 +821,27 @@ void ChunkManager::updateChunkPerimeter(Chunk &chunk)
 		}
 	};
 
-	// North and south sides.
-	for (WEInt z = 0; z < Chunk::DEPTH; z++)
+	if ((direction == VoxelUtils::North) || (direction == VoxelUtils::South))
 	{
-		for (int y = 0; y < chunk.getHeight(); y++)
+		const SNInt x = (direction == VoxelUtils::North) ? 0 : (Chunk::WIDTH - 1);
+		for (WEInt z = 0; z < Chunk::DEPTH; z++)
 		{
-			constexpr SNInt northX = 0;
-			constexpr SNInt southX = Chunk::WIDTH - 1;
-			tryUpdateChasm(VoxelInt3(northX, y, z));
-			tryUpdateChasm(VoxelInt3(southX, y, z));
+			for (int y = 0; y < chunk.getHeight(); y++)
+			{
+				tryUpdateChasm(VoxelInt3(x, y, z));
+			}
 		}
 	}
-
-	// East and west sides, minus the corners.
-	for (SNInt x = 1; x < (Chunk::WIDTH - 1); x++)
+	else
 	{
-		for (int y = 0; y < chunk.getHeight(); y++)
+		DebugAssert((direction == VoxelUtils::East) || (direction == VoxelUtils::West));
+		const WEInt z = (direction == VoxelUtils::East) ? 0 : (Chunk::DEPTH - 1);
+		for (SNInt x = 0; x < Chunk::WIDTH; x++)
 		{
-			constexpr WEInt eastZ = 0;
-			constexpr WEInt westZ = Chunk::DEPTH - 1;
-			tryUpdateChasm(VoxelInt3(x, y, eastZ));
-			tryUpdateChasm(VoxelInt3(x, y, westZ));
+			for (int y = 0; y < chunk.getHeight(); y++)
+			{
+				tryUpdateChasm(VoxelInt3(x, y, z));
+			}
 		}
 	}
 }
@@ -781,6 +885,12 @@ void ChunkManager::update(double dt, const ChunkInt2 &centerChunk, const CoordDo
 				const int spawnIndex = this->spawnChunk();
 				this->populateChunk(spawnIndex, coord, activeLevelIndex, mapDefinition, entityGenInfo, citizenGenInfo,
 					entityDefLibrary, binaryAssetLibrary, textureManager, entityManager);
+
+				// The new chunk's entire perimeter and its neighbors' touching edges need updating since
+				// chunks adjacent to it might not have existed when its voxel instances were populated.
+				Chunk &spawnedChunk = this->getChunk(spawnIndex);
+				spawnedChunk.clearDirtyEdges();
+				this->queueChunkPerimeterUpdates(coord, true, true, true, true);
 			}
 		}
 	}
@@ -790,6 +900,7 @@ void ChunkManager::update(double dt, const ChunkInt2 &centerChunk, const CoordDo
 	this->chunkPool.clear();
 
 	// Update each chunk so they can animate/destroy faded voxel instances, etc..
+	const auto voxelInstStartTime = std::chrono::high_resolution_clock::now();
 	const int activeChunkCount = static_cast<int>(this->activeChunks.size());
 	for (int i = 0; i < activeChunkCount; i++)
 	{
@@ -797,13 +908,33 @@ void ChunkManager::update(double dt, const ChunkInt2 &centerChunk, const CoordDo
 		chunkPtr->update(dt, playerCoord, ceilingScale, audioManager);
 	}
 
-	// Update chunk perimeters in case voxels on the edge of one chunk affect context-sensitive
-	// voxels in adjacent chunks. It might be a little inefficient to do this every frame, but
-	// it easily handles cases of modified voxels on a chunk edge, and it is only updating chunk
-	// edges, so it should be very fast.
+	const auto voxelInstEndTime = std::chrono::high_resolution_clock::now();
+	this->voxelInstUpdateTime = static_cast<double>((voxelInstEndTime - voxelInstStartTime).count()) /
+		static_cast<double>(std::nano::den);
+
+	// Queue perimeter updates for chunk edges that had voxel changes this frame.
 	for (int i = 0; i < activeChunkCount; i++)
 	{
 		ChunkPtr &chunkPtr = this->activeChunks[i];
-		this->updateChunkPerimeter(*chunkPtr);
+		bool northDirty, eastDirty, southDirty, westDirty;
+		chunkPtr->getDirtyEdges(&northDirty, &eastDirty, &southDirty, &westDirty);
+		if (northDirty || eastDirty || southDirty || westDirty)
+		{
+			this->queueChunkPerimeterUpdates(chunkPtr->getCoord(), northDirty, eastDirty, southDirty, westDirty);
+			chunkPtr->clearDirtyEdges();
+		}
 	}
+
+	// Update chunk perimeters in case voxels on the edge of one chunk affect context-sensitive voxels
+	// in adjacent chunks. Only queued edges are visited, so nothing is done when no edges changed.
+	for (const ChunkEdgeUpdate &edgeUpdate : this->edgeUpdates)
+	{
+		Chunk *chunkPtr = this->tryGetChunk(edgeUpdate.chunk);
+		if (chunkPtr != nullptr)
+		{
+			this->updateChunkEdge(*chunkPtr, edgeUpdate.direction);
+		}
+	}
+
+	this->edgeUpdates.clear();
 }
@@ -32,10 +32,26 @@ class ChunkManager
 private:
 	using ChunkPtr = std::unique_ptr<Chunk>;
 
+	// A chunk edge whose context-sensitive voxels need updating because voxels changed along it or the
+	// adjacent chunk was spawned/recycled.
+	struct ChunkEdgeUpdate
+	{
+		ChunkInt2 chunk;
+		VoxelInt2 direction; // Side of the chunk (i.e., VoxelUtils::North for the X=0 edge).
+
+		void init(const ChunkInt2 &chunk, const VoxelInt2 &direction);
+	};
+
 	std::vector<ChunkPtr> chunkPool;
 	std::vector<ChunkPtr> activeChunks;
 	ChunkInt2 centerChunk;
 
+	// Chunk edges queued for a perimeter update at the end of this frame. Empty when nothing changed.
+	std::vector<ChunkEdgeUpdate> edgeUpdates;
+
+	// Time spent updating chunk voxel instances last frame, for profiling.
+	double voxelInstUpdateTime;
+
 	// Gets the voxel definitions adjacent to a voxel. Useful with context-sensitive voxels like chasms.
 	void getAdjacentVoxelDefs(const CoordInt3 &coord, const VoxelDefinition **outNorth,
 		const VoxelDefinition **outEast, const VoxelDefinition **outSouth, const VoxelDefinition **outWest);
@@ -80,10 +96,19 @@ private:
 		const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
 		TextureManager &textureManager, EntityManager &entityManager);
 
-	// Updates context-sensitive voxels (such as chasms) on a chunk's perimeter that may be affected by
-	// adjacent chunks.
-	void updateChunkPerimeter(Chunk &chunk);
+	// Queues a chunk edge for updating if it isn't already queued.
+	void queueChunkEdgeUpdate(const ChunkInt2 &chunkCoord, const VoxelInt2 &direction);
+
+	// Queues the given edges of a chunk plus the touching edges of its adjacent chunks, since a change on
+	// either side of a chunk border can affect context-sensitive voxels on both sides.
+	void queueChunkPerimeterUpdates(const ChunkInt2 &chunkCoord, bool north, bool east, bool south, bool west);
+
+	// Updates context-sensitive voxels (such as chasms) on one edge of a chunk's perimeter that may be
+	// affected by the adjacent chunk.
+	void updateChunkEdge(Chunk &chunk, const VoxelInt2 &direction);
 public:
+	ChunkManager();
+
 	int getChunkCount() const;
 	Chunk &getChunk(int index);
 	const Chunk &getChunk(int index) const;
@@ -96,6 +121,15 @@ public:
 	// Index of the chunk all other active chunks surround.
 	int getCenterChunkIndex() const;
 
+	// Gets the total number of voxel instances and how many of them are animating in active chunks.
+	void getVoxelInstCounts(int *outTotalCount, int *outActiveCount) const;
+
+	// Gets how long the last update took to animate voxel instances in all active chunks.
+	double getVoxelInstUpdateTime() const;
+
+	// Gets the number of bytes used by voxel storage in all active chunks.
+	int getVoxelByteCount() const;
+
 	// Updates the chunk manager with the given chunk as the current center of the game world. This invalidates
 	// all active chunk references and they must be looked up again. The 'updateChunkStates' parameter tells
 	// whether to update the real-time state of chunks; this should be false during the frame of a level's
@@ -1,7 +1,60 @@
 #include <algorithm>
+#include <limits>
 
 #include "LevelDefinition.h"
 
+namespace
+{
+	// Adds a position to the placement definition with the given ID, creating it if needed.
+	template <typename PlacementDefType, typename PositionType>
+	void AddPlacementPosition(std::vector<PlacementDefType> &placementDefs, int id, const PositionType &position)
+	{
+		const auto iter = std::find_if(placementDefs.begin(), placementDefs.end(),
+			[id](const PlacementDefType &def)
+		{
+			return def.id == id;
+		});
+
+		if (iter != placementDefs.end())
+		{
+			std::vector<PositionType> &positions = iter->positions;
+			positions.push_back(position);
+		}
+		else
+		{
+			placementDefs.emplace_back(id, std::vector<PositionType> { position });
+		}
+	}
+
+	ChunkInt2 GetLevelChunk(const LevelInt2 &voxel)
+	{
+		const CoordInt2 coord = VoxelUtils::levelVoxelToCoord(voxel);
+		return coord.chunk;
+	}
+
+	template <typename PlacementDefType>
+	int GetPlacementDefsByteCount(const std::vector<PlacementDefType> &placementDefs)
+	{
+		size_t byteCount = placementDefs.capacity() * sizeof(PlacementDefType);
+		for (const PlacementDefType &placementDef : placementDefs)
+		{
+			byteCount += placementDef.positions.capacity() * sizeof(*placementDef.positions.data());
+		}
+
+		return static_cast<int>(byteCount);
+	}
+
+	int GetChunkPlacementDefsByteCount(const LevelDefinition::ChunkPlacementDefs &chunkDefs)
+	{
+		return GetPlacementDefsByteCount(chunkDefs.entityPlacementDefs) +
+			GetPlacementDefsByteCount(chunkDefs.lockPlacementDefs) +
+			GetPlacementDefsByteCount(chunkDefs.triggerPlacementDefs) +
+			GetPlacementDefsByteCount(chunkDefs.transitionPlacementDefs) +
+			GetPlacementDefsByteCount(chunkDefs.buildingNamePlacementDefs) +
+			GetPlacementDefsByteCount(chunkDefs.doorPlacementDefs);
+	}
+}
+
 LevelDefinition::EntityPlacementDef::EntityPlacementDef(EntityDefID id, std::vector<LevelDouble3> &&positions)
 	: positions(std::move(positions))
 {
@@ -63,12 +116,37 @@ WEInt LevelDefinition::getDepth() const
 
 LevelDefinition::VoxelDefID LevelDefinition::getVoxel(SNInt x, int y, WEInt z) const
 {
-	return this->voxels.get(x, y, z);
+	return static_cast<VoxelDefID>(this->voxels.get(x, y, z));
 }
 
 void LevelDefinition::setVoxel(SNInt x, int y, WEInt z, VoxelDefID voxel)
 {
-	this->voxels.set(x, y, z, voxel);
+	DebugAssert(voxel >= 0);
+	DebugAssert(voxel <= std::numeric_limits<VoxelDefStorageID>::max());
+	this->voxels.set(x, y, z, static_cast<VoxelDefStorageID>(voxel));
+}
+
+int LevelDefinition::getVoxelByteCount() const
+{
+	const int voxelCount = this->voxels.getWidth() * this->voxels.getHeight() * this->voxels.getDepth();
+	return voxelCount * static_cast<int>(sizeof(VoxelDefStorageID));
+}
+
+int LevelDefinition::getPlacementByteCount() const
+{
+	int byteCount = GetPlacementDefsByteCount(this->entityPlacementDefs) +
+		GetPlacementDefsByteCount(this->lockPlacementDefs) +
+		GetPlacementDefsByteCount(this->triggerPlacementDefs) +
+		GetPlacementDefsByteCount(this->transitionPlacementDefs) +
+		GetPlacementDefsByteCount(this->buildingNamePlacementDefs) +
+		GetPlacementDefsByteCount(this->doorPlacementDefs);
+
+	for (const auto &pair : this->chunkPlacementDefs)
+	{
+		byteCount += static_cast<int>(sizeof(pair)) + GetChunkPlacementDefsByteCount(pair.second);
+	}
+
+	return byteCount;
 }
 
 int LevelDefinition::getEntityPlacementDefCount() const
@@ -137,116 +215,57 @@ const LevelDefinition::DoorPlacementDef &LevelDefinition::getDoorPlacementDef(in
 	return this->doorPlacementDefs[index];
 }
 
+const LevelDefinition::ChunkPlacementDefs *LevelDefinition::tryGetChunkPlacementDefs(const ChunkInt2 &chunk) const
+{
+	const auto iter = this->chunkPlacementDefs.find(chunk);
+	return (iter != this->chunkPlacementDefs.end()) ? &iter->second : nullptr;
+}
+
 void LevelDefinition::addEntity(EntityDefID id, const LevelDouble3 &position)
 {
-	const auto iter = std::find_if(this->entityPlacementDefs.begin(), this->entityPlacementDefs.end(),
-		[id](const EntityPlacementDef &def)
-	{
-		return def.id == id;
-	});
+	AddPlacementPosition(this->entityPlacementDefs, id, position);
 
-	if (iter != this->entityPlacementDefs.end())
-	{
-		std::vector<LevelDouble3> &positions = iter->positions;
-		positions.push_back(position);
-	}
-	else
-	{
-		this->entityPlacementDefs.emplace_back(id, std::vector<LevelDouble3> { position });
-	}
+	const LevelInt2 voxel = VoxelUtils::pointToVoxel(LevelDouble2(position.x, position.z));
+	ChunkPlacementDefs &chunkDefs = this->chunkPlacementDefs[GetLevelChunk(voxel)];
+	AddPlacementPosition(chunkDefs.entityPlacementDefs, id, position);
 }
 
 void LevelDefinition::addLock(LockDefID id, const LevelInt3 &position)
 {
-	const auto iter = std::find_if(this->lockPlacementDefs.begin(), this->lockPlacementDefs.end(),
-		[id](const LockPlacementDef &def)
-	{
-		return def.id == id;
-	});
+	AddPlacementPosition(this->lockPlacementDefs, id, position);
 
-	if (iter != this->lockPlacementDefs.end())
-	{
-		std::vector<LevelInt3> &positions = iter->positions;
-		positions.push_back(position);
-	}
-	else
-	{
-		this->lockPlacementDefs.emplace_back(id, std::vector<LevelInt3> { position });
-	}
+	ChunkPlacementDefs &chunkDefs = this->chunkPlacementDefs[GetLevelChunk(LevelInt2(position.x, position.z))];
+	AddPlacementPosition(chunkDefs.lockPlacementDefs, id, position);
 }
 
 void LevelDefinition::addTrigger(TriggerDefID id, const LevelInt3 &position)
 {
-	const auto iter = std::find_if(this->triggerPlacementDefs.begin(), this->triggerPlacementDefs.end(),
-		[id](const TriggerPlacementDef &def)
-	{
-		return def.id == id;
-	});
+	AddPlacementPosition(this->triggerPlacementDefs, id, position);
 
-	if (iter != this->triggerPlacementDefs.end())
-	{
-		std::vector<LevelInt3> &positions = iter->positions;
-		positions.push_back(position);
-	}
-	else
-	{
-		this->triggerPlacementDefs.emplace_back(id, std::vector<LevelInt3> { position });
-	}
+	ChunkPlacementDefs &chunkDefs = this->chunkPlacementDefs[GetLevelChunk(LevelInt2(position.x, position.z))];
+	AddPlacementPosition(chunkDefs.triggerPlacementDefs, id, position);
 }
 
 void LevelDefinition::addTransition(TransitionDefID id, const LevelInt3 &position)
 {
-	const auto iter = std::find_if(this->transitionPlacementDefs.begin(), this->transitionPlacementDefs.end(),
-		[id](const TransitionPlacementDef &def)
-	{
-		return def.id == id;
-	});
+	AddPlacementPosition(this->transitionPlacementDefs, id, position);
 
-	if (iter != this->transitionPlacementDefs.end())
-	{
-		std::vector<LevelInt3> &positions = iter->positions;
-		positions.push_back(position);
-	}
-	else
-	{
-		this->transitionPlacementDefs.emplace_back(id, std::vector<LevelInt3> { position });
-	}
+	ChunkPlacementDefs &chunkDefs = this->chunkPlacementDefs[GetLevelChunk(LevelInt2(position.x, position.z))];
+	AddPlacementPosition(chunkDefs.transitionPlacementDefs, id, position);
 }
 
 void LevelDefinition::addBuildingName(BuildingNameID id, const LevelInt3 &position)
 {
-	const auto iter = std::find_if(this->buildingNamePlacementDefs.begin(),
-		this->buildingNamePlacementDefs.end(), [id](const BuildingNamePlacementDef &def)
-	{
-		return def.id == id;
-	});
+	AddPlacementPosition(this->buildingNamePlacementDefs, id, position);
 
-	if (iter != this->buildingNamePlacementDefs.end())
-	{
-		std::vector<LevelInt3> &positions = iter->positions;
-		positions.push_back(position);
-	}
-	else
-	{
-		this->buildingNamePlacementDefs.emplace_back(id, std::vector<LevelInt3> { position });
-	}
+	ChunkPlacementDefs &chunkDefs = this->chunkPlacementDefs[GetLevelChunk(LevelInt2(position.x, position.z))];
+	AddPlacementPosition(chunkDefs.buildingNamePlacementDefs, id, position);
 }
 
 void LevelDefinition::addDoor(DoorDefID id, const LevelInt3 &position)
 {
-	const auto iter = std::find_if(this->doorPlacementDefs.begin(),
-		this->doorPlacementDefs.end(), [id](const DoorPlacementDef &def)
-	{
-		return def.id == id;
-	});
+	AddPlacementPosition(this->doorPlacementDefs, id, position);
 
-	if (iter != this->doorPlacementDefs.end())
-	{
-		std::vector<LevelInt3> &positions = iter->positions;
-		positions.push_back(position);
-	}
-	else
-	{
-		this->doorPlacementDefs.emplace_back(id, std::vector<LevelInt3> { position });
-	}
+	ChunkPlacementDefs &chunkDefs = this->chunkPlacementDefs[GetLevelChunk(LevelInt2(position.x, position.z))];
+	AddPlacementPosition(chunkDefs.doorPlacementDefs, id, position);
 }
@@ -2,6 +2,7 @@
 #define LEVEL_DEFINITION_H
 
 #include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #include "VoxelUtils.h"
@@ -72,14 +73,33 @@ public:
 
 		DoorPlacementDef(DoorDefID id, std::vector<LevelInt3> &&positions);
 	};
+
+	// Placement definitions for the part of the level covered by one chunk, bucketed at generation time
+	// so spawning a chunk doesn't have to look at every placement in the level.
+	struct ChunkPlacementDefs
+	{
+		std::vector<EntityPlacementDef> entityPlacementDefs;
+		std::vector<LockPlacementDef> lockPlacementDefs;
+		std::vector<TriggerPlacementDef> triggerPlacementDefs;
+		std::vector<TransitionPlacementDef> transitionPlacementDefs;
+		std::vector<BuildingNamePlacementDef> buildingNamePlacementDefs;
+		std::vector<DoorPlacementDef> doorPlacementDefs;
+	};
 private:
-	Buffer3D<VoxelDefID> voxels;
+	// Voxel definition IDs are stored narrower than VoxelDefID since a level info definition never has anywhere
+	// near 2^16 voxel definitions, and level voxels are mostly air.
+	using VoxelDefStorageID = uint16_t;
+
+	Buffer3D<VoxelDefStorageID> voxels;
 	std::vector<EntityPlacementDef> entityPlacementDefs;
 	std::vector<LockPlacementDef> lockPlacementDefs;
 	std::vector<TriggerPlacementDef> triggerPlacementDefs;
 	std::vector<TransitionPlacementDef> transitionPlacementDefs;
 	std::vector<BuildingNamePlacementDef> buildingNamePlacementDefs;
 	std::vector<DoorPlacementDef> doorPlacementDefs;
+
+	// Same placements as above but grouped by the level-space chunk they're in.
+	std::unordered_map<ChunkInt2, ChunkPlacementDefs> chunkPlacementDefs;
 public:
 	void init(SNInt width, int height, WEInt depth);
 
@@ -90,6 +110,12 @@ public:
 	VoxelDefID getVoxel(SNInt x, int y, WEInt z) const;
 	void setVoxel(SNInt x, int y, WEInt z, VoxelDefID voxel);
 
+	// Gets the number of bytes used by the level's voxel storage, for profiling.
+	int getVoxelByteCount() const;
+
+	// Gets the approximate number of bytes used by placement definitions, including the per-chunk copies.
+	int getPlacementByteCount() const;
+
 	int getEntityPlacementDefCount() const;
 	const EntityPlacementDef &getEntityPlacementDef(int index) const;
 	int getLockPlacementDefCount() const;
@@ -103,6 +129,10 @@ public:
 	int getDoorPlacementDefCount() const;
 	const DoorPlacementDef &getDoorPlacementDef(int index) const;
 
+	// Gets the placements in the given level-space chunk (i.e., level voxel divided by chunk dimensions),
+	// or null if nothing is placed there.
+	const ChunkPlacementDefs *tryGetChunkPlacementDefs(const ChunkInt2 &chunk) const;
+
 	void addEntity(EntityDefID id, const LevelDouble3 &position);
 	void addLock(LockDefID id, const LevelInt3 &position);
 	void addTrigger(TriggerDefID id, const LevelInt3 &position);
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <chrono>
 
 #include "ArenaWeatherUtils.h"
 #include "LevelInstance.h"
@@ -13,6 +14,7 @@
 #include "../Rendering/RendererUtils.h"
 
 #include "components/debug/Debug.h"
+#include "components/utilities/String.h"
 
 LevelInstance::LevelInstance()
 {
@@ -54,7 +56,11 @@ bool LevelInstance::trySetActive(const WeatherDefinition &weatherDef, bool night
 	const std::optional<CitizenUtils::CitizenGenInfo> &citizenGenInfo,
 	TextureManager &textureManager, Renderer &renderer)
 {
-	renderer.clearTextures();
+	const auto startTime = std::chrono::high_resolution_clock::now();
+	const RendererSystem3D::TextureResidencyStats prevTextureStats = renderer.getTextureResidencyStats();
+
+	// Textures from the previous level stay resident so any shared with this level are reused.
+	renderer.releaseLevelTextures();
 
 	// Loaded texture caches for tracking which textures have already been loaded in the renderer.
 	// @todo: eventually don't preload all textures and let the chunk manager load them for new chunks.
@@ -73,10 +79,8 @@ bool LevelInstance::trySetActive(const WeatherDefinition &weatherDef, bool night
 			for (int j = 0; j < voxelDef.getTextureAssetReferenceCount(); j++)
 			{
 				const TextureAssetReference &textureAssetRef = voxelDef.getTextureAssetReference(j);
-				const auto cacheIter = std::find(loadedVoxelTextures.begin(), loadedVoxelTextures.end(), textureAssetRef);
-				if (cacheIter == loadedVoxelTextures.end())
+				if (loadedVoxelTextures.insert(textureAssetRef).second)
 				{
-					loadedVoxelTextures.push_back(textureAssetRef);
 					if (!renderer.tryCreateVoxelTexture(textureAssetRef, textureManager))
 					{
 						DebugLogError("Couldn't create renderer voxel texture for \"" + textureAssetRef.filename + "\".");
@@ -103,19 +107,11 @@ bool LevelInstance::trySetActive(const WeatherDefinition &weatherDef, bool night
 					{
 						const EntityAnimationDefinition::Keyframe &keyframe = keyframeList.getKeyframe(k);
 						const TextureAssetReference &textureAssetRef = keyframe.getTextureAssetRef();
-						const auto cacheIter = std::find_if(loadedEntityTextures.begin(), loadedEntityTextures.end(),
-							[&textureAssetRef, flipped, reflective](const RendererUtils::LoadedEntityTextureEntry &cacheEntry)
-						{
-							return (cacheEntry.textureAssetRef == textureAssetRef) && (cacheEntry.flipped == flipped) &&
-								(cacheEntry.reflective == reflective);
-						});
+						RendererUtils::LoadedEntityTextureEntry loadedEntityTextureEntry;
+						loadedEntityTextureEntry.init(TextureAssetReference(textureAssetRef), flipped, reflective);
 
-						if (cacheIter == loadedEntityTextures.end())
+						if (loadedEntityTextures.insert(std::move(loadedEntityTextureEntry)).second)
 						{
-							RendererUtils::LoadedEntityTextureEntry loadedEntityTextureEntry;
-							loadedEntityTextureEntry.init(TextureAssetReference(textureAssetRef), flipped, reflective);
-							loadedEntityTextures.emplace_back(std::move(loadedEntityTextureEntry));
-							
 							if (!renderer.tryCreateEntityTexture(textureAssetRef, flipped, reflective, textureManager))
 							{
 								DebugLogError("Couldn't create renderer entity texture for \"" + textureAssetRef.filename + "\".");
@@ -214,6 +210,18 @@ bool LevelInstance::trySetActive(const WeatherDefinition &weatherDef, bool night
 	renderer.setFogDistance(weatherDef.getFogDistance());
 	renderer.setNightLightsActive(nightLightsAreActive, palette);
 
+	const auto endTime = std::chrono::high_resolution_clock::now();
+	const double activateTime = static_cast<double>((endTime - startTime).count()) / static_cast<double>(std::nano::den);
+	const RendererSystem3D::TextureResidencyStats textureStats = renderer.getTextureResidencyStats();
+	const int hitCount = textureStats.hitCount - prevTextureStats.hitCount;
+	const int missCount = textureStats.missCount - prevTextureStats.missCount;
+	const int requestCount = hitCount + missCount;
+	const double hitPercent = (requestCount > 0) ? (100.0 * static_cast<double>(hitCount) / static_cast<double>(requestCount)) : 0.0;
+	DebugLog("Activated level in " + String::fixedPrecision(activateTime * 1000.0, 2) + "ms (textures: " +
+		std::to_string(hitCount) + " reused, " + std::to_string(missCount) + " created, " +
+		String::fixedPrecision(hitPercent, 1) + "% hit rate, " + std::to_string(textureStats.residentCount) +
+		" resident).");
+
 	return true;
 }
 
@@ -230,4 +238,9 @@ void LevelInstance::update(double dt, Game &game, const CoordDouble3 &playerCoor
 		audioManager, this->entityManager);
 
 	this->entityManager.tick(game, dt);
+
+	// Entity visibility is shared by rendering this frame and ray casts next frame.
+	const CoordDouble2 playerCoordXZ(playerCoord.chunk, VoxelDouble2(playerCoord.point.x, playerCoord.point.z));
+	this->entityManager.updateVisibilityStates(playerCoordXZ, this->ceilingScale, this->chunkManager,
+		entityDefLibrary);
 }
@@ -7,6 +7,11 @@ void LockDefinition::LeveledLockDef::init(int lockLevel)
 	this->lockLevel = lockLevel;
 }
 
+int LockDefinition::LeveledLockDef::getLockLevel() const
+{
+	return this->lockLevel;
+}
+
 void LockDefinition::KeyLockDef::init()
 {
 	// Do nothing.
@@ -16,6 +16,8 @@ public:
 		int lockLevel;
 	public:
 		void init(int lockLevel);
+
+		int getLockLevel() const;
 	};
 
 	class KeyLockDef
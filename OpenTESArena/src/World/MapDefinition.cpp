@@ -68,6 +68,21 @@ const MapGeneration::WildChunkBuildingNameInfo *MapDefinition::Wild::getBuilding
 	return (iter != this->buildingNameInfos.end()) ? &(*iter) : nullptr;
 }
 
+const Buffer2D<int> &MapDefinition::Wild::getLevelDefIndices() const
+{
+	return this->levelDefIndices;
+}
+
+uint32_t MapDefinition::Wild::getFallbackSeed() const
+{
+	return this->fallbackSeed;
+}
+
+const std::vector<MapGeneration::WildChunkBuildingNameInfo> &MapDefinition::Wild::getBuildingNameInfos() const
+{
+	return this->buildingNameInfos;
+}
+
 void MapDefinition::init(MapType mapType)
 {
 	this->mapType = mapType;
@@ -520,6 +535,30 @@ bool MapDefinition::initWild(const MapGeneration::WildGenInfo &generationInfo,
 	return true;
 }
 
+void MapDefinition::initFromParts(MapType mapType, Buffer<LevelDefinition> &&levels,
+	Buffer<LevelInfoDefinition> &&levelInfos, Buffer<int> &&levelInfoMappings, Buffer<SkyDefinition> &&skies,
+	Buffer<SkyInfoDefinition> &&skyInfos, Buffer<int> &&skyMappings, Buffer<int> &&skyInfoMappings,
+	Buffer<LevelDouble2> &&startPoints, const std::optional<int> &startLevelIndex, const Interior &interior,
+	Wild &&wild)
+{
+	DebugAssert(levelInfoMappings.getCount() == levels.getCount());
+	DebugAssert(skyMappings.getCount() == levels.getCount());
+	DebugAssert(skyInfoMappings.getCount() == skies.getCount());
+
+	this->init(mapType);
+	this->levels = std::move(levels);
+	this->levelInfos = std::move(levelInfos);
+	this->levelInfoMappings = std::move(levelInfoMappings);
+	this->skies = std::move(skies);
+	this->skyInfos = std::move(skyInfos);
+	this->skyMappings = std::move(skyMappings);
+	this->skyInfoMappings = std::move(skyInfoMappings);
+	this->startPoints = std::move(startPoints);
+	this->startLevelIndex = startLevelIndex;
+	this->interior = interior;
+	this->wild = std::move(wild);
+}
+
 const std::optional<int> &MapDefinition::getStartLevelIndex() const
 {
 	return this->startLevelIndex;
@@ -567,6 +606,41 @@ const SkyInfoDefinition &MapDefinition::getSkyInfoForSky(int skyIndex) const
 	return this->skyInfos.get(skyInfoIndex);
 }
 
+int MapDefinition::getLevelInfoCount() const
+{
+	return this->levelInfos.getCount();
+}
+
+const LevelInfoDefinition &MapDefinition::getLevelInfo(int index) const
+{
+	return this->levelInfos.get(index);
+}
+
+int MapDefinition::getLevelInfoIndexForLevel(int levelIndex) const
+{
+	return this->levelInfoMappings.get(levelIndex);
+}
+
+int MapDefinition::getSkyCount() const
+{
+	return this->skies.getCount();
+}
+
+int MapDefinition::getSkyInfoCount() const
+{
+	return this->skyInfos.getCount();
+}
+
+const SkyInfoDefinition &MapDefinition::getSkyInfo(int index) const
+{
+	return this->skyInfos.get(index);
+}
+
+int MapDefinition::getSkyInfoIndexForSky(int skyIndex) const
+{
+	return this->skyInfoMappings.get(skyIndex);
+}
+
 MapType MapDefinition::getMapType() const
 {
 	return this->mapType;
@@ -583,3 +657,15 @@ const MapDefinition::Wild &MapDefinition::getWild() const
 	DebugAssert(this->mapType == MapType::Wilderness);
 	return this->wild;
 }
+
+int MapDefinition::getByteCount() const
+{
+	int byteCount = static_cast<int>(sizeof(*this));
+	for (int i = 0; i < this->levels.getCount(); i++)
+	{
+		const LevelDefinition &levelDef = this->levels.get(i);
+		byteCount += levelDef.getVoxelByteCount() + levelDef.getPlacementByteCount();
+	}
+
+	return byteCount;
+}
@@ -62,6 +62,10 @@ public:
 
 		int getLevelDefIndex(const ChunkInt2 &chunk) const;
 		const MapGeneration::WildChunkBuildingNameInfo *getBuildingNameInfo(const ChunkInt2 &chunk) const;
+
+		const Buffer2D<int> &getLevelDefIndices() const;
+		uint32_t getFallbackSeed() const;
+		const std::vector<MapGeneration::WildChunkBuildingNameInfo> &getBuildingNameInfos() const;
 	};
 private:
 	Buffer<LevelDefinition> levels;
@@ -116,6 +120,12 @@ public:
 		const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
 		TextureManager &textureManager);
 
+	// Initializes from previously generated parts, i.e., when read from the on-disk map definition cache.
+	void initFromParts(MapType mapType, Buffer<LevelDefinition> &&levels, Buffer<LevelInfoDefinition> &&levelInfos,
+		Buffer<int> &&levelInfoMappings, Buffer<SkyDefinition> &&skies, Buffer<SkyInfoDefinition> &&skyInfos,
+		Buffer<int> &&skyMappings, Buffer<int> &&skyInfoMappings, Buffer<LevelDouble2> &&startPoints,
+		const std::optional<int> &startLevelIndex, const Interior &interior, Wild &&wild);
+
 	// Gets the initial level index for the map (if any).
 	const std::optional<int> &getStartLevelIndex() const;
 
@@ -138,9 +148,22 @@ public:
 	const SkyDefinition &getSky(int index) const;
 	const SkyInfoDefinition &getSkyInfoForSky(int skyIndex) const;
 
+	// Level infos and sky infos can be shared, so these are for visiting each one once.
+	int getLevelInfoCount() const;
+	const LevelInfoDefinition &getLevelInfo(int index) const;
+	int getLevelInfoIndexForLevel(int levelIndex) const;
+	int getSkyCount() const;
+	int getSkyInfoCount() const;
+	const SkyInfoDefinition &getSkyInfo(int index) const;
+	int getSkyInfoIndexForSky(int skyIndex) const;
+
 	MapType getMapType() const;
 	const Interior &getInterior() const;
 	const Wild &getWild() const;
+
+	// Gets the approximate number of bytes held by the map's levels. Voxels and placements make up nearly
+	// all of a generated map; level infos and skies are small in comparison.
+	int getByteCount() const;
 };
 
 #endif
@@ -0,0 +1,262 @@
+#include <algorithm>
+
+#include "MapDefinition.h"
+#include "MapDefinitionCache.h"
+
+#include "components/debug/Debug.h"
+
+namespace
+{
+	void AppendKeyValue(std::string &key, uint32_t value)
+	{
+		key += std::to_string(value);
+		key += ',';
+	}
+
+	void AppendKeyValue(std::string &key, const std::string &value)
+	{
+		key += value;
+		key += ',';
+	}
+
+	void AppendSkyGenInfo(std::string &key, const SkyGeneration::ExteriorSkyGenInfo &skyGenInfo)
+	{
+		const WeatherDefinition &weatherDef = skyGenInfo.weatherDef;
+		const WeatherDefinition::Type weatherType = weatherDef.getType();
+		AppendKeyValue(key, static_cast<uint32_t>(skyGenInfo.climateType));
+		AppendKeyValue(key, static_cast<uint32_t>(weatherType));
+
+		if (weatherType == WeatherDefinition::Type::Overcast)
+		{
+			AppendKeyValue(key, weatherDef.getOvercast().heavyFog);
+		}
+		else if (weatherType == WeatherDefinition::Type::Rain)
+		{
+			AppendKeyValue(key, weatherDef.getRain().thunderstorm);
+		}
+		else if (weatherType == WeatherDefinition::Type::Snow)
+		{
+			const WeatherDefinition::SnowDefinition &snowDef = weatherDef.getSnow();
+			AppendKeyValue(key, snowDef.overcast);
+			AppendKeyValue(key, snowDef.heavyFog);
+		}
+
+		AppendKeyValue(key, static_cast<uint32_t>(skyGenInfo.currentDay));
+		AppendKeyValue(key, static_cast<uint32_t>(skyGenInfo.starCount));
+		AppendKeyValue(key, skyGenInfo.citySeed);
+		AppendKeyValue(key, skyGenInfo.skySeed);
+		AppendKeyValue(key, skyGenInfo.provinceHasAnimatedLand);
+	}
+}
+
+void MapDefinitionCache::Entry::init(std::string &&key, std::shared_ptr<const MapDefinition> &&mapDefinition,
+	double generationTime)
+{
+	this->key = std::move(key);
+	this->mapDefinition = std::move(mapDefinition);
+	this->generationTime = generationTime;
+	this->byteCount = this->mapDefinition->getByteCount();
+}
+
+MapDefinitionCache::MapDefinitionCache()
+{
+	this->byteCount = 0;
+	this->hitCount = 0;
+	this->missCount = 0;
+}
+
+std::string MapDefinitionCache::makeInteriorKey(const MapGeneration::InteriorGenInfo &interiorGenInfo)
+{
+	std::string key;
+	const MapGeneration::InteriorGenInfo::Type type = interiorGenInfo.getType();
+	if (type == MapGeneration::InteriorGenInfo::Type::Prefab)
+	{
+		const MapGeneration::InteriorGenInfo::Prefab &prefab = interiorGenInfo.getPrefab();
+		key = "Prefab:";
+		AppendKeyValue(key, prefab.mifName);
+		AppendKeyValue(key, static_cast<uint32_t>(prefab.interiorType));
+		AppendKeyValue(key, prefab.rulerIsMale.has_value() ? (*prefab.rulerIsMale ? 1 : 0) : 2);
+	}
+	else if (type == MapGeneration::InteriorGenInfo::Type::Dungeon)
+	{
+		const MapGeneration::InteriorGenInfo::Dungeon &dungeon = interiorGenInfo.getDungeon();
+		key = "Dungeon:";
+		AppendKeyValue(key, dungeon.dungeonDef.dungeonSeed);
+		AppendKeyValue(key, static_cast<uint32_t>(dungeon.dungeonDef.widthChunkCount));
+		AppendKeyValue(key, static_cast<uint32_t>(dungeon.dungeonDef.heightChunkCount));
+		AppendKeyValue(key, dungeon.isArtifactDungeon);
+	}
+	else
+	{
+		DebugNotImplementedMsg(std::to_string(static_cast<int>(type)));
+	}
+
+	return key;
+}
+
+std::string MapDefinitionCache::makeCityKey(const MapGeneration::CityGenInfo &cityGenInfo,
+	const SkyGeneration::ExteriorSkyGenInfo &skyGenInfo)
+{
+	std::string key = "City:";
+	AppendKeyValue(key, cityGenInfo.mifName);
+	AppendKeyValue(key, cityGenInfo.cityTypeName);
+	AppendKeyValue(key, static_cast<uint32_t>(cityGenInfo.cityType));
+	AppendKeyValue(key, cityGenInfo.citySeed);
+	AppendKeyValue(key, cityGenInfo.rulerSeed);
+	AppendKeyValue(key, static_cast<uint32_t>(cityGenInfo.raceID));
+	AppendKeyValue(key, cityGenInfo.isPremade);
+	AppendKeyValue(key, cityGenInfo.coastal);
+	AppendKeyValue(key, cityGenInfo.rulerIsMale);
+	AppendKeyValue(key, cityGenInfo.palaceIsMainQuestDungeon);
+
+	const Buffer<uint8_t> &reservedBlocks = cityGenInfo.reservedBlocks;
+	for (int i = 0; i < reservedBlocks.getCount(); i++)
+	{
+		AppendKeyValue(key, reservedBlocks.get(i));
+	}
+
+	key += ';';
+
+	if (cityGenInfo.mainQuestTempleOverride.has_value())
+	{
+		const auto &templeOverride = *cityGenInfo.mainQuestTempleOverride;
+		AppendKeyValue(key, static_cast<uint32_t>(templeOverride.modelIndex));
+		AppendKeyValue(key, static_cast<uint32_t>(templeOverride.suffixIndex));
+		AppendKeyValue(key, static_cast<uint32_t>(templeOverride.menuNamesIndex));
+	}
+
+	key += ';';
+	AppendKeyValue(key, static_cast<uint32_t>(cityGenInfo.blockStartPosX));
+	AppendKeyValue(key, static_cast<uint32_t>(cityGenInfo.blockStartPosY));
+	AppendKeyValue(key, static_cast<uint32_t>(cityGenInfo.cityBlocksPerSide));
+	AppendSkyGenInfo(key, skyGenInfo);
+	return key;
+}
+
+std::string MapDefinitionCache::makeWildKey(const MapGeneration::WildGenInfo &wildGenInfo,
+	const SkyGeneration::ExteriorSkyGenInfo &skyGenInfo)
+{
+	DebugAssert(wildGenInfo.cityDef != nullptr);
+	const LocationDefinition::CityDefinition &cityDef = *wildGenInfo.cityDef;
+
+	std::string key = "Wild:";
+	AppendKeyValue(key, std::string(cityDef.mapFilename));
+	AppendKeyValue(key, cityDef.citySeed);
+	AppendKeyValue(key, cityDef.wildSeed);
+	AppendKeyValue(key, cityDef.rulerSeed);
+	AppendKeyValue(key, cityDef.provinceSeed);
+	AppendKeyValue(key, static_cast<uint32_t>(cityDef.type));
+	AppendKeyValue(key, static_cast<uint32_t>(cityDef.climateType));
+	AppendKeyValue(key, cityDef.rulerIsMale);
+	AppendKeyValue(key, cityDef.palaceIsMainQuestDungeon);
+	AppendKeyValue(key, wildGenInfo.fallbackSeed);
+
+	const Buffer2D<ArenaWildUtils::WildBlockID> &wildBlockIDs = wildGenInfo.wildBlockIDs;
+	for (int y = 0; y < wildBlockIDs.getHeight(); y++)
+	{
+		for (int x = 0; x < wildBlockIDs.getWidth(); x++)
+		{
+			AppendKeyValue(key, wildBlockIDs.get(x, y));
+		}
+	}
+
+	key += ';';
+	AppendSkyGenInfo(key, skyGenInfo);
+	return key;
+}
+
+int MapDefinitionCache::getEntryCount() const
+{
+	return static_cast<int>(this->entries.size());
+}
+
+int MapDefinitionCache::getByteCount() const
+{
+	return this->byteCount;
+}
+
+int MapDefinitionCache::getHitCount() const
+{
+	return this->hitCount;
+}
+
+int MapDefinitionCache::getMissCount() const
+{
+	return this->missCount;
+}
+
+bool MapDefinitionCache::contains(const std::string &key) const
+{
+	const auto iter = std::find_if(this->entries.begin(), this->entries.end(),
+		[&key](const Entry &entry)
+	{
+		return entry.key == key;
+	});
+
+	return iter != this->entries.end();
+}
+
+std::shared_ptr<const MapDefinition> MapDefinitionCache::tryGet(const std::string &key, double *outGenerationTime)
+{
+	const auto iter = std::find_if(this->entries.begin(), this->entries.end(),
+		[&key](const Entry &entry)
+	{
+		return entry.key == key;
+	});
+
+	if (iter == this->entries.end())
+	{
+		this->missCount++;
+		return nullptr;
+	}
+
+	// Move to the back as the most recently used.
+	std::rotate(iter, iter + 1, this->entries.end());
+	this->hitCount++;
+
+	const Entry &entry = this->entries.back();
+	*outGenerationTime = entry.generationTime;
+	return entry.mapDefinition;
+}
+
+void MapDefinitionCache::add(std::string &&key, std::shared_ptr<const MapDefinition> &&mapDefinition,
+	double generationTime)
+{
+	DebugAssert(mapDefinition != nullptr);
+
+	const auto iter = std::find_if(this->entries.begin(), this->entries.end(),
+		[&key](const Entry &entry)
+	{
+		return entry.key == key;
+	});
+
+	if (iter != this->entries.end())
+	{
+		this->byteCount -= iter->byteCount;
+		this->entries.erase(iter);
+	}
+
+	Entry entry;
+	entry.init(std::move(key), std::move(mapDefinition), generationTime);
+
+	// Evict the least recently used entries until the new one fits.
+	int evictCount = 0;
+	while ((evictCount < static_cast<int>(this->entries.size())) &&
+		((this->byteCount + entry.byteCount) > MapDefinitionCache::MAX_BYTES))
+	{
+		this->byteCount -= this->entries[evictCount].byteCount;
+		evictCount++;
+	}
+
+	this->entries.erase(this->entries.begin(), this->entries.begin() + evictCount);
+	this->byteCount += entry.byteCount;
+	this->entries.emplace_back(std::move(entry));
+}
+
+void MapDefinitionCache::clear()
+{
+	this->entries.clear();
+	this->byteCount = 0;
+	this->hitCount = 0;
+	this->missCount = 0;
+}
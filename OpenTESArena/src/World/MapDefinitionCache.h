@@ -0,0 +1,67 @@
+#ifndef MAP_DEFINITION_CACHE_H
+#define MAP_DEFINITION_CACHE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MapGeneration.h"
+#include "SkyGeneration.h"
+
+// Keeps recently generated map definitions so revisiting a location doesn't have to regenerate it from
+// .MIF/.RMD data. Map generation is deterministic, so entries are keyed by all of their generation inputs.
+// Entries only live for the current session; MapDefinitionFile keeps generated maps between sessions.
+// Memory is bounded by the size of the cached definitions, which covers
+// prefetched maps too since they're added here when finished.
+
+class MapDefinition;
+
+class MapDefinitionCache
+{
+private:
+	struct Entry
+	{
+		std::string key;
+		std::shared_ptr<const MapDefinition> mapDefinition;
+		double generationTime; // Milliseconds it took to generate, for measuring time saved by a cache hit.
+		int byteCount;
+
+		void init(std::string &&key, std::shared_ptr<const MapDefinition> &&mapDefinition, double generationTime);
+	};
+
+	std::vector<Entry> entries; // Least recently used first.
+	int byteCount; // Sum of entry byte counts.
+	int hitCount, missCount;
+public:
+	// Enough for a city, its wilderness, and several interiors/dungeons around it.
+	static constexpr int MAX_BYTES = 64 * 1024 * 1024;
+
+	MapDefinitionCache();
+
+	// Keys for each map type. These should change whenever anything given to map generation changes.
+	static std::string makeInteriorKey(const MapGeneration::InteriorGenInfo &interiorGenInfo);
+	static std::string makeCityKey(const MapGeneration::CityGenInfo &cityGenInfo,
+		const SkyGeneration::ExteriorSkyGenInfo &skyGenInfo);
+	static std::string makeWildKey(const MapGeneration::WildGenInfo &wildGenInfo,
+		const SkyGeneration::ExteriorSkyGenInfo &skyGenInfo);
+
+	int getEntryCount() const;
+	int getByteCount() const;
+	int getHitCount() const;
+	int getMissCount() const;
+
+	// Whether a map definition with the given key is cached. Doesn't count as a hit or a miss.
+	bool contains(const std::string &key) const;
+
+	// Returns the map definition generated with the given key (if any) and how long it took to generate,
+	// and marks it as recently used.
+	std::shared_ptr<const MapDefinition> tryGet(const std::string &key, double *outGenerationTime);
+
+	// Adds a newly generated map definition, evicting least recently used ones until it fits. A definition
+	// bigger than the whole budget is still kept until the next one is added.
+	void add(std::string &&key, std::shared_ptr<const MapDefinition> &&mapDefinition, double generationTime);
+
+	void clear();
+};
+
+#endif
@@ -0,0 +1,1680 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "MapDefinition.h"
+#include "MapDefinitionFile.h"
+#include "MapType.h"
+
+#include "components/debug/Debug.h"
+
+namespace
+{
+	// File header. The version must be bumped whenever the format or the output of map generation changes.
+	constexpr std::array<char, 4> FileMagic = { 'O', 'T', 'A', 'M' };
+	constexpr uint32_t FileVersion = 1;
+
+	uint64_t GetFNV1aHash(const uint8_t *data, size_t count)
+	{
+		uint64_t hash = 0xCBF29CE484222325;
+		for (size_t i = 0; i < count; i++)
+		{
+			hash ^= data[i];
+			hash *= 0x100000001B3;
+		}
+
+		return hash;
+	}
+
+	// Little-endian output.
+	class FileWriter
+	{
+	private:
+		std::vector<uint8_t> bytes;
+	public:
+		const std::vector<uint8_t> &getBytes() const
+		{
+			return this->bytes;
+		}
+
+		void writeBytes(const void *data, size_t count)
+		{
+			const uint8_t *dataPtr = static_cast<const uint8_t*>(data);
+			this->bytes.insert(this->bytes.end(), dataPtr, dataPtr + count);
+		}
+
+		void writeUint(uint64_t value, int byteCount)
+		{
+			for (int i = 0; i < byteCount; i++)
+			{
+				this->bytes.push_back(static_cast<uint8_t>((value >> (i * 8)) & 0xFF));
+			}
+		}
+
+		void writeU8(uint8_t value)
+		{
+			this->writeUint(value, 1);
+		}
+
+		void writeU16(uint16_t value)
+		{
+			this->writeUint(value, 2);
+		}
+
+		void writeU32(uint32_t value)
+		{
+			this->writeUint(value, 4);
+		}
+
+		void writeU64(uint64_t value)
+		{
+			this->writeUint(value, 8);
+		}
+
+		void writeInt(int value)
+		{
+			this->writeU32(static_cast<uint32_t>(value));
+		}
+
+		void writeBool(bool value)
+		{
+			this->writeU8(value ? 1 : 0);
+		}
+
+		void writeDouble(double value)
+		{
+			uint64_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			this->writeU64(bits);
+		}
+
+		void writeString(const std::string &value)
+		{
+			this->writeInt(static_cast<int>(value.size()));
+			this->writeBytes(value.data(), value.size());
+		}
+
+		template <typename T>
+		void writeEnum(T value)
+		{
+			this->writeInt(static_cast<int>(value));
+		}
+	};
+
+	// Little-endian input. Reading past the end marks the reader as failed and returns zeroes, so callers
+	// only need to check once at the end.
+	class FileReader
+	{
+	private:
+		const uint8_t *ptr, *end;
+		bool failed;
+	public:
+		FileReader(const uint8_t *data, size_t count)
+		{
+			this->ptr = data;
+			this->end = data + count;
+			this->failed = false;
+		}
+
+		bool isValid() const
+		{
+			return !this->failed;
+		}
+
+		bool isAtEnd() const
+		{
+			return this->ptr == this->end;
+		}
+
+		bool readBytes(void *outData, size_t count)
+		{
+			if (this->failed || (static_cast<size_t>(this->end - this->ptr) < count))
+			{
+				this->failed = true;
+				return false;
+			}
+
+			std::memcpy(outData, this->ptr, count);
+			this->ptr += count;
+			return true;
+		}
+
+		uint64_t readUint(int byteCount)
+		{
+			if (this->failed || ((this->end - this->ptr) < byteCount))
+			{
+				this->failed = true;
+				return 0;
+			}
+
+			uint64_t value = 0;
+			for (int i = 0; i < byteCount; i++)
+			{
+				value |= static_cast<uint64_t>(this->ptr[i]) << (i * 8);
+			}
+
+			this->ptr += byteCount;
+			return value;
+		}
+
+		uint8_t readU8()
+		{
+			return static_cast<uint8_t>(this->readUint(1));
+		}
+
+		uint16_t readU16()
+		{
+			return static_cast<uint16_t>(this->readUint(2));
+		}
+
+		uint32_t readU32()
+		{
+			return static_cast<uint32_t>(this->readUint(4));
+		}
+
+		uint64_t readU64()
+		{
+			return this->readUint(8);
+		}
+
+		int readInt()
+		{
+			return static_cast<int>(this->readU32());
+		}
+
+		bool readBool()
+		{
+			return this->readU8() != 0;
+		}
+
+		double readDouble()
+		{
+			const uint64_t bits = this->readU64();
+			double value;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		// Reads an element count, rejecting ones that couldn't possibly fit in the rest of the file.
+		int readCount()
+		{
+			const int count = this->readInt();
+			if ((count < 0) || (count > (this->end - this->ptr)))
+			{
+				this->failed = true;
+				return 0;
+			}
+
+			return count;
+		}
+
+		std::string readString()
+		{
+			const int length = this->readCount();
+			std::string value(length, '\0');
+			this->readBytes(value.data(), length);
+			return value;
+		}
+
+		template <typename T>
+		T readEnum()
+		{
+			return static_cast<T>(this->readInt());
+		}
+	};
+
+	void WriteTextureAssetRef(FileWriter &writer, const TextureAssetReference &textureAssetRef)
+	{
+		writer.writeString(textureAssetRef.filename);
+		writer.writeBool(textureAssetRef.index.has_value());
+		writer.writeInt(textureAssetRef.index.value_or(0));
+	}
+
+	TextureAssetReference ReadTextureAssetRef(FileReader &reader)
+	{
+		std::string filename = reader.readString();
+		const bool hasIndex = reader.readBool();
+		const int index = reader.readInt();
+		return TextureAssetReference(std::move(filename), hasIndex ? std::optional<int>(index) : std::nullopt);
+	}
+
+	void WriteOptionalBool(FileWriter &writer, const std::optional<bool> &value)
+	{
+		writer.writeBool(value.has_value());
+		writer.writeBool(value.value_or(false));
+	}
+
+	std::optional<bool> ReadOptionalBool(FileReader &reader)
+	{
+		const bool hasValue = reader.readBool();
+		const bool value = reader.readBool();
+		return hasValue ? std::optional<bool>(value) : std::nullopt;
+	}
+
+	void WriteDouble3(FileWriter &writer, const Double3 &value)
+	{
+		writer.writeDouble(value.x);
+		writer.writeDouble(value.y);
+		writer.writeDouble(value.z);
+	}
+
+	Double3 ReadDouble3(FileReader &reader)
+	{
+		const double x = reader.readDouble();
+		const double y = reader.readDouble();
+		const double z = reader.readDouble();
+		return Double3(x, y, z);
+	}
+
+	void WriteInt3(FileWriter &writer, const Int3 &value)
+	{
+		writer.writeInt(value.x);
+		writer.writeInt(value.y);
+		writer.writeInt(value.z);
+	}
+
+	Int3 ReadInt3(FileReader &reader)
+	{
+		const int x = reader.readInt();
+		const int y = reader.readInt();
+		const int z = reader.readInt();
+		return Int3(x, y, z);
+	}
+
+	void WriteVoxelDef(FileWriter &writer, const VoxelDefinition &voxelDef)
+	{
+		writer.writeEnum(voxelDef.type);
+		switch (voxelDef.type)
+		{
+		case ArenaTypes::VoxelType::None:
+			break;
+		case ArenaTypes::VoxelType::Wall:
+			WriteTextureAssetRef(writer, voxelDef.wall.sideTextureAssetRef);
+			WriteTextureAssetRef(writer, voxelDef.wall.floorTextureAssetRef);
+			WriteTextureAssetRef(writer, voxelDef.wall.ceilingTextureAssetRef);
+			break;
+		case ArenaTypes::VoxelType::Floor:
+			WriteTextureAssetRef(writer, voxelDef.floor.textureAssetRef);
+			writer.writeBool(voxelDef.floor.isWildWallColored);
+			break;
+		case ArenaTypes::VoxelType::Ceiling:
+			WriteTextureAssetRef(writer, voxelDef.ceiling.textureAssetRef);
+			break;
+		case ArenaTypes::VoxelType::Raised:
+			WriteTextureAssetRef(writer, voxelDef.raised.sideTextureAssetRef);
+			WriteTextureAssetRef(writer, voxelDef.raised.floorTextureAssetRef);
+			WriteTextureAssetRef(writer, voxelDef.raised.ceilingTextureAssetRef);
+			writer.writeDouble(voxelDef.raised.yOffset);
+			writer.writeDouble(voxelDef.raised.ySize);
+			writer.writeDouble(voxelDef.raised.vTop);
+			writer.writeDouble(voxelDef.raised.vBottom);
+			break;
+		case ArenaTypes::VoxelType::Diagonal:
+			WriteTextureAssetRef(writer, voxelDef.diagonal.textureAssetRef);
+			writer.writeBool(voxelDef.diagonal.type1);
+			break;
+		case ArenaTypes::VoxelType::TransparentWall:
+			WriteTextureAssetRef(writer, voxelDef.transparentWall.textureAssetRef);
+			writer.writeBool(voxelDef.transparentWall.collider);
+			break;
+		case ArenaTypes::VoxelType::Edge:
+			WriteTextureAssetRef(writer, voxelDef.edge.textureAssetRef);
+			writer.writeDouble(voxelDef.edge.yOffset);
+			writer.writeBool(voxelDef.edge.collider);
+			writer.writeBool(voxelDef.edge.flipped);
+			writer.writeEnum(voxelDef.edge.facing);
+			break;
+		case ArenaTypes::VoxelType::Chasm:
+			WriteTextureAssetRef(writer, voxelDef.chasm.textureAssetRef);
+			writer.writeEnum(voxelDef.chasm.type);
+			break;
+		case ArenaTypes::VoxelType::Door:
+			WriteTextureAssetRef(writer, voxelDef.door.textureAssetRef);
+			writer.writeEnum(voxelDef.door.type);
+			break;
+		default:
+			DebugNotImplementedMsg(std::to_string(static_cast<int>(voxelDef.type)));
+			break;
+		}
+	}
+
+	bool TryReadVoxelDef(FileReader &reader, VoxelDefinition *outVoxelDef)
+	{
+		const ArenaTypes::VoxelType type = reader.readEnum<ArenaTypes::VoxelType>();
+		switch (type)
+		{
+		case ArenaTypes::VoxelType::None:
+			*outVoxelDef = VoxelDefinition();
+			return true;
+		case ArenaTypes::VoxelType::Wall:
+		{
+			TextureAssetReference sideTextureAssetRef = ReadTextureAssetRef(reader);
+			TextureAssetReference floorTextureAssetRef = ReadTextureAssetRef(reader);
+			TextureAssetReference ceilingTextureAssetRef = ReadTextureAssetRef(reader);
+			*outVoxelDef = VoxelDefinition::makeWall(std::move(sideTextureAssetRef), std::move(floorTextureAssetRef),
+				std::move(ceilingTextureAssetRef));
+			return true;
+		}
+		case ArenaTypes::VoxelType::Floor:
+		{
+			TextureAssetReference textureAssetRef = ReadTextureAssetRef(reader);
+			const bool isWildWallColored = reader.readBool();
+			*outVoxelDef = VoxelDefinition::makeFloor(std::move(textureAssetRef), isWildWallColored);
+			return true;
+		}
+		case ArenaTypes::VoxelType::Ceiling:
+			*outVoxelDef = VoxelDefinition::makeCeiling(ReadTextureAssetRef(reader));
+			return true;
+		case ArenaTypes::VoxelType::Raised:
+		{
+			TextureAssetReference sideTextureAssetRef = ReadTextureAssetRef(reader);
+			TextureAssetReference floorTextureAssetRef = ReadTextureAssetRef(reader);
+			TextureAssetReference ceilingTextureAssetRef = ReadTextureAssetRef(reader);
+			const double yOffset = reader.readDouble();
+			const double ySize = reader.readDouble();
+			const double vTop = reader.readDouble();
+			const double vBottom = reader.readDouble();
+			*outVoxelDef = VoxelDefinition::makeRaised(std::move(sideTextureAssetRef),
+				std::move(floorTextureAssetRef), std::move(ceilingTextureAssetRef), yOffset, ySize, vTop, vBottom);
+			return true;
+		}
+		case ArenaTypes::VoxelType::Diagonal:
+		{
+			TextureAssetReference textureAssetRef = ReadTextureAssetRef(reader);
+			const bool type1 = reader.readBool();
+			*outVoxelDef = VoxelDefinition::makeDiagonal(std::move(textureAssetRef), type1);
+			return true;
+		}
+		case ArenaTypes::VoxelType::TransparentWall:
+		{
+			TextureAssetReference textureAssetRef = ReadTextureAssetRef(reader);
+			const bool collider = reader.readBool();
+			*outVoxelDef = VoxelDefinition::makeTransparentWall(std::move(textureAssetRef), collider);
+			return true;
+		}
+		case ArenaTypes::VoxelType::Edge:
+		{
+			TextureAssetReference textureAssetRef = ReadTextureAssetRef(reader);
+			const double yOffset = reader.readDouble();
+			const bool collider = reader.readBool();
+			const bool flipped = reader.readBool();
+			const VoxelFacing2D facing = reader.readEnum<VoxelFacing2D>();
+			*outVoxelDef = VoxelDefinition::makeEdge(std::move(textureAssetRef), yOffset, collider, flipped, facing);
+			return true;
+		}
+		case ArenaTypes::VoxelType::Chasm:
+		{
+			TextureAssetReference textureAssetRef = ReadTextureAssetRef(reader);
+			const ArenaTypes::ChasmType chasmType = reader.readEnum<ArenaTypes::ChasmType>();
+			*outVoxelDef = VoxelDefinition::makeChasm(std::move(textureAssetRef), chasmType);
+			return true;
+		}
+		case ArenaTypes::VoxelType::Door:
+		{
+			TextureAssetReference textureAssetRef = ReadTextureAssetRef(reader);
+			const ArenaTypes::DoorType doorType = reader.readEnum<ArenaTypes::DoorType>();
+			*outVoxelDef = VoxelDefinition::makeDoor(std::move(textureAssetRef), doorType);
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
+
+	void WriteAnimDef(FileWriter &writer, const EntityAnimationDefinition &animDef)
+	{
+		writer.writeInt(animDef.getStateCount());
+		for (int i = 0; i < animDef.getStateCount(); i++)
+		{
+			const EntityAnimationDefinition::State &state = animDef.getState(i);
+			writer.writeString(state.getName());
+			writer.writeDouble(state.getTotalSeconds());
+			writer.writeBool(state.isLooping());
+			writer.writeInt(state.getKeyframeListCount());
+			for (int j = 0; j < state.getKeyframeListCount(); j++)
+			{
+				const EntityAnimationDefinition::KeyframeList &keyframeList = state.getKeyframeList(j);
+				writer.writeBool(keyframeList.isFlipped());
+				writer.writeInt(keyframeList.getKeyframeCount());
+				for (int k = 0; k < keyframeList.getKeyframeCount(); k++)
+				{
+					const EntityAnimationDefinition::Keyframe &keyframe = keyframeList.getKeyframe(k);
+					WriteTextureAssetRef(writer, keyframe.getTextureAssetRef());
+					writer.writeDouble(keyframe.getWidth());
+					writer.writeDouble(keyframe.getHeight());
+				}
+			}
+		}
+	}
+
+	EntityAnimationDefinition ReadAnimDef(FileReader &reader)
+	{
+		EntityAnimationDefinition animDef;
+		const int stateCount = reader.readCount();
+		for (int i = 0; i < stateCount; i++)
+		{
+			const std::string name = reader.readString();
+			const double totalSeconds = reader.readDouble();
+			const bool loop = reader.readBool();
+
+			EntityAnimationDefinition::State state;
+			state.init(name.c_str(), totalSeconds, loop);
+
+			const int keyframeListCount = reader.readCount();
+			for (int j = 0; j < keyframeListCount; j++)
+			{
+				EntityAnimationDefinition::KeyframeList keyframeList;
+				keyframeList.init(reader.readBool());
+
+				const int keyframeCount = reader.readCount();
+				for (int k = 0; k < keyframeCount; k++)
+				{
+					TextureAssetReference textureAssetRef = ReadTextureAssetRef(reader);
+					const double width = reader.readDouble();
+					const double height = reader.readDouble();
+					keyframeList.addKeyframe(EntityAnimationDefinition::Keyframe(std::move(textureAssetRef), width, height));
+				}
+
+				state.addKeyframeList(std::move(keyframeList));
+			}
+
+			animDef.addState(std::move(state));
+		}
+
+		return animDef;
+	}
+
+	void WriteCreatureDef(FileWriter &writer, const EntityDefinition::EnemyDefinition::CreatureDefinition &creature)
+	{
+		writer.writeBytes(creature.name, sizeof(creature.name));
+		writer.writeInt(creature.level);
+		writer.writeInt(creature.minHP);
+		writer.writeInt(creature.maxHP);
+		writer.writeInt(creature.baseExp);
+		writer.writeInt(creature.expMultiplier);
+		writer.writeInt(creature.soundIndex);
+		writer.writeBytes(creature.soundName, sizeof(creature.soundName));
+		writer.writeInt(creature.minDamage);
+		writer.writeInt(creature.maxDamage);
+		writer.writeInt(creature.magicEffects);
+		writer.writeInt(creature.scale);
+		writer.writeInt(creature.yOffset);
+		writer.writeBool(creature.hasNoCorpse);
+		writer.writeInt(creature.bloodIndex);
+		writer.writeInt(creature.diseaseChances);
+		for (const int attribute : creature.attributes)
+		{
+			writer.writeInt(attribute);
+		}
+	}
+
+	EntityDefinition::EnemyDefinition::CreatureDefinition ReadCreatureDef(FileReader &reader)
+	{
+		EntityDefinition::EnemyDefinition::CreatureDefinition creature;
+		reader.readBytes(creature.name, sizeof(creature.name));
+		creature.level = reader.readInt();
+		creature.minHP = reader.readInt();
+		creature.maxHP = reader.readInt();
+		creature.baseExp = reader.readInt();
+		creature.expMultiplier = reader.readInt();
+		creature.soundIndex = reader.readInt();
+		reader.readBytes(creature.soundName, sizeof(creature.soundName));
+		creature.minDamage = reader.readInt();
+		creature.maxDamage = reader.readInt();
+		creature.magicEffects = reader.readInt();
+		creature.scale = reader.readInt();
+		creature.yOffset = reader.readInt();
+		creature.hasNoCorpse = reader.readBool();
+		creature.bloodIndex = reader.readInt();
+		creature.diseaseChances = reader.readInt();
+		for (int &attribute : creature.attributes)
+		{
+			attribute = reader.readInt();
+		}
+
+		// Names are null-terminated strings.
+		creature.name[std::size(creature.name) - 1] = '\0';
+		creature.soundName[std::size(creature.soundName) - 1] = '\0';
+		return creature;
+	}
+
+	void WriteEntityDef(FileWriter &writer, const EntityDefinition &entityDef)
+	{
+		const EntityDefinition::Type type = entityDef.getType();
+		writer.writeEnum(type);
+		WriteAnimDef(writer, entityDef.getAnimDef());
+
+		switch (type)
+		{
+		case EntityDefinition::Type::Enemy:
+		{
+			const EntityDefinition::EnemyDefinition &enemy = entityDef.getEnemy();
+			writer.writeEnum(enemy.getType());
+			if (enemy.getType() == EntityDefinition::EnemyDefinition::Type::Creature)
+			{
+				WriteCreatureDef(writer, enemy.getCreature());
+			}
+			else
+			{
+				const EntityDefinition::EnemyDefinition::HumanDefinition &human = enemy.getHuman();
+				writer.writeBool(human.male);
+				writer.writeInt(human.charClassID);
+			}
+
+			break;
+		}
+		case EntityDefinition::Type::Citizen:
+			writer.writeBool(entityDef.getCitizen().male);
+			writer.writeEnum(entityDef.getCitizen().climateType);
+			break;
+		case EntityDefinition::Type::StaticNPC:
+		{
+			const EntityDefinition::StaticNpcDefinition &staticNpc = entityDef.getStaticNpc();
+			writer.writeEnum(staticNpc.getType());
+			if (staticNpc.getType() == EntityDefinition::StaticNpcDefinition::Type::Shopkeeper)
+			{
+				writer.writeEnum(staticNpc.getShopkeeper().type);
+			}
+
+			break;
+		}
+		case EntityDefinition::Type::Item:
+			writer.writeEnum(entityDef.getItem().getType());
+			break;
+		case EntityDefinition::Type::Container:
+		{
+			const EntityDefinition::ContainerDefinition &container = entityDef.getContainer();
+			writer.writeEnum(container.getType());
+			if (container.getType() == EntityDefinition::ContainerDefinition::Type::Holder)
+			{
+				writer.writeBool(container.getHolder().locked);
+			}
+
+			break;
+		}
+		case EntityDefinition::Type::Projectile:
+			writer.writeBool(entityDef.getProjectile().hasGravity);
+			break;
+		case EntityDefinition::Type::Transition:
+			writer.writeInt(entityDef.getTransition().transitionDefID);
+			break;
+		case EntityDefinition::Type::Doodad:
+		{
+			const EntityDefinition::DoodadDefinition &doodad = entityDef.getDoodad();
+			writer.writeInt(doodad.yOffset);
+			writer.writeDouble(doodad.scale);
+			writer.writeBool(doodad.collider);
+			writer.writeBool(doodad.transparent);
+			writer.writeBool(doodad.ceiling);
+			writer.writeBool(doodad.streetlight);
+			writer.writeBool(doodad.puddle);
+			writer.writeInt(doodad.lightIntensity);
+			break;
+		}
+		default:
+			DebugNotImplementedMsg(std::to_string(static_cast<int>(type)));
+			break;
+		}
+	}
+
+	bool TryReadEntityDef(FileReader &reader, EntityDefinition *outEntityDef)
+	{
+		const EntityDefinition::Type type = reader.readEnum<EntityDefinition::Type>();
+		EntityAnimationDefinition animDef = ReadAnimDef(reader);
+
+		switch (type)
+		{
+		case EntityDefinition::Type::Enemy:
+		{
+			const auto enemyType = reader.readEnum<EntityDefinition::EnemyDefinition::Type>();
+			if (enemyType == EntityDefinition::EnemyDefinition::Type::Creature)
+			{
+				outEntityDef->initEnemyCreature(ReadCreatureDef(reader), std::move(animDef));
+			}
+			else
+			{
+				const bool male = reader.readBool();
+				const int charClassID = reader.readInt();
+				outEntityDef->initEnemyHuman(male, charClassID, std::move(animDef));
+			}
+
+			return true;
+		}
+		case EntityDefinition::Type::Citizen:
+		{
+			const bool male = reader.readBool();
+			const ArenaTypes::ClimateType climateType = reader.readEnum<ArenaTypes::ClimateType>();
+			outEntityDef->initCitizen(male, climateType, std::move(animDef));
+			return true;
+		}
+		case EntityDefinition::Type::StaticNPC:
+		{
+			const auto staticNpcType = reader.readEnum<EntityDefinition::StaticNpcDefinition::Type>();
+			if (staticNpcType == EntityDefinition::StaticNpcDefinition::Type::Shopkeeper)
+			{
+				const auto shopkeeperType =
+					reader.readEnum<EntityDefinition::StaticNpcDefinition::ShopkeeperDefinition::Type>();
+				outEntityDef->initStaticNpcShopkeeper(shopkeeperType, std::move(animDef));
+			}
+			else
+			{
+				outEntityDef->initStaticNpcPerson(std::move(animDef));
+			}
+
+			return true;
+		}
+		case EntityDefinition::Type::Item:
+			if (reader.readEnum<EntityDefinition::ItemDefinition::Type>() == EntityDefinition::ItemDefinition::Type::Key)
+			{
+				outEntityDef->initItemKey(std::move(animDef));
+			}
+			else
+			{
+				outEntityDef->initItemQuestItem(std::move(animDef));
+			}
+
+			return true;
+		case EntityDefinition::Type::Container:
+		{
+			const auto containerType = reader.readEnum<EntityDefinition::ContainerDefinition::Type>();
+			if (containerType == EntityDefinition::ContainerDefinition::Type::Holder)
+			{
+				outEntityDef->initContainerHolder(reader.readBool(), std::move(animDef));
+			}
+			else
+			{
+				outEntityDef->initContainerPile(std::move(animDef));
+			}
+
+			return true;
+		}
+		case EntityDefinition::Type::Projectile:
+			outEntityDef->initProjectile(reader.readBool(), std::move(animDef));
+			return true;
+		case EntityDefinition::Type::Transition:
+			outEntityDef->initTransition(reader.readInt(), std::move(animDef));
+			return true;
+		case EntityDefinition::Type::Doodad:
+		{
+			const int yOffset = reader.readInt();
+			const double scale = reader.readDouble();
+			const bool collider = reader.readBool();
+			const bool transparent = reader.readBool();
+			const bool ceiling = reader.readBool();
+			const bool streetlight = reader.readBool();
+			const bool puddle = reader.readBool();
+			const int lightIntensity = reader.readInt();
+			outEntityDef->initDoodad(yOffset, scale, collider, transparent, ceiling, streetlight, puddle,
+				lightIntensity, std::move(animDef));
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
+
+	void WriteInteriorGenInfo(FileWriter &writer, const MapGeneration::InteriorGenInfo &interiorGenInfo)
+	{
+		writer.writeEnum(interiorGenInfo.getType());
+		if (interiorGenInfo.getType() == MapGeneration::InteriorGenInfo::Type::Prefab)
+		{
+			const MapGeneration::InteriorGenInfo::Prefab &prefab = interiorGenInfo.getPrefab();
+			writer.writeString(prefab.mifName);
+			writer.writeEnum(prefab.interiorType);
+			WriteOptionalBool(writer, prefab.rulerIsMale);
+		}
+		else
+		{
+			const MapGeneration::InteriorGenInfo::Dungeon &dungeon = interiorGenInfo.getDungeon();
+			writer.writeU32(dungeon.dungeonDef.dungeonSeed);
+			writer.writeInt(dungeon.dungeonDef.widthChunkCount);
+			writer.writeInt(dungeon.dungeonDef.heightChunkCount);
+			writer.writeBool(dungeon.isArtifactDungeon);
+		}
+	}
+
+	MapGeneration::InteriorGenInfo ReadInteriorGenInfo(FileReader &reader)
+	{
+		MapGeneration::InteriorGenInfo interiorGenInfo;
+		if (reader.readEnum<MapGeneration::InteriorGenInfo::Type>() == MapGeneration::InteriorGenInfo::Type::Prefab)
+		{
+			std::string mifName = reader.readString();
+			const ArenaTypes::InteriorType interiorType = reader.readEnum<ArenaTypes::InteriorType>();
+			const std::optional<bool> rulerIsMale = ReadOptionalBool(reader);
+			interiorGenInfo.initPrefab(std::move(mifName), interiorType, rulerIsMale);
+		}
+		else
+		{
+			const uint32_t dungeonSeed = reader.readU32();
+			const int widthChunkCount = reader.readInt();
+			const int heightChunkCount = reader.readInt();
+			const bool isArtifactDungeon = reader.readBool();
+
+			LocationDefinition::DungeonDefinition dungeonDef;
+			dungeonDef.init(dungeonSeed, widthChunkCount, heightChunkCount);
+			interiorGenInfo.initDungeon(dungeonDef, isArtifactDungeon);
+		}
+
+		return interiorGenInfo;
+	}
+
+	void WriteTransitionDef(FileWriter &writer, const TransitionDefinition &transitionDef)
+	{
+		const TransitionType type = transitionDef.getType();
+		writer.writeEnum(type);
+		if (type == TransitionType::EnterInterior)
+		{
+			WriteInteriorGenInfo(writer, transitionDef.getInteriorEntrance().interiorGenInfo);
+		}
+		else if (type == TransitionType::LevelChange)
+		{
+			writer.writeBool(transitionDef.getLevelChange().isLevelUp);
+		}
+	}
+
+	TransitionDefinition ReadTransitionDef(FileReader &reader)
+	{
+		TransitionDefinition transitionDef;
+		const TransitionType type = reader.readEnum<TransitionType>();
+		if (type == TransitionType::CityGate)
+		{
+			transitionDef.initCityGate();
+		}
+		else if (type == TransitionType::EnterInterior)
+		{
+			transitionDef.initInteriorEntrance(ReadInteriorGenInfo(reader));
+		}
+		else if (type == TransitionType::ExitInterior)
+		{
+			transitionDef.initInteriorExit();
+		}
+		else
+		{
+			transitionDef.initLevelChange(reader.readBool());
+		}
+
+		return transitionDef;
+	}
+
+	void WriteLevelInfoDef(FileWriter &writer, const LevelInfoDefinition &levelInfoDef)
+	{
+		writer.writeDouble(levelInfoDef.getCeilingScale());
+
+		writer.writeInt(levelInfoDef.getVoxelDefCount());
+		for (int i = 0; i < levelInfoDef.getVoxelDefCount(); i++)
+		{
+			WriteVoxelDef(writer, levelInfoDef.getVoxelDef(i));
+		}
+
+		writer.writeInt(levelInfoDef.getEntityDefCount());
+		for (int i = 0; i < levelInfoDef.getEntityDefCount(); i++)
+		{
+			WriteEntityDef(writer, levelInfoDef.getEntityDef(i));
+		}
+
+		writer.writeInt(levelInfoDef.getLockDefCount());
+		for (int i = 0; i < levelInfoDef.getLockDefCount(); i++)
+		{
+			const LockDefinition &lockDef = levelInfoDef.getLockDef(i);
+			writer.writeInt(lockDef.getX());
+			writer.writeInt(lockDef.getY());
+			writer.writeInt(lockDef.getZ());
+			writer.writeEnum(lockDef.getType());
+			if (lockDef.getType() == LockDefinition::Type::LeveledLock)
+			{
+				writer.writeInt(lockDef.getLeveledLockDef().getLockLevel());
+			}
+		}
+
+		writer.writeInt(levelInfoDef.getTriggerDefCount());
+		for (int i = 0; i < levelInfoDef.getTriggerDefCount(); i++)
+		{
+			const TriggerDefinition &triggerDef = levelInfoDef.getTriggerDef(i);
+			writer.writeInt(triggerDef.getX());
+			writer.writeInt(triggerDef.getY());
+			writer.writeInt(triggerDef.getZ());
+			writer.writeBool(triggerDef.hasSoundDef());
+			if (triggerDef.hasSoundDef())
+			{
+				writer.writeString(triggerDef.getSoundDef().getFilename());
+			}
+
+			writer.writeBool(triggerDef.hasTextDef());
+			if (triggerDef.hasTextDef())
+			{
+				const TriggerDefinition::TextDef &textDef = triggerDef.getTextDef();
+				writer.writeString(textDef.getText());
+				writer.writeBool(textDef.isDisplayedOnce());
+			}
+		}
+
+		writer.writeInt(levelInfoDef.getTransitionDefCount());
+		for (int i = 0; i < levelInfoDef.getTransitionDefCount(); i++)
+		{
+			WriteTransitionDef(writer, levelInfoDef.getTransitionDef(i));
+		}
+
+		// Overridden building names replace the original everywhere, so only the result is needed.
+		writer.writeInt(levelInfoDef.getBuildingNameCount());
+		for (int i = 0; i < levelInfoDef.getBuildingNameCount(); i++)
+		{
+			writer.writeString(levelInfoDef.getBuildingName(i));
+		}
+
+		writer.writeInt(levelInfoDef.getDoorDefCount());
+		for (int i = 0; i < levelInfoDef.getDoorDefCount(); i++)
+		{
+			const DoorDefinition &doorDef = levelInfoDef.getDoorDef(i);
+			writer.writeEnum(doorDef.getType());
+			writer.writeString(doorDef.getOpenSound().soundFilename);
+			writer.writeEnum(doorDef.getCloseSound().closeType);
+			writer.writeString(doorDef.getCloseSound().soundFilename);
+		}
+	}
+
+	bool TryReadLevelInfoDef(FileReader &reader, LevelInfoDefinition *outLevelInfoDef)
+	{
+		outLevelInfoDef->init(reader.readDouble());
+
+		const int voxelDefCount = reader.readCount();
+		for (int i = 0; i < voxelDefCount; i++)
+		{
+			VoxelDefinition voxelDef;
+			if (!TryReadVoxelDef(reader, &voxelDef))
+			{
+				return false;
+			}
+
+			outLevelInfoDef->addVoxelDef(std::move(voxelDef));
+		}
+
+		const int entityDefCount = reader.readCount();
+		for (int i = 0; i < entityDefCount; i++)
+		{
+			EntityDefinition entityDef;
+			if (!TryReadEntityDef(reader, &entityDef))
+			{
+				return false;
+			}
+
+			outLevelInfoDef->addEntityDef(std::move(entityDef));
+		}
+
+		const int lockDefCount = reader.readCount();
+		for (int i = 0; i < lockDefCount; i++)
+		{
+			const SNInt x = reader.readInt();
+			const int y = reader.readInt();
+			const WEInt z = reader.readInt();
+			if (reader.readEnum<LockDefinition::Type>() == LockDefinition::Type::LeveledLock)
+			{
+				outLevelInfoDef->addLockDef(LockDefinition::makeLeveledLock(x, y, z, reader.readInt()));
+			}
+			else
+			{
+				outLevelInfoDef->addLockDef(LockDefinition::makeKeyLock(x, y, z));
+			}
+		}
+
+		const int triggerDefCount = reader.readCount();
+		for (int i = 0; i < triggerDefCount; i++)
+		{
+			const SNInt x = reader.readInt();
+			const int y = reader.readInt();
+			const WEInt z = reader.readInt();
+
+			TriggerDefinition triggerDef;
+			triggerDef.init(x, y, z);
+			if (reader.readBool())
+			{
+				triggerDef.setSoundDef(reader.readString());
+			}
+
+			if (reader.readBool())
+			{
+				std::string text = reader.readString();
+				const bool displayedOnce = reader.readBool();
+				triggerDef.setTextDef(std::move(text), displayedOnce);
+			}
+
+			outLevelInfoDef->addTriggerDef(std::move(triggerDef));
+		}
+
+		const int transitionDefCount = reader.readCount();
+		for (int i = 0; i < transitionDefCount; i++)
+		{
+			outLevelInfoDef->addTransitionDef(ReadTransitionDef(reader));
+		}
+
+		const int buildingNameCount = reader.readCount();
+		for (int i = 0; i < buildingNameCount; i++)
+		{
+			outLevelInfoDef->addBuildingName(reader.readString());
+		}
+
+		const int doorDefCount = reader.readCount();
+		for (int i = 0; i < doorDefCount; i++)
+		{
+			const ArenaTypes::DoorType doorType = reader.readEnum<ArenaTypes::DoorType>();
+			std::string openSoundFilename = reader.readString();
+			const DoorDefinition::CloseType closeType = reader.readEnum<DoorDefinition::CloseType>();
+			std::string closeSoundFilename = reader.readString();
+
+			DoorDefinition doorDef;
+			doorDef.init(doorType, std::move(openSoundFilename), closeType, std::move(closeSoundFilename));
+			outLevelInfoDef->addDoorDef(std::move(doorDef));
+		}
+
+		return reader.isValid();
+	}
+
+	// Writes placement definitions as ID + position lists.
+	template <typename PlacementDefType, typename WritePositionFunc>
+	void WritePlacementDefs(FileWriter &writer, int count, const PlacementDefType &(LevelDefinition::*getDef)(int) const,
+		const LevelDefinition &levelDef, WritePositionFunc writePosition)
+	{
+		writer.writeInt(count);
+		for (int i = 0; i < count; i++)
+		{
+			const PlacementDefType &placementDef = (levelDef.*getDef)(i);
+			writer.writeInt(placementDef.id);
+			writer.writeInt(static_cast<int>(placementDef.positions.size()));
+			for (const auto &position : placementDef.positions)
+			{
+				writePosition(position);
+			}
+		}
+	}
+
+	// Reads placement definitions back through the level definition's add function so its per-chunk lists
+	// are rebuilt too.
+	template <typename ReadAddFunc>
+	void ReadPlacementDefs(FileReader &reader, ReadAddFunc readAdd)
+	{
+		const int count = reader.readCount();
+		for (int i = 0; i < count; i++)
+		{
+			const int id = reader.readInt();
+			const int positionCount = reader.readCount();
+			for (int j = 0; j < positionCount; j++)
+			{
+				readAdd(id);
+			}
+		}
+	}
+
+	void WriteLevelDef(FileWriter &writer, const LevelDefinition &levelDef)
+	{
+		const SNInt width = levelDef.getWidth();
+		const int height = levelDef.getHeight();
+		const WEInt depth = levelDef.getDepth();
+		writer.writeInt(width);
+		writer.writeInt(height);
+		writer.writeInt(depth);
+
+		for (WEInt z = 0; z < depth; z++)
+		{
+			for (int y = 0; y < height; y++)
+			{
+				for (SNInt x = 0; x < width; x++)
+				{
+					writer.writeU16(static_cast<uint16_t>(levelDef.getVoxel(x, y, z)));
+				}
+			}
+		}
+
+		auto writeDouble3 = [&writer](const LevelDouble3 &position) { WriteDouble3(writer, position); };
+		auto writeInt3 = [&writer](const LevelInt3 &position) { WriteInt3(writer, position); };
+		WritePlacementDefs(writer, levelDef.getEntityPlacementDefCount(), &LevelDefinition::getEntityPlacementDef,
+			levelDef, writeDouble3);
+		WritePlacementDefs(writer, levelDef.getLockPlacementDefCount(), &LevelDefinition::getLockPlacementDef,
+			levelDef, writeInt3);
+		WritePlacementDefs(writer, levelDef.getTriggerPlacementDefCount(), &LevelDefinition::getTriggerPlacementDef,
+			levelDef, writeInt3);
+		WritePlacementDefs(writer, levelDef.getTransitionPlacementDefCount(),
+			&LevelDefinition::getTransitionPlacementDef, levelDef, writeInt3);
+		WritePlacementDefs(writer, levelDef.getBuildingNamePlacementDefCount(),
+			&LevelDefinition::getBuildingNamePlacementDef, levelDef, writeInt3);
+		WritePlacementDefs(writer, levelDef.getDoorPlacementDefCount(), &LevelDefinition::getDoorPlacementDef,
+			levelDef, writeInt3);
+	}
+
+	bool TryReadLevelDef(FileReader &reader, LevelDefinition *outLevelDef)
+	{
+		const SNInt width = reader.readInt();
+		const int height = reader.readInt();
+		const WEInt depth = reader.readInt();
+		const int64_t voxelCount = static_cast<int64_t>(width) * height * depth;
+		if (!reader.isValid() || (width < 0) || (height < 0) || (depth < 0) || (voxelCount > (1 << 28)))
+		{
+			return false;
+		}
+
+		outLevelDef->init(width, height, depth);
+		for (WEInt z = 0; z < depth; z++)
+		{
+			for (int y = 0; y < height; y++)
+			{
+				for (SNInt x = 0; x < width; x++)
+				{
+					outLevelDef->setVoxel(x, y, z, reader.readU16());
+				}
+			}
+		}
+
+		ReadPlacementDefs(reader, [&reader, outLevelDef](int id) { outLevelDef->addEntity(id, ReadDouble3(reader)); });
+		ReadPlacementDefs(reader, [&reader, outLevelDef](int id) { outLevelDef->addLock(id, ReadInt3(reader)); });
+		ReadPlacementDefs(reader, [&reader, outLevelDef](int id) { outLevelDef->addTrigger(id, ReadInt3(reader)); });
+		ReadPlacementDefs(reader, [&reader, outLevelDef](int id) { outLevelDef->addTransition(id, ReadInt3(reader)); });
+		ReadPlacementDefs(reader, [&reader, outLevelDef](int id) { outLevelDef->addBuildingName(id, ReadInt3(reader)); });
+		ReadPlacementDefs(reader, [&reader, outLevelDef](int id) { outLevelDef->addDoor(id, ReadInt3(reader)); });
+		return reader.isValid();
+	}
+
+	void WriteTextureAssetRefs(FileWriter &writer, int count, const TextureAssetReference &(*getRef)(const void*, int),
+		const void *owner)
+	{
+		writer.writeInt(count);
+		for (int i = 0; i < count; i++)
+		{
+			WriteTextureAssetRef(writer, getRef(owner, i));
+		}
+	}
+
+	Buffer<TextureAssetReference> ReadTextureAssetRefs(FileReader &reader)
+	{
+		Buffer<TextureAssetReference> textureAssetRefs(reader.readCount());
+		for (int i = 0; i < textureAssetRefs.getCount(); i++)
+		{
+			textureAssetRefs.set(i, ReadTextureAssetRef(reader));
+		}
+
+		return textureAssetRefs;
+	}
+
+	void WriteSkyDef(FileWriter &writer, const SkyDefinition &skyDef)
+	{
+		writer.writeInt(skyDef.getSkyColorCount());
+		for (int i = 0; i < skyDef.getSkyColorCount(); i++)
+		{
+			writer.writeU32(skyDef.getSkyColor(i).toARGB());
+		}
+
+		writer.writeInt(skyDef.getLandPlacementDefCount());
+		for (int i = 0; i < skyDef.getLandPlacementDefCount(); i++)
+		{
+			const SkyDefinition::LandPlacementDef &placementDef = skyDef.getLandPlacementDef(i);
+			writer.writeInt(placementDef.id);
+			writer.writeInt(static_cast<int>(placementDef.positions.size()));
+			for (const Radians position : placementDef.positions)
+			{
+				writer.writeDouble(position);
+			}
+		}
+
+		writer.writeInt(skyDef.getAirPlacementDefCount());
+		for (int i = 0; i < skyDef.getAirPlacementDefCount(); i++)
+		{
+			const SkyDefinition::AirPlacementDef &placementDef = skyDef.getAirPlacementDef(i);
+			writer.writeInt(placementDef.id);
+			writer.writeInt(static_cast<int>(placementDef.positions.size()));
+			for (const std::pair<Radians, Radians> &position : placementDef.positions)
+			{
+				writer.writeDouble(position.first);
+				writer.writeDouble(position.second);
+			}
+		}
+
+		writer.writeInt(skyDef.getStarPlacementDefCount());
+		for (int i = 0; i < skyDef.getStarPlacementDefCount(); i++)
+		{
+			const SkyDefinition::StarPlacementDef &placementDef = skyDef.getStarPlacementDef(i);
+			writer.writeInt(placementDef.id);
+			writer.writeInt(static_cast<int>(placementDef.positions.size()));
+			for (const Double3 &position : placementDef.positions)
+			{
+				WriteDouble3(writer, position);
+			}
+		}
+
+		writer.writeInt(skyDef.getSunPlacementDefCount());
+		for (int i = 0; i < skyDef.getSunPlacementDefCount(); i++)
+		{
+			const SkyDefinition::SunPlacementDef &placementDef = skyDef.getSunPlacementDef(i);
+			writer.writeInt(placementDef.id);
+			writer.writeInt(static_cast<int>(placementDef.positions.size()));
+			for (const double position : placementDef.positions)
+			{
+				writer.writeDouble(position);
+			}
+		}
+
+		writer.writeInt(skyDef.getMoonPlacementDefCount());
+		for (int i = 0; i < skyDef.getMoonPlacementDefCount(); i++)
+		{
+			const SkyDefinition::MoonPlacementDef &placementDef = skyDef.getMoonPlacementDef(i);
+			writer.writeInt(placementDef.id);
+			writer.writeInt(static_cast<int>(placementDef.positions.size()));
+			for (const SkyDefinition::MoonPlacementDef::Position &position : placementDef.positions)
+			{
+				WriteDouble3(writer, position.baseDir);
+				writer.writeDouble(position.orbitPercent);
+				writer.writeDouble(position.bonusLatitude);
+				writer.writeInt(position.imageIndex);
+			}
+		}
+	}
+
+	bool TryReadSkyDef(FileReader &reader, SkyDefinition *outSkyDef)
+	{
+		Buffer<Color> skyColors(reader.readCount());
+		for (int i = 0; i < skyColors.getCount(); i++)
+		{
+			skyColors.set(i, Color::fromARGB(reader.readU32()));
+		}
+
+		outSkyDef->init(std::move(skyColors));
+
+		ReadPlacementDefs(reader, [&reader, outSkyDef](int id) { outSkyDef->addLand(id, reader.readDouble()); });
+		ReadPlacementDefs(reader, [&reader, outSkyDef](int id)
+		{
+			const Radians angleX = reader.readDouble();
+			const Radians angleY = reader.readDouble();
+			outSkyDef->addAir(id, angleX, angleY);
+		});
+
+		ReadPlacementDefs(reader, [&reader, outSkyDef](int id) { outSkyDef->addStar(id, ReadDouble3(reader)); });
+		ReadPlacementDefs(reader, [&reader, outSkyDef](int id) { outSkyDef->addSun(id, reader.readDouble()); });
+		ReadPlacementDefs(reader, [&reader, outSkyDef](int id)
+		{
+			const Double3 baseDir = ReadDouble3(reader);
+			const double orbitPercent = reader.readDouble();
+			const double bonusLatitude = reader.readDouble();
+			const int imageIndex = reader.readInt();
+			outSkyDef->addMoon(id, baseDir, orbitPercent, bonusLatitude, imageIndex);
+		});
+
+		return reader.isValid();
+	}
+
+	void WriteSkyInfoDef(FileWriter &writer, const SkyInfoDefinition &skyInfoDef)
+	{
+		writer.writeInt(skyInfoDef.getLandCount());
+		for (int i = 0; i < skyInfoDef.getLandCount(); i++)
+		{
+			const SkyLandDefinition &landDef = skyInfoDef.getLand(i);
+			WriteTextureAssetRefs(writer, landDef.getTextureCount(), [](const void *owner, int index) -> const TextureAssetReference&
+			{
+				return static_cast<const SkyLandDefinition*>(owner)->getTextureAssetRef(index);
+			}, &landDef);
+
+			writer.writeBool(landDef.hasAnimation());
+			writer.writeDouble(landDef.hasAnimation() ? landDef.getAnimationSeconds() : 0.0);
+			writer.writeEnum(landDef.getShadingType());
+		}
+
+		writer.writeInt(skyInfoDef.getAirCount());
+		for (int i = 0; i < skyInfoDef.getAirCount(); i++)
+		{
+			WriteTextureAssetRef(writer, skyInfoDef.getAir(i).getTextureAssetRef());
+		}
+
+		writer.writeInt(skyInfoDef.getStarCount());
+		for (int i = 0; i < skyInfoDef.getStarCount(); i++)
+		{
+			const SkyStarDefinition &starDef = skyInfoDef.getStar(i);
+			writer.writeEnum(starDef.getType());
+			if (starDef.getType() == SkyStarDefinition::Type::Small)
+			{
+				writer.writeU8(starDef.getSmallStar().paletteIndex);
+			}
+			else
+			{
+				WriteTextureAssetRef(writer, starDef.getLargeStar().textureAssetRef);
+			}
+		}
+
+		writer.writeInt(skyInfoDef.getSunCount());
+		for (int i = 0; i < skyInfoDef.getSunCount(); i++)
+		{
+			WriteTextureAssetRef(writer, skyInfoDef.getSun(i).getTextureAssetRef());
+		}
+
+		writer.writeInt(skyInfoDef.getMoonCount());
+		for (int i = 0; i < skyInfoDef.getMoonCount(); i++)
+		{
+			const SkyMoonDefinition &moonDef = skyInfoDef.getMoon(i);
+			WriteTextureAssetRefs(writer, moonDef.getTextureCount(), [](const void *owner, int index) -> const TextureAssetReference&
+			{
+				return static_cast<const SkyMoonDefinition*>(owner)->getTextureAssetRef(index);
+			}, &moonDef);
+		}
+
+		writer.writeInt(skyInfoDef.getLightningCount());
+		for (int i = 0; i < skyInfoDef.getLightningCount(); i++)
+		{
+			const SkyLightningDefinition &lightningDef = skyInfoDef.getLightning(i);
+			WriteTextureAssetRefs(writer, lightningDef.getTextureCount(), [](const void *owner, int index) -> const TextureAssetReference&
+			{
+				return static_cast<const SkyLightningDefinition*>(owner)->getTextureAssetRef(index);
+			}, &lightningDef);
+
+			writer.writeDouble(lightningDef.getAnimationSeconds());
+		}
+	}
+
+	bool TryReadSkyInfoDef(FileReader &reader, SkyInfoDefinition *outSkyInfoDef)
+	{
+		const int landCount = reader.readCount();
+		for (int i = 0; i < landCount; i++)
+		{
+			Buffer<TextureAssetReference> textureAssetRefs = ReadTextureAssetRefs(reader);
+			const bool hasAnimation = reader.readBool();
+			const double animSeconds = reader.readDouble();
+			const SkyLandDefinition::ShadingType shadingType = reader.readEnum<SkyLandDefinition::ShadingType>();
+			if (!reader.isValid() || (textureAssetRefs.getCount() == 0))
+			{
+				return false;
+			}
+
+			SkyLandDefinition landDef;
+			if (hasAnimation)
+			{
+				landDef.init(std::move(textureAssetRefs), animSeconds, shadingType);
+			}
+			else
+			{
+				landDef.init(std::move(textureAssetRefs.get(0)), shadingType);
+			}
+
+			outSkyInfoDef->addLand(std::move(landDef));
+		}
+
+		const int airCount = reader.readCount();
+		for (int i = 0; i < airCount; i++)
+		{
+			SkyAirDefinition airDef;
+			airDef.init(ReadTextureAssetRef(reader));
+			outSkyInfoDef->addAir(std::move(airDef));
+		}
+
+		const int starCount = reader.readCount();
+		for (int i = 0; i < starCount; i++)
+		{
+			SkyStarDefinition starDef;
+			if (reader.readEnum<SkyStarDefinition::Type>() == SkyStarDefinition::Type::Small)
+			{
+				starDef.initSmall(reader.readU8());
+			}
+			else
+			{
+				starDef.initLarge(ReadTextureAssetRef(reader));
+			}
+
+			outSkyInfoDef->addStar(std::move(starDef));
+		}
+
+		const int sunCount = reader.readCount();
+		for (int i = 0; i < sunCount; i++)
+		{
+			SkySunDefinition sunDef;
+			sunDef.init(ReadTextureAssetRef(reader));
+			outSkyInfoDef->addSun(std::move(sunDef));
+		}
+
+		const int moonCount = reader.readCount();
+		for (int i = 0; i < moonCount; i++)
+		{
+			SkyMoonDefinition moonDef;
+			moonDef.init(ReadTextureAssetRefs(reader));
+			outSkyInfoDef->addMoon(std::move(moonDef));
+		}
+
+		const int lightningCount = reader.readCount();
+		for (int i = 0; i < lightningCount; i++)
+		{
+			Buffer<TextureAssetReference> textureAssetRefs = ReadTextureAssetRefs(reader);
+			const double animSeconds = reader.readDouble();
+
+			SkyLightningDefinition lightningDef;
+			lightningDef.init(std::move(textureAssetRefs), animSeconds);
+			outSkyInfoDef->addLightning(std::move(lightningDef));
+		}
+
+		return reader.isValid();
+	}
+
+	// Reads a mapping buffer, rejecting indices outside the buffer they point into.
+	Buffer<int> ReadMappings(FileReader &reader, int count, int targetCount)
+	{
+		Buffer<int> mappings(count);
+		for (int i = 0; i < count; i++)
+		{
+			const int index = reader.readInt();
+			mappings.set(i, ((index >= 0) && (index < targetCount)) ? index : 0);
+		}
+
+		return mappings;
+	}
+
+	void WriteMapDef(FileWriter &writer, const MapDefinition &mapDef)
+	{
+		const MapType mapType = mapDef.getMapType();
+		writer.writeEnum(mapType);
+
+		const std::optional<int> &startLevelIndex = mapDef.getStartLevelIndex();
+		writer.writeBool(startLevelIndex.has_value());
+		writer.writeInt(startLevelIndex.value_or(0));
+
+		writer.writeInt(mapDef.getStartPointCount());
+		for (int i = 0; i < mapDef.getStartPointCount(); i++)
+		{
+			const LevelDouble2 &startPoint = mapDef.getStartPoint(i);
+			writer.writeDouble(startPoint.x);
+			writer.writeDouble(startPoint.y);
+		}
+
+		writer.writeInt(mapDef.getLevelCount());
+		for (int i = 0; i < mapDef.getLevelCount(); i++)
+		{
+			WriteLevelDef(writer, mapDef.getLevel(i));
+		}
+
+		writer.writeInt(mapDef.getLevelInfoCount());
+		for (int i = 0; i < mapDef.getLevelInfoCount(); i++)
+		{
+			WriteLevelInfoDef(writer, mapDef.getLevelInfo(i));
+		}
+
+		for (int i = 0; i < mapDef.getLevelCount(); i++)
+		{
+			writer.writeInt(mapDef.getLevelInfoIndexForLevel(i));
+		}
+
+		writer.writeInt(mapDef.getSkyCount());
+		for (int i = 0; i < mapDef.getSkyCount(); i++)
+		{
+			WriteSkyDef(writer, mapDef.getSky(i));
+		}
+
+		writer.writeInt(mapDef.getSkyInfoCount());
+		for (int i = 0; i < mapDef.getSkyInfoCount(); i++)
+		{
+			WriteSkyInfoDef(writer, mapDef.getSkyInfo(i));
+		}
+
+		for (int i = 0; i < mapDef.getLevelCount(); i++)
+		{
+			writer.writeInt(mapDef.getSkyIndexForLevel(i));
+		}
+
+		for (int i = 0; i < mapDef.getSkyCount(); i++)
+		{
+			writer.writeInt(mapDef.getSkyInfoIndexForSky(i));
+		}
+
+		if (mapType == MapType::Interior)
+		{
+			writer.writeEnum(mapDef.getInterior().getInteriorType());
+		}
+		else if (mapType == MapType::Wilderness)
+		{
+			const MapDefinition::Wild &wild = mapDef.getWild();
+			const Buffer2D<int> &levelDefIndices = wild.getLevelDefIndices();
+			writer.writeInt(levelDefIndices.getWidth());
+			writer.writeInt(levelDefIndices.getHeight());
+			for (int y = 0; y < levelDefIndices.getHeight(); y++)
+			{
+				for (int x = 0; x < levelDefIndices.getWidth(); x++)
+				{
+					writer.writeInt(levelDefIndices.get(x, y));
+				}
+			}
+
+			writer.writeU32(wild.getFallbackSeed());
+
+			const std::vector<MapGeneration::WildChunkBuildingNameInfo> &buildingNameInfos = wild.getBuildingNameInfos();
+			writer.writeInt(static_cast<int>(buildingNameInfos.size()));
+			for (const MapGeneration::WildChunkBuildingNameInfo &buildingNameInfo : buildingNameInfos)
+			{
+				writer.writeInt(buildingNameInfo.getChunk().x);
+				writer.writeInt(buildingNameInfo.getChunk().y);
+
+				// Every interior type, with -1 for ones without a building name.
+				for (int i = 0; i <= static_cast<int>(ArenaTypes::InteriorType::Tower); i++)
+				{
+					LevelDefinition::BuildingNameID buildingNameID;
+					const bool hasID = buildingNameInfo.tryGetBuildingNameID(
+						static_cast<ArenaTypes::InteriorType>(i), &buildingNameID);
+					writer.writeInt(hasID ? buildingNameID : -1);
+				}
+			}
+		}
+	}
+
+	bool TryReadMapDef(FileReader &reader, MapDefinition *outMapDef)
+	{
+		const MapType mapType = reader.readEnum<MapType>();
+
+		const bool hasStartLevelIndex = reader.readBool();
+		const int startLevelIndexValue = reader.readInt();
+		const std::optional<int> startLevelIndex = hasStartLevelIndex ?
+			std::optional<int>(startLevelIndexValue) : std::nullopt;
+
+		Buffer<LevelDouble2> startPoints(reader.readCount());
+		for (int i = 0; i < startPoints.getCount(); i++)
+		{
+			const double x = reader.readDouble();
+			const double y = reader.readDouble();
+			startPoints.set(i, LevelDouble2(x, y));
+		}
+
+		Buffer<LevelDefinition> levels(reader.readCount());
+		for (int i = 0; i < levels.getCount(); i++)
+		{
+			if (!TryReadLevelDef(reader, &levels.get(i)))
+			{
+				return false;
+			}
+		}
+
+		Buffer<LevelInfoDefinition> levelInfos(reader.readCount());
+		for (int i = 0; i < levelInfos.getCount(); i++)
+		{
+			if (!TryReadLevelInfoDef(reader, &levelInfos.get(i)))
+			{
+				return false;
+			}
+		}
+
+		Buffer<int> levelInfoMappings = ReadMappings(reader, levels.getCount(), levelInfos.getCount());
+
+		Buffer<SkyDefinition> skies(reader.readCount());
+		for (int i = 0; i < skies.getCount(); i++)
+		{
+			if (!TryReadSkyDef(reader, &skies.get(i)))
+			{
+				return false;
+			}
+		}
+
+		Buffer<SkyInfoDefinition> skyInfos(reader.readCount());
+		for (int i = 0; i < skyInfos.getCount(); i++)
+		{
+			if (!TryReadSkyInfoDef(reader, &skyInfos.get(i)))
+			{
+				return false;
+			}
+		}
+
+		Buffer<int> skyMappings = ReadMappings(reader, levels.getCount(), skies.getCount());
+		Buffer<int> skyInfoMappings = ReadMappings(reader, skies.getCount(), skyInfos.getCount());
+
+		MapDefinition::Interior interior;
+		MapDefinition::Wild wild;
+		if (mapType == MapType::Interior)
+		{
+			interior.init(reader.readEnum<ArenaTypes::InteriorType>());
+		}
+		else if (mapType == MapType::Wilderness)
+		{
+			const int width = reader.readCount();
+			const int height = reader.readCount();
+			Buffer2D<int> levelDefIndices(width, height);
+			for (int y = 0; y < height; y++)
+			{
+				for (int x = 0; x < width; x++)
+				{
+					const int levelDefIndex = reader.readInt();
+					levelDefIndices.set(x, y, ((levelDefIndex >= 0) && (levelDefIndex < levels.getCount())) ?
+						levelDefIndex : 0);
+				}
+			}
+
+			const uint32_t fallbackSeed = reader.readU32();
+
+			std::vector<MapGeneration::WildChunkBuildingNameInfo> buildingNameInfos(reader.readCount());
+			for (MapGeneration::WildChunkBuildingNameInfo &buildingNameInfo : buildingNameInfos)
+			{
+				const int chunkX = reader.readInt();
+				const int chunkY = reader.readInt();
+				buildingNameInfo.init(ChunkInt2(chunkX, chunkY));
+
+				for (int i = 0; i <= static_cast<int>(ArenaTypes::InteriorType::Tower); i++)
+				{
+					const LevelDefinition::BuildingNameID buildingNameID = reader.readInt();
+					if (buildingNameID >= 0)
+					{
+						buildingNameInfo.setBuildingNameID(static_cast<ArenaTypes::InteriorType>(i), buildingNameID);
+					}
+				}
+			}
+
+			wild.init(std::move(levelDefIndices), fallbackSeed, std::move(buildingNameInfos));
+		}
+
+		if (!reader.isValid() || !reader.isAtEnd())
+		{
+			return false;
+		}
+
+		outMapDef->initFromParts(mapType, std::move(levels), std::move(levelInfos), std::move(levelInfoMappings),
+			std::move(skies), std::move(skyInfos), std::move(skyMappings), std::move(skyInfoMappings),
+			std::move(startPoints), startLevelIndex, interior, std::move(wild));
+		return true;
+	}
+
+	void WriteHeader(FileWriter &writer, const std::string &key, uint64_t assetHash, const std::vector<uint8_t> &payload)
+	{
+		writer.writeBytes(FileMagic.data(), FileMagic.size());
+		writer.writeU32(FileVersion);
+		writer.writeU64(assetHash);
+		writer.writeString(key);
+		writer.writeU32(static_cast<uint32_t>(payload.size()));
+		writer.writeU64(GetFNV1aHash(payload.data(), payload.size()));
+	}
+}
+
+std::string MapDefinitionFile::makeFilename(const std::string &folderPath, const std::string &key)
+{
+	// Keys can be long and contain any character, so the filename uses their hash. The key itself is
+	// in the file for telling collisions apart.
+	const uint64_t keyHash = GetFNV1aHash(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+	char hashStr[17];
+	std::snprintf(hashStr, std::size(hashStr), "%016llx", static_cast<unsigned long long>(keyHash));
+	return folderPath + "map_" + hashStr + ".bin";
+}
+
+bool MapDefinitionFile::tryRead(const std::string &filename, const std::string &key, uint64_t assetHash,
+	MapDefinition *outMapDefinition)
+{
+	std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+	if (!stream.is_open())
+	{
+		return false;
+	}
+
+	const std::streamoff fileSize = stream.tellg();
+	std::vector<uint8_t> bytes(static_cast<size_t>(std::max<std::streamoff>(fileSize, 0)));
+	stream.seekg(0, std::ios::beg);
+	stream.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+	if (!stream.good())
+	{
+		return false;
+	}
+
+	FileReader reader(bytes.data(), bytes.size());
+	std::array<char, 4> magic;
+	reader.readBytes(magic.data(), magic.size());
+	const uint32_t version = reader.readU32();
+	const uint64_t fileAssetHash = reader.readU64();
+	const std::string fileKey = reader.readString();
+	const uint32_t payloadSize = reader.readU32();
+	const uint64_t payloadHash = reader.readU64();
+	if (!reader.isValid() || (magic != FileMagic) || (version != FileVersion) || (fileAssetHash != assetHash) ||
+		(fileKey != key))
+	{
+		return false;
+	}
+
+	const size_t headerSize = bytes.size() - payloadSize;
+	if ((payloadSize > bytes.size()) || (GetFNV1aHash(bytes.data() + headerSize, payloadSize) != payloadHash))
+	{
+		DebugLogWarning("Map definition file \"" + filename + "\" is damaged.");
+		return false;
+	}
+
+	MapDefinition mapDefinition;
+	FileReader payloadReader(bytes.data() + headerSize, payloadSize);
+	if (!TryReadMapDef(payloadReader, &mapDefinition))
+	{
+		DebugLogWarning("Couldn't read map definition from \"" + filename + "\".");
+		return false;
+	}
+
+	*outMapDefinition = std::move(mapDefinition);
+	return true;
+}
+
+bool MapDefinitionFile::write(const std::string &filename, const std::string &key, uint64_t assetHash,
+	const MapDefinition &mapDefinition)
+{
+	FileWriter payloadWriter;
+	WriteMapDef(payloadWriter, mapDefinition);
+	const std::vector<uint8_t> &payload = payloadWriter.getBytes();
+
+	FileWriter headerWriter;
+	WriteHeader(headerWriter, key, assetHash, payload);
+	const std::vector<uint8_t> &header = headerWriter.getBytes();
+
+	const std::string tempFilename = filename + ".tmp";
+	std::ofstream stream(tempFilename, std::ios::binary | std::ios::trunc);
+	if (!stream.is_open())
+	{
+		DebugLogWarning("Couldn't open \"" + tempFilename + "\" for writing a map definition.");
+		return false;
+	}
+
+	stream.write(reinterpret_cast<const char*>(header.data()), header.size());
+	stream.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+	stream.close();
+	if (stream.fail())
+	{
+		DebugLogWarning("Couldn't write map definition to \"" + tempFilename + "\".");
+		std::remove(tempFilename.c_str());
+		return false;
+	}
+
+	// std::rename() doesn't replace an existing file on every platform.
+	std::remove(filename.c_str());
+	if (std::rename(tempFilename.c_str(), filename.c_str()) != 0)
+	{
+		DebugLogWarning("Couldn't rename \"" + tempFilename + "\" to \"" + filename + "\".");
+		std::remove(tempFilename.c_str());
+		return false;
+	}
+
+	return true;
+}
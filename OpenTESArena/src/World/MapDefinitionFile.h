@@ -0,0 +1,30 @@
+#ifndef MAP_DEFINITION_FILE_H
+#define MAP_DEFINITION_FILE_H
+
+#include <cstdint>
+#include <string>
+
+// On-disk format for generated map definitions so a location generated in an earlier session can be loaded
+// instead of generated again. Each file has a header with a format version, the hash of the game data it
+// was generated from, and the map definition cache key it was generated with. A file whose header doesn't
+// match is ignored and overwritten the next time that map is generated.
+
+class MapDefinition;
+
+namespace MapDefinitionFile
+{
+	// Gets the file in the given folder for a map definition cache key.
+	std::string makeFilename(const std::string &folderPath, const std::string &key);
+
+	// Reads a map definition written with the same key and asset hash. Returns false if the file is missing,
+	// stale, or damaged.
+	bool tryRead(const std::string &filename, const std::string &key, uint64_t assetHash,
+		MapDefinition *outMapDefinition);
+
+	// Writes a generated map definition. Goes through a temporary file so an interrupted write can't leave
+	// a damaged file behind.
+	bool write(const std::string &filename, const std::string &key, uint64_t assetHash,
+		const MapDefinition &mapDefinition);
+}
+
+#endif
@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <chrono>
+#include <memory>
 #include <unordered_map>
 
 #include "ArenaCityUtils.h"
@@ -26,6 +28,9 @@
 #include "../Entities/EntityDefinitionLibrary.h"
 #include "../Entities/EntityType.h"
 #include "../Math/Random.h"
+#include "../Media/TextureManager.h"
+#include "../Utilities/Platform.h"
+#include "../Utilities/ThreadPool.h"
 #include "../WorldMap/ArenaLocationUtils.h"
 
 #include "components/debug/Debug.h"
@@ -43,6 +48,72 @@ namespace MapGeneration
 	using ArenaBuildingNameMappingCache = std::unordered_map<std::string, LevelDefinition::BuildingNameID>;
 	using ArenaDoorMappingCache = std::unordered_map<ArenaTypes::VoxelID, LevelDefinition::DoorDefID>;
 
+	// .RMD voxels of one unique wilderness block after city block revision, before conversion to a level.
+	struct WildBlockVoxels
+	{
+		Buffer2D<ArenaTypes::VoxelID> flor, map1, map2;
+
+		void init(int width, int depth)
+		{
+			this->flor.init(width, depth);
+			this->map1.init(width, depth);
+			this->map2.init(width, depth);
+		}
+	};
+
+	// Gets seconds elapsed since the given time point, for logging generation phases.
+	double GetSecondsSince(const std::chrono::high_resolution_clock::time_point &startTime)
+	{
+		const auto endTime = std::chrono::high_resolution_clock::now();
+		const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime);
+		return static_cast<double>(elapsed.count()) / static_cast<double>(std::nano::den);
+	}
+
+	// Copies a wilderness block's .RMD voxels into the given buffers and revises it if it's a city block.
+	// Only reads shared data, so it is safe to call from multiple threads.
+	void ReadWildBlockVoxels(ArenaWildUtils::WildBlockID wildBlockID, const LocationDefinition::CityDefinition &cityDef,
+		const BinaryAssetLibrary &binaryAssetLibrary, WildBlockVoxels &outVoxels)
+	{
+		const auto &rmdFiles = binaryAssetLibrary.getWildernessChunks();
+		const int rmdIndex = DebugMakeIndex(rmdFiles, wildBlockID - 1);
+		const RMDFile &rmd = rmdFiles[rmdIndex];
+		const BufferView2D<const ArenaTypes::VoxelID> rmdFLOR = rmd.getFLOR();
+		const BufferView2D<const ArenaTypes::VoxelID> rmdMAP1 = rmd.getMAP1();
+		const BufferView2D<const ArenaTypes::VoxelID> rmdMAP2 = rmd.getMAP2();
+
+		Buffer2D<ArenaTypes::VoxelID> &tempFlor = outVoxels.flor;
+		Buffer2D<ArenaTypes::VoxelID> &tempMap1 = outVoxels.map1;
+		Buffer2D<ArenaTypes::VoxelID> &tempMap2 = outVoxels.map2;
+
+		// Copy .RMD voxels into temp buffers.
+		for (int y = 0; y < tempFlor.getHeight(); y++)
+		{
+			for (int x = 0; x < tempFlor.getWidth(); x++)
+			{
+				const ArenaTypes::VoxelID rmdFlorID = rmdFLOR.get(x, y);
+				const ArenaTypes::VoxelID rmdMap1ID = rmdMAP1.get(x, y);
+				const ArenaTypes::VoxelID rmdMap2ID = rmdMAP2.get(x, y);
+				tempFlor.set(x, y, rmdFlorID);
+				tempMap1.set(x, y, rmdMap1ID);
+				tempMap2.set(x, y, rmdMap2ID);
+			}
+		}
+
+		if (ArenaWildUtils::isWildCityBlock(wildBlockID))
+		{
+			// Change the placeholder WILD00{1..4}.RMD block to the one for the given city.
+			BufferView2D<ArenaTypes::VoxelID> tempFlorView(
+				tempFlor.get(), tempFlor.getWidth(), tempFlor.getHeight());
+			BufferView2D<ArenaTypes::VoxelID> tempMap1View(
+				tempMap1.get(), tempMap1.getWidth(), tempMap1.getHeight());
+			BufferView2D<ArenaTypes::VoxelID> tempMap2View(
+				tempMap2.get(), tempMap2.getWidth(), tempMap2.getHeight());
+
+			ArenaWildUtils::reviseWildCityBlock(wildBlockID, tempFlorView, tempMap1View, tempMap2View,
+				cityDef, binaryAssetLibrary);
+		}
+	}
+
 	// Converts the given Arena *MENU ID to a modern interior type, if any.
 	std::optional<ArenaTypes::InteriorType> tryGetInteriorTypeFromMenuIndex(int menuIndex, MapType mapType)
 	{
@@ -183,7 +254,7 @@ namespace MapGeneration
 
 			// The entity can only be instantiated if there is at least an idle animation.
 			const std::optional<int> idleStateIndex = entityAnimDef.tryGetStateIndex(
-				EntityAnimationUtils::STATE_IDLE.c_str());
+				EntityAnimationStateType::Idle);
 			if (!idleStateIndex.has_value())
 			{
 				DebugLogWarning("Missing static entity idle anim state for flat \"" +
@@ -206,7 +277,7 @@ namespace MapGeneration
 
 			// Must have at least an idle animation.
 			const std::optional<int> idleStateIndex = entityAnimDef.tryGetStateIndex(
-				EntityAnimationUtils::STATE_IDLE.c_str());
+				EntityAnimationStateType::Idle);
 			if (!idleStateIndex.has_value())
 			{
 				DebugLogWarning("Missing dynamic entity idle anim state for flat \"" +
@@ -1279,6 +1350,203 @@ namespace MapGeneration
 		}
 	}
 
+	// A wilderness block converted on its own, with IDs local to its own level info definition so blocks can
+	// be converted in parallel. Merged into the shared level info definition afterwards.
+	struct WildBlockLevel
+	{
+		LevelDefinition levelDef;
+		LevelInfoDefinition levelInfoDef;
+		ArenaVoxelMappingCache florMappings, map1Mappings, map2Mappings;
+		ArenaEntityMappingCache entityMappings;
+		ArenaTransitionMappingCache transitionMappings;
+		ArenaDoorMappingCache doorMappings;
+	};
+
+	// Converts a wilderness block's voxels into its own level. Only reads shared data, so it is safe to call
+	// from multiple threads as long as each has its own texture manager.
+	void ConvertWildBlock(const WildBlockVoxels &voxels, const LocationDefinition::CityDefinition &cityDef,
+		const INFFile &inf, const CharacterClassLibrary &charClassLibrary,
+		const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
+		TextureManager &textureManager, SNInt width, int height, WEInt depth, double ceilingScale,
+		WildBlockLevel &outBlockLevel)
+	{
+		LevelDefinition &levelDef = outBlockLevel.levelDef;
+		LevelInfoDefinition &levelInfoDef = outBlockLevel.levelInfoDef;
+		levelDef.init(width, height, depth);
+		levelInfoDef.init(ceilingScale);
+
+		// Local voxel def 0 stands in for voxels the block leaves empty, which must stay 0 after merging.
+		levelInfoDef.addVoxelDef(VoxelDefinition());
+
+		const BufferView2D<const ArenaTypes::VoxelID> florView(
+			voxels.flor.get(), voxels.flor.getWidth(), voxels.flor.getHeight());
+		const BufferView2D<const ArenaTypes::VoxelID> map1View(
+			voxels.map1.get(), voxels.map1.getWidth(), voxels.map1.getHeight());
+		const BufferView2D<const ArenaTypes::VoxelID> map2View(
+			voxels.map2.get(), voxels.map2.getWidth(), voxels.map2.getHeight());
+
+		constexpr MapType mapType = MapType::Wilderness;
+		constexpr std::optional<ArenaTypes::InteriorType> interiorType; // Wilderness is not an interior.
+
+		// Dungeon definition if this chunk has any dungeons.
+		const uint32_t dungeonSeed = cityDef.provinceSeed;
+		LocationDefinition::DungeonDefinition dungeonDef;
+		dungeonDef.init(dungeonSeed, ArenaWildUtils::WILD_DUNGEON_WIDTH_CHUNKS, ArenaWildUtils::WILD_DUNGEON_HEIGHT_CHUNKS);
+
+		constexpr std::optional<bool> isArtifactDungeon = false; // No artifacts in wild dungeons.
+
+		MapGeneration::readArenaFLOR(florView, mapType, interiorType, cityDef.rulerIsMale, inf,
+			charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, &levelDef,
+			&levelInfoDef, &outBlockLevel.florMappings, &outBlockLevel.entityMappings);
+		MapGeneration::readArenaMAP1(map1View, mapType, interiorType, cityDef.rulerSeed, cityDef.rulerIsMale,
+			cityDef.palaceIsMainQuestDungeon, cityDef.type, &dungeonDef, isArtifactDungeon, inf, charClassLibrary,
+			entityDefLibrary, binaryAssetLibrary, textureManager, &levelDef, &levelInfoDef,
+			&outBlockLevel.map1Mappings, &outBlockLevel.entityMappings, &outBlockLevel.transitionMappings,
+			&outBlockLevel.doorMappings);
+		MapGeneration::readArenaMAP2(map2View, inf, &levelDef, &levelInfoDef, &outBlockLevel.map2Mappings);
+	}
+
+	// Local ID of a block's definition -> the Arena voxel it was made from and the shared cache for it.
+	template <typename CacheType>
+	using WildBlockLocalKeys = std::vector<std::pair<CacheType*, ArenaTypes::VoxelID>>;
+
+	template <typename CacheType>
+	void AddWildBlockLocalKeys(const CacheType &localCache, CacheType *sharedCache,
+		WildBlockLocalKeys<CacheType> &localKeys)
+	{
+		for (const auto &pair : localCache)
+		{
+			DebugAssertIndex(localKeys, pair.second);
+			localKeys[pair.second] = std::make_pair(sharedCache, pair.first);
+		}
+	}
+
+	// Maps each of a block's local IDs to a shared one, adding definitions the shared level info doesn't have
+	// yet. Local IDs are visited in the order they were made, so shared IDs come out the same as converting
+	// every block in sequence with the shared caches.
+	template <typename CacheType, typename AddDefFunc>
+	std::vector<int> MergeWildBlockIDs(const WildBlockLocalKeys<CacheType> &localKeys, int firstLocalID,
+		const AddDefFunc &addDef)
+	{
+		std::vector<int> sharedIDs(localKeys.size(), 0);
+		for (int localID = firstLocalID; localID < static_cast<int>(localKeys.size()); localID++)
+		{
+			CacheType *sharedCache = localKeys[localID].first;
+			const ArenaTypes::VoxelID arenaVoxel = localKeys[localID].second;
+			DebugAssert(sharedCache != nullptr);
+
+			const auto iter = sharedCache->find(arenaVoxel);
+			if (iter != sharedCache->end())
+			{
+				sharedIDs[localID] = iter->second;
+			}
+			else
+			{
+				const int sharedID = addDef(localID);
+				sharedCache->insert(std::make_pair(arenaVoxel, sharedID));
+				sharedIDs[localID] = sharedID;
+			}
+		}
+
+		return sharedIDs;
+	}
+
+	// Adds a converted wilderness block's definitions to the shared level info definition and writes its
+	// level with the shared IDs. Blocks must be merged in block order to keep IDs deterministic.
+	void MergeWildBlock(const WildBlockLevel &blockLevel, LevelDefinition *outLevelDef,
+		LevelInfoDefinition *outLevelInfoDef, ArenaVoxelMappingCache *florMappings,
+		ArenaVoxelMappingCache *map1Mappings, ArenaVoxelMappingCache *map2Mappings,
+		ArenaEntityMappingCache *entityMappings, ArenaTransitionMappingCache *transitionMappings,
+		ArenaDoorMappingCache *doorMappings)
+	{
+		const LevelDefinition &levelDef = blockLevel.levelDef;
+		const LevelInfoDefinition &levelInfoDef = blockLevel.levelInfoDef;
+
+		WildBlockLocalKeys<ArenaVoxelMappingCache> voxelKeys(levelInfoDef.getVoxelDefCount());
+		AddWildBlockLocalKeys(blockLevel.florMappings, florMappings, voxelKeys);
+		AddWildBlockLocalKeys(blockLevel.map1Mappings, map1Mappings, voxelKeys);
+		AddWildBlockLocalKeys(blockLevel.map2Mappings, map2Mappings, voxelKeys);
+
+		WildBlockLocalKeys<ArenaEntityMappingCache> entityKeys(levelInfoDef.getEntityDefCount());
+		AddWildBlockLocalKeys(blockLevel.entityMappings, entityMappings, entityKeys);
+
+		WildBlockLocalKeys<ArenaTransitionMappingCache> transitionKeys(levelInfoDef.getTransitionDefCount());
+		AddWildBlockLocalKeys(blockLevel.transitionMappings, transitionMappings, transitionKeys);
+
+		WildBlockLocalKeys<ArenaDoorMappingCache> doorKeys(levelInfoDef.getDoorDefCount());
+		AddWildBlockLocalKeys(blockLevel.doorMappings, doorMappings, doorKeys);
+
+		// Local voxel def 0 is the empty placeholder and keeps ID 0.
+		const std::vector<int> voxelDefIDs = MergeWildBlockIDs(voxelKeys, 1,
+			[&levelInfoDef, outLevelInfoDef](int localID)
+		{
+			return outLevelInfoDef->addVoxelDef(VoxelDefinition(levelInfoDef.getVoxelDef(localID)));
+		});
+
+		const std::vector<int> entityDefIDs = MergeWildBlockIDs(entityKeys, 0,
+			[&levelInfoDef, outLevelInfoDef](int localID)
+		{
+			return outLevelInfoDef->addEntityDef(EntityDefinition(levelInfoDef.getEntityDef(localID)));
+		});
+
+		const std::vector<int> transitionDefIDs = MergeWildBlockIDs(transitionKeys, 0,
+			[&levelInfoDef, outLevelInfoDef](int localID)
+		{
+			return outLevelInfoDef->addTransitionDef(TransitionDefinition(levelInfoDef.getTransitionDef(localID)));
+		});
+
+		const std::vector<int> doorDefIDs = MergeWildBlockIDs(doorKeys, 0,
+			[&levelInfoDef, outLevelInfoDef](int localID)
+		{
+			return outLevelInfoDef->addDoorDef(DoorDefinition(levelInfoDef.getDoorDef(localID)));
+		});
+
+		for (WEInt z = 0; z < levelDef.getDepth(); z++)
+		{
+			for (int y = 0; y < levelDef.getHeight(); y++)
+			{
+				for (SNInt x = 0; x < levelDef.getWidth(); x++)
+				{
+					const LevelDefinition::VoxelDefID localID = levelDef.getVoxel(x, y, z);
+					outLevelDef->setVoxel(x, y, z, voxelDefIDs[localID]);
+				}
+			}
+		}
+
+		// Placement definitions are in order of first use and keep that order with shared IDs.
+		for (int i = 0; i < levelDef.getEntityPlacementDefCount(); i++)
+		{
+			const LevelDefinition::EntityPlacementDef &placementDef = levelDef.getEntityPlacementDef(i);
+			for (const LevelDouble3 &position : placementDef.positions)
+			{
+				outLevelDef->addEntity(entityDefIDs[placementDef.id], position);
+			}
+		}
+
+		for (int i = 0; i < levelDef.getTransitionPlacementDefCount(); i++)
+		{
+			const LevelDefinition::TransitionPlacementDef &placementDef = levelDef.getTransitionPlacementDef(i);
+			for (const LevelInt3 &position : placementDef.positions)
+			{
+				outLevelDef->addTransition(transitionDefIDs[placementDef.id], position);
+			}
+		}
+
+		for (int i = 0; i < levelDef.getDoorPlacementDefCount(); i++)
+		{
+			const LevelDefinition::DoorPlacementDef &placementDef = levelDef.getDoorPlacementDef(i);
+			for (const LevelInt3 &position : placementDef.positions)
+			{
+				outLevelDef->addDoor(doorDefIDs[placementDef.id], position);
+			}
+		}
+
+		// .RMD blocks have no locks or triggers, and building names are generated per chunk after merging.
+		DebugAssert(levelDef.getLockPlacementDefCount() == 0);
+		DebugAssert(levelDef.getTriggerPlacementDefCount() == 0);
+		DebugAssert(levelDef.getBuildingNamePlacementDefCount() == 0);
+	}
+
 	void generateArenaDungeonLevel(const MIFFile &mif, WEInt widthChunks, SNInt depthChunks,
 		int levelUpBlock, const std::optional<int> &levelDownBlock, ArenaRandom &random,
 		MapType mapType, ArenaTypes::InteriorType interiorType, const std::optional<bool> &rulerIsMale,
@@ -2252,80 +2520,58 @@ void MapGeneration::generateRmdWilderness(const BufferView<const ArenaWildUtils:
 	ArenaBuildingNameMappingCache buildingNameMappings;
 	ArenaDoorMappingCache doorMappings;
 
-	// Create temp voxel data buffers to be used by each wilderness chunk.
-	constexpr int chunkDim = ChunkUtils::CHUNK_DIM;
-	Buffer2D<ArenaTypes::VoxelID> tempFlor(chunkDim, chunkDim);
-	Buffer2D<ArenaTypes::VoxelID> tempMap1(chunkDim, chunkDim);
-	Buffer2D<ArenaTypes::VoxelID> tempMap2(chunkDim, chunkDim);
+	// Read and convert each unique block into its own level with block-local IDs. This is independent per
+	// block (city blocks regenerate the whole city) so it is split across threads. Each thread reuses one set
+	// of .RMD voxel buffers and has its own texture manager since that isn't thread-safe.
+	const auto convertStartTime = std::chrono::high_resolution_clock::now();
+	const int blockCount = uniqueWildBlockIDs.getCount();
+	Buffer<WildBlockLevel> blockLevels(blockCount);
 
-	for (int i = 0; i < uniqueWildBlockIDs.getCount(); i++)
+	auto convertBlocks = [&uniqueWildBlockIDs, &cityDef, &inf, &charClassLibrary, &entityDefLibrary,
+		&binaryAssetLibrary, &textureManager, &outLevelDefs, outLevelInfoDef, &blockLevels](
+		int threadIndex, int threadCount)
 	{
-		const ArenaWildUtils::WildBlockID wildBlockID = uniqueWildBlockIDs.get(i);
-		const auto &rmdFiles = binaryAssetLibrary.getWildernessChunks();
-		const int rmdIndex = DebugMakeIndex(rmdFiles, wildBlockID - 1);
-		const RMDFile &rmd = rmdFiles[rmdIndex];
-		const BufferView2D<const ArenaTypes::VoxelID> rmdFLOR = rmd.getFLOR();
-		const BufferView2D<const ArenaTypes::VoxelID> rmdMAP1 = rmd.getMAP1();
-		const BufferView2D<const ArenaTypes::VoxelID> rmdMAP2 = rmd.getMAP2();
+		constexpr int chunkDim = ChunkUtils::CHUNK_DIM;
+		WildBlockVoxels voxels;
+		voxels.init(chunkDim, chunkDim);
 
-		// Copy .RMD voxels into temp buffers.
-		for (int y = 0; y < tempFlor.getHeight(); y++)
+		std::unique_ptr<TextureManager> threadTextureManager;
+		if (threadIndex > 0)
 		{
-			for (int x = 0; x < tempFlor.getWidth(); x++)
-			{
-				const ArenaTypes::VoxelID rmdFlorID = rmdFLOR.get(x, y);
-				const ArenaTypes::VoxelID rmdMap1ID = rmdMAP1.get(x, y);
-				const ArenaTypes::VoxelID rmdMap2ID = rmdMAP2.get(x, y);
-				tempFlor.set(x, y, rmdFlorID);
-				tempMap1.set(x, y, rmdMap1ID);
-				tempMap2.set(x, y, rmdMap2ID);
-			}
+			threadTextureManager = std::make_unique<TextureManager>();
 		}
 
-		if (ArenaWildUtils::isWildCityBlock(wildBlockID))
+		TextureManager &blockTextureManager = (threadIndex > 0) ? *threadTextureManager : textureManager;
+		for (int i = threadIndex; i < blockLevels.getCount(); i += threadCount)
 		{
-			// Change the placeholder WILD00{1..4}.RMD block to the one for the given city.
-			BufferView2D<ArenaTypes::VoxelID> tempFlorView(
-				tempFlor.get(), tempFlor.getWidth(), tempFlor.getHeight());
-			BufferView2D<ArenaTypes::VoxelID> tempMap1View(
-				tempMap1.get(), tempMap1.getWidth(), tempMap1.getHeight());
-			BufferView2D<ArenaTypes::VoxelID> tempMap2View(
-				tempMap2.get(), tempMap2.getWidth(), tempMap2.getHeight());
-
-			ArenaWildUtils::reviseWildCityBlock(wildBlockID, tempFlorView, tempMap1View, tempMap2View,
-				cityDef, binaryAssetLibrary);
+			const LevelDefinition &levelDef = outLevelDefs.get(i);
+			ReadWildBlockVoxels(uniqueWildBlockIDs.get(i), cityDef, binaryAssetLibrary, voxels);
+			ConvertWildBlock(voxels, cityDef, inf, charClassLibrary, entityDefLibrary, binaryAssetLibrary,
+				blockTextureManager, levelDef.getWidth(), levelDef.getHeight(), levelDef.getDepth(),
+				outLevelInfoDef->getCeilingScale(), blockLevels.get(i));
 		}
+	};
 
-		LevelDefinition &levelDef = outLevelDefs.get(i);
-
-		const BufferView2D<const ArenaTypes::VoxelID> tempFlorConstView(
-			tempFlor.get(), tempFlor.getWidth(), tempFlor.getHeight());
-		const BufferView2D<const ArenaTypes::VoxelID> tempMap1ConstView(
-			tempMap1.get(), tempMap1.getWidth(), tempMap1.getHeight());
-		const BufferView2D<const ArenaTypes::VoxelID> tempMap2ConstView(
-			tempMap2.get(), tempMap2.getWidth(), tempMap2.getHeight());
-
-		constexpr MapType mapType = MapType::Wilderness;
-		constexpr std::optional<ArenaTypes::InteriorType> interiorType; // Wilderness is not an interior.
-		
-		// Dungeon definition if this chunk has any dungeons.
-		const uint32_t dungeonSeed = cityDef.provinceSeed;
-		LocationDefinition::DungeonDefinition dungeonDef;
-		dungeonDef.init(dungeonSeed, ArenaWildUtils::WILD_DUNGEON_WIDTH_CHUNKS, ArenaWildUtils::WILD_DUNGEON_HEIGHT_CHUNKS);
+	// This usually runs on a map generation worker, so it has its own threads instead of the game's.
+	ThreadPool threadPool;
+	threadPool.init(std::min(Platform::getThreadCount(), blockCount));
+	threadPool.run(blockCount, convertBlocks);
 
-		constexpr std::optional<bool> isArtifactDungeon = false; // No artifacts in wild dungeons.
+	const double convertTime = GetSecondsSince(convertStartTime);
 
-		MapGeneration::readArenaFLOR(tempFlorConstView, mapType, interiorType, cityDef.rulerIsMale, inf,
-			charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, &levelDef,
-			outLevelInfoDef, &florMappings, &entityMappings);
-		MapGeneration::readArenaMAP1(tempMap1ConstView, mapType, interiorType, cityDef.rulerSeed, cityDef.rulerIsMale,
-			cityDef.palaceIsMainQuestDungeon, cityDef.type, &dungeonDef, isArtifactDungeon, inf, charClassLibrary,
-			entityDefLibrary, binaryAssetLibrary, textureManager, &levelDef, outLevelInfoDef, &map1Mappings,
-			&entityMappings, &transitionMappings, &doorMappings);
-		MapGeneration::readArenaMAP2(tempMap2ConstView, inf, &levelDef, outLevelInfoDef, &map2Mappings);
+	// Merge blocks into the shared level info definition in block order so definition IDs are the same as
+	// converting them one after another.
+	const auto mergeStartTime = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < blockCount; i++)
+	{
+		MergeWildBlock(blockLevels.get(i), &outLevelDefs.get(i), outLevelInfoDef, &florMappings, &map1Mappings,
+			&map2Mappings, &entityMappings, &transitionMappings, &doorMappings);
 	}
 
+	const double mergeTime = GetSecondsSince(mergeStartTime);
+
 	// Generate chunk-wise building names for the wilderness.
+	const auto buildingNamesStartTime = std::chrono::high_resolution_clock::now();
 	for (WEInt z = 0; z < levelDefIndices.getHeight(); z++)
 	{
 		for (SNInt x = 0; x < levelDefIndices.getWidth(); x++)
@@ -2347,6 +2593,12 @@ void MapGeneration::generateRmdWilderness(const BufferView<const ArenaWildUtils:
 			}
 		}
 	}
+
+	const double buildingNamesTime = GetSecondsSince(buildingNamesStartTime);
+	DebugLog("Generated " + std::to_string(blockCount) + " wilderness blocks on " + std::to_string(threadPool.getThreadCount()) +
+		" thread(s) (read and convert: " + String::fixedPrecision(convertTime * 1000.0, 2) + "ms, merge: " +
+		String::fixedPrecision(mergeTime * 1000.0, 2) + "ms, building names: " +
+		String::fixedPrecision(buildingNamesTime * 1000.0, 2) + "ms).");
 }
 
 void MapGeneration::readMifLocks(const BufferView<const MIFFile::Level> &levels, const INFFile &inf,
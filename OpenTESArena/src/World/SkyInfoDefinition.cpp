@@ -2,6 +2,31 @@
 
 #include "components/debug/Debug.h"
 
+int SkyInfoDefinition::getLandCount() const
+{
+	return static_cast<int>(this->lands.size());
+}
+
+int SkyInfoDefinition::getAirCount() const
+{
+	return static_cast<int>(this->airs.size());
+}
+
+int SkyInfoDefinition::getStarCount() const
+{
+	return static_cast<int>(this->stars.size());
+}
+
+int SkyInfoDefinition::getSunCount() const
+{
+	return static_cast<int>(this->suns.size());
+}
+
+int SkyInfoDefinition::getMoonCount() const
+{
+	return static_cast<int>(this->moons.size());
+}
+
 const SkyLandDefinition &SkyInfoDefinition::getLand(SkyDefinition::LandDefID id) const
 {
 	DebugAssertIndex(this->lands, id);
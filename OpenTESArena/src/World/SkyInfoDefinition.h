@@ -25,6 +25,12 @@ private:
 	// Not referenced by SkyDefinition since lightning bolts are generated at random placements.
 	std::vector<SkyLightningDefinition> lightnings;
 public:
+	int getLandCount() const;
+	int getAirCount() const;
+	int getStarCount() const;
+	int getSunCount() const;
+	int getMoonCount() const;
+
 	const SkyLandDefinition &getLand(SkyDefinition::LandDefID id) const;
 	const SkyAirDefinition &getAir(SkyDefinition::AirDefID id) const;
 	const SkyStarDefinition &getStar(SkyDefinition::StarDefID id) const;
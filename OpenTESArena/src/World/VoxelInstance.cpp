@@ -333,6 +333,11 @@ bool VoxelInstance::hasRelevantState() const
 	}
 }
 
+bool VoxelInstance::isAnimating() const
+{
+	return (this->type == Type::OpenDoor) || (this->type == Type::Fading);
+}
+
 void VoxelInstance::update(double dt)
 {
 	if (this->type == Type::OpenDoor)
@@ -125,6 +125,10 @@ public:
 	// Returns whether the voxel instance is worth keeping alive because it has unique data active.
 	bool hasRelevantState() const;
 
+	// Returns whether the voxel instance's state changes over time and it needs updating every frame
+	// (i.e., doors and fading voxels). Other instances like chasms are only changed by outside events.
+	bool isAnimating() const;
+
 	void update(double dt);
 };
 
@@ -0,0 +1,16 @@
+#ifndef VOXEL_TRAIT_TYPE_H
+#define VOXEL_TRAIT_TYPE_H
+
+// Properties of a voxel that chunks keep in packed bitfields so collision and pathing checks don't
+// need to look up voxel definitions.
+
+enum class VoxelTraitType
+{
+	Empty, // Air.
+	Solid, // Blocks movement unless it's an open door. Level change walls can be walked into.
+	Floor, // Walkable floor.
+	Chasm,
+	Door
+};
+
+#endif
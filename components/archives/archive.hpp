@@ -1,6 +1,7 @@
 #ifndef COMPONENTS_ARCHIVES_ARCHIVE_HPP
 #define COMPONENTS_ARCHIVES_ARCHIVE_HPP
 
+#include <cstddef>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -61,6 +62,29 @@ public:
     }
 };
 
+// Stream over a read-only range of memory, i.e. an entry in a memory-mapped archive. Avoids opening
+// a file handle per entry.
+class MemoryStreamBuf : public std::streambuf {
+public:
+    MemoryStreamBuf(const std::byte *data, size_t size);
+
+    virtual pos_type seekoff(off_type offset, std::ios_base::seekdir whence, std::ios_base::openmode mode);
+    virtual pos_type seekpos(pos_type pos, std::ios_base::openmode mode);
+};
+
+class MemoryStream : public std::istream {
+public:
+    MemoryStream(const std::byte *data, size_t size)
+        : std::istream(new MemoryStreamBuf(data, size))
+    {
+    }
+
+    ~MemoryStream()
+    {
+        delete rdbuf();
+    }
+};
+
 
 class Archive {
 public:
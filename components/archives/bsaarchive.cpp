@@ -2,6 +2,21 @@
 #include <sstream>
 #include <fstream>
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "bsaarchive.hpp"
 #include "../dos/DOSUtils.h"
 
@@ -53,8 +68,85 @@ void BsaArchive::loadNamed(size_t count, std::istream& stream)
     }
 }
 
+BsaArchive::~BsaArchive()
+{
+    unmap();
+}
+
+void BsaArchive::map()
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(mFilename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+        return;
+
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    if(GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mapping == nullptr)
+    {
+        CloseHandle(file);
+        return;
+    }
+
+    const void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if(data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return;
+    }
+
+    mFileHandle = file;
+    mMappingHandle = mapping;
+    mMappedData = static_cast<const std::byte*>(data);
+    mMappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = ::open(mFilename.c_str(), O_RDONLY);
+    if(fd < 0)
+        return;
+
+    struct stat fileStat;
+    if(fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        ::close(fd);
+        return;
+    }
+
+    void *data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps its own reference to the file.
+    if(data == MAP_FAILED)
+        return;
+
+    mMappedData = static_cast<const std::byte*>(data);
+    mMappedSize = static_cast<size_t>(fileStat.st_size);
+#endif
+}
+
+void BsaArchive::unmap()
+{
+    if(mMappedData == nullptr)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(mMappedData);
+    CloseHandle(static_cast<HANDLE>(mMappingHandle));
+    CloseHandle(static_cast<HANDLE>(mFileHandle));
+    mMappingHandle = nullptr;
+    mFileHandle = nullptr;
+#else
+    munmap(const_cast<std::byte*>(mMappedData), mMappedSize);
+#endif
+
+    mMappedData = nullptr;
+    mMappedSize = 0;
+}
+
 void BsaArchive::load(const std::string &fname)
 {
+    unmap();
     mFilename = fname;
 
     std::ifstream stream(mFilename, std::ios::binary);
@@ -65,10 +157,31 @@ void BsaArchive::load(const std::string &fname)
 
     mEntries.reserve(count);
     loadNamed(count, stream);
+
+    // Falls back to opening a file stream per entry if this fails.
+    map();
+    if(mMappedData != nullptr)
+    {
+        const bool entriesInRange = std::all_of(mEntries.begin(), mEntries.end(),
+            [this](const Entry &entry) { return static_cast<size_t>(entry.mEnd) <= mMappedSize; });
+        if(!entriesInRange)
+            unmap();
+    }
+}
+
+const BsaArchive::Entry *BsaArchive::findEntry(const char *name) const
+{
+    auto iter = std::lower_bound(mLookupName.begin(), mLookupName.end(), name);
+    if(iter == mLookupName.end() || *iter != name)
+        return nullptr;
+    return &mEntries[std::distance(mLookupName.begin(), iter)];
 }
 
 IStreamPtr BsaArchive::open(const Entry &entry)
 {
+    if(mMappedData != nullptr)
+        return IStreamPtr(new MemoryStream(mMappedData + entry.mStart, static_cast<size_t>(entry.mEnd - entry.mStart)));
+
     std::unique_ptr<std::istream> stream(new std::ifstream(mFilename, std::ios::binary));
     if(!stream->seekg(entry.mStart))
         return IStreamPtr(nullptr);
@@ -77,10 +190,24 @@ IStreamPtr BsaArchive::open(const Entry &entry)
 
 IStreamPtr BsaArchive::open(const char *name)
 {
-    auto iter = std::lower_bound(mLookupName.begin(), mLookupName.end(), name);
-    if(iter == mLookupName.end() || *iter != name)
+    const Entry *entry = findEntry(name);
+    if(entry == nullptr)
         return IStreamPtr(nullptr);
-    return open(mEntries[std::distance(mLookupName.begin(), iter)]);
+    return open(*entry);
+}
+
+bool BsaArchive::tryGetMappedEntry(const char *name, const std::byte **outData, size_t *outSize) const
+{
+    if(mMappedData == nullptr)
+        return false;
+
+    const Entry *entry = findEntry(name);
+    if(entry == nullptr)
+        return false;
+
+    *outData = mMappedData + entry->mStart;
+    *outSize = static_cast<size_t>(entry->mEnd - entry->mStart);
+    return true;
 }
 
 bool BsaArchive::exists(const char *name) const
@@ -1,6 +1,7 @@
 #ifndef COMPONENTS_ARCHIVES_BSAARCHIVE_HPP
 #define COMPONENTS_ARCHIVES_BSAARCHIVE_HPP
 
+#include <cstddef>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -23,13 +24,36 @@ class BsaArchive : public Archive {
 
     std::string mFilename;
 
+    // The whole archive mapped read-only into memory when the platform allows it, so entries can be
+    // handed out without opening a stream or copying. Null if mapping failed.
+    const std::byte *mMappedData = nullptr;
+    size_t mMappedSize = 0;
+#ifdef _WIN32
+    void *mFileHandle = nullptr;
+    void *mMappingHandle = nullptr;
+#endif
+
     void loadNamed(size_t count, std::istream &stream);
+    void map();
+    void unmap();
 
+    const Entry *findEntry(const char *name) const;
     IStreamPtr open(const Entry &entry);
 
 public:
+    BsaArchive() = default;
+    BsaArchive(const BsaArchive&) = delete;
+    BsaArchive& operator=(const BsaArchive&) = delete;
+    ~BsaArchive();
+
     void load(const std::string &fname);
 
+    bool isMapped() const { return mMappedData != nullptr; }
+
+    // Gets a read-only view of an entry's bytes inside the mapped archive. Returns false if the entry
+    // doesn't exist or the archive isn't mapped.
+    bool tryGetMappedEntry(const char *name, const std::byte **outData, size_t *outSize) const;
+
     virtual IStreamPtr open(const char *name) override;
     virtual bool exists(const char *name) const override;
     virtual const std::vector<std::string> &list() const override final { return mLookupName; }
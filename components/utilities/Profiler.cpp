@@ -5,13 +5,13 @@
 
 double Profiler::Sampler::getSeconds() const
 {
-	return static_cast<double>((this->endTime - this->startTime).count()) /
-		static_cast<double>(std::nano::den);
+	return std::chrono::duration_cast<std::chrono::duration<double>>(this->endTime - this->startTime).count();
 }
 
 double Profiler::Sampler::getMilliseconds() const
 {
-	return this->getSeconds() * 1000.0;
+	return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+		this->endTime - this->startTime).count();
 }
 
 void Profiler::Sampler::setStart()
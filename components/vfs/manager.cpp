@@ -10,25 +10,196 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cassert> // @todo: replace with DebugAssert
 #include <cctype>
 #include <cstring>
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 #include "../archives/bsaarchive.hpp"
 #include "../debug/Debug.h"
+#include "../utilities/String.h"
 
 namespace
 {
 	std::vector<std::string> gRootPaths;
 	Archives::BsaArchive gGlobalBsa;
+
+	// Read totals. Atomic since assets can be loaded from worker threads.
+	std::atomic<int> gReadFileCount(0);
+	std::atomic<int> gReadMappedFileCount(0);
+	std::atomic<size_t> gReadByteCount(0);
+
+	void AddReadStats(size_t byteCount, bool mapped)
+	{
+		gReadFileCount++;
+		gReadByteCount += byteCount;
+		if (mapped)
+		{
+			gReadMappedFileCount++;
+		}
+	}
+
+	// Where a file physically is, for case-insensitive lookups.
+	struct IndexEntry
+	{
+		int rootPathIndex; // Index into root paths, or -1 for GLOBAL.BSA.
+		std::string name; // Name with its actual casing.
+	};
+
+	// Lowercase filename -> physical location, built when data paths are added so case-insensitive
+	// opening is one hash lookup instead of trying several casings against each data path.
+	std::unordered_map<std::string, IndexEntry> gCaseInsensitiveIndex;
+	std::atomic<int> gIndexedLookupCount(0);
+	std::atomic<int> gAvoidedOpenCount(0);
+
+	constexpr int GLOBAL_BSA_INDEX = -1;
+
+	std::string ToLower(const std::string &name)
+	{
+		std::string lowerName = name;
+		for (char &c : lowerName)
+		{
+			c = std::tolower(c);
+		}
+
+		return lowerName;
+	}
+
+	const IndexEntry *FindIndexEntry(const char *name)
+	{
+		const auto iter = gCaseInsensitiveIndex.find(ToLower(name));
+		return (iter != gCaseInsensitiveIndex.end()) ? &iter->second : nullptr;
+	}
+
+	// Counts the filesystem opens the old casing-variant search ("Title-case" then "UPPERCASE", each
+	// tried against every data path before GLOBAL.BSA) would have made for this lookup.
+	void AddIndexedLookupStats(const IndexEntry &entry)
+	{
+		gIndexedLookupCount++;
+
+		std::string titleName = ToLower(entry.name);
+		titleName.front() = std::toupper(titleName.front());
+		std::string upperName = entry.name;
+		for (char &c : upperName)
+		{
+			c = std::toupper(c);
+		}
+
+		int variantIndex;
+		if (entry.name == titleName)
+		{
+			variantIndex = 0;
+		}
+		else if (entry.name == upperName)
+		{
+			variantIndex = 1;
+		}
+		else
+		{
+			return; // The old search wouldn't have found it.
+		}
+
+		const int rootPathCount = static_cast<int>(gRootPaths.size());
+		const bool isLoose = entry.rootPathIndex != GLOBAL_BSA_INDEX;
+		const int oldOpenCount = (variantIndex * rootPathCount) +
+			(isLoose ? (rootPathCount - entry.rootPathIndex) : rootPathCount);
+		const int newOpenCount = isLoose ? 1 : 0;
+		gAvoidedOpenCount += oldOpenCount - newOpenCount;
+	}
+
+	bool TryReadStream(std::istream &stream, VFS::FileView *dst)
+	{
+		stream.seekg(0, std::ios::end);
+		Buffer<std::byte> storage(static_cast<int>(stream.tellg()));
+		stream.seekg(0, std::ios::beg);
+		stream.read(reinterpret_cast<char*>(storage.get()), storage.getCount());
+		dst->init(std::move(storage));
+		AddReadStats(static_cast<size_t>(dst->getCount()), false);
+		return true;
+	}
+
+	bool TryReadLooseFile(const std::string &path, VFS::FileView *dst)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream.good())
+		{
+			return false;
+		}
+
+		return TryReadStream(stream, dst);
+	}
+
+	bool TryReadBsaEntry(const char *name, VFS::FileView *dst)
+	{
+		const std::byte *mappedData;
+		size_t mappedSize;
+		if (gGlobalBsa.tryGetMappedEntry(name, &mappedData, &mappedSize))
+		{
+			dst->init(mappedData, static_cast<int>(mappedSize));
+			AddReadStats(mappedSize, true);
+			return true;
+		}
+
+		// GLOBAL.BSA couldn't be mapped. Copy the entry through a stream instead.
+		VFS::IStreamPtr stream = gGlobalBsa.open(name);
+		if (stream == nullptr)
+		{
+			return false;
+		}
+
+		return TryReadStream(*stream, dst);
+	}
 }
 
 namespace VFS
 {
 
+FileView::FileView()
+{
+	this->data = nullptr;
+	this->count = 0;
+}
+
+void FileView::init(const std::byte *data, int count)
+{
+	DebugAssert(count >= 0);
+	this->storage.clear();
+	this->data = data;
+	this->count = count;
+}
+
+void FileView::init(Buffer<std::byte> &&storage)
+{
+	this->storage = std::move(storage);
+	this->data = this->storage.get();
+	this->count = this->storage.getCount();
+}
+
+bool FileView::isMapped() const
+{
+	return (this->data != nullptr) && (this->data != this->storage.get());
+}
+
+const std::byte *FileView::get() const
+{
+	return this->data;
+}
+
+const std::byte *FileView::end() const
+{
+	return this->data + this->count;
+}
+
+int FileView::getCount() const
+{
+	return this->count;
+}
+
 Manager::Manager()
 {
 }
@@ -42,6 +213,21 @@ void Manager::initialize(std::string&& rootPath)
 
 	gGlobalBsa.load(rootPath + "GLOBAL.BSA");
 	gRootPaths.push_back(std::move(rootPath));
+
+	const auto startTime = std::chrono::high_resolution_clock::now();
+	for (const std::string &name : gGlobalBsa.list())
+	{
+		// Loose files take precedence, so don't overwrite them.
+		gCaseInsensitiveIndex.emplace(ToLower(name), IndexEntry { GLOBAL_BSA_INDEX, name });
+	}
+
+	Manager::indexRootPath(static_cast<int>(gRootPaths.size()) - 1);
+
+	const auto endTime = std::chrono::high_resolution_clock::now();
+	const double milliseconds = static_cast<double>(
+		std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count()) / 1000.0;
+	DebugLog("Indexed " + std::to_string(gCaseInsensitiveIndex.size()) + " files for case-insensitive lookup in " +
+		String::fixedPrecision(milliseconds, 2) + "ms.");
 }
 
 void Manager::addDataPath(std::string&& path)
@@ -52,6 +238,20 @@ void Manager::addDataPath(std::string&& path)
 		path += '/';
 
 	gRootPaths.push_back(std::move(path));
+	Manager::indexRootPath(static_cast<int>(gRootPaths.size()) - 1);
+}
+
+void Manager::indexRootPath(int rootPathIndex)
+{
+	std::vector<std::string> names;
+	Manager::addDir(gRootPaths[rootPathIndex] + '.', std::string(), nullptr, names);
+
+	// Newer paths take precedence over older ones and GLOBAL.BSA.
+	for (std::string &name : names)
+	{
+		std::string key = ToLower(name);
+		gCaseInsensitiveIndex[std::move(key)] = IndexEntry { rootPathIndex, std::move(name) };
+	}
 }
 
 IStreamPtr Manager::open(const char *name, bool *inGlobalBSA)
@@ -89,33 +289,30 @@ IStreamPtr Manager::open(const char *name)
 
 IStreamPtr Manager::openCaseInsensitive(const char *name, bool *inGlobalBSA)
 {
-	// Since the given filename is assumed to be unique in its directory, we only need to
-	// worry about filenames just like it but with different casing.
-	std::string newName = name;
+	assert(name != nullptr);
+	assert(inGlobalBSA != nullptr);
 
-	// Case 1: upper first character, lower rest.
-	newName.front() = std::toupper(newName.front());
-	std::for_each(newName.begin() + 1, newName.end(),
-		[](char &c) { c = std::tolower(c); });
+	const IndexEntry *entry = FindIndexEntry(name);
+	if (entry == nullptr)
+	{
+		// Not in any data path or GLOBAL.BSA (at least when they were indexed). The caller does error
+		// checking to see if this is null.
+		return this->open(name, inGlobalBSA);
+	}
 
-	IStreamPtr stream = this->open(newName.c_str(), inGlobalBSA);
+	AddIndexedLookupStats(*entry);
 
-	if (stream != nullptr)
+	if (entry->rootPathIndex != GLOBAL_BSA_INDEX)
 	{
-		return stream;
+		*inGlobalBSA = false;
+		std::unique_ptr<std::ifstream> stream(new std::ifstream(
+			gRootPaths[entry->rootPathIndex] + entry->name, std::ios::binary));
+		return stream->good() ? IStreamPtr(std::move(stream)) : IStreamPtr(nullptr);
 	}
 	else
 	{
-		// Case 2: all uppercase.
-		for (char &c : newName)
-		{
-			c = std::toupper(c);
-		}
-
-		stream = this->open(newName.c_str(), inGlobalBSA);
-
-		// The caller does error checking to see if this is null.
-		return stream;
+		*inGlobalBSA = true;
+		return gGlobalBsa.open(entry->name.c_str());
 	}
 }
 
@@ -141,6 +338,7 @@ bool Manager::read(const char *name, Buffer<std::byte> *dst, bool *inGlobalBSA)
 	dst->init(static_cast<int>(stream->tellg()));
 	stream->seekg(0, std::ios::beg);
 	stream->read(reinterpret_cast<char*>(dst->get()), dst->getCount());
+	AddReadStats(static_cast<size_t>(dst->getCount()), false);
 	return true;
 }
 
@@ -166,6 +364,7 @@ bool Manager::readCaseInsensitive(const char *name, Buffer<std::byte> *dst, bool
 	dst->init(static_cast<int>(stream->tellg()));
 	stream->seekg(0, std::ios::beg);
 	stream->read(reinterpret_cast<char*>(dst->get()), dst->getCount());
+	AddReadStats(static_cast<size_t>(dst->getCount()), false);
 	return true;
 }
 
@@ -175,6 +374,101 @@ bool Manager::readCaseInsensitive(const char *name, Buffer<std::byte> *dst)
 	return this->readCaseInsensitive(name, dst, &dummy);
 }
 
+bool Manager::tryReadView(const char *name, FileView *dst, bool *inGlobalBSA)
+{
+	assert(name != nullptr);
+	assert(dst != nullptr);
+	assert(inGlobalBSA != nullptr);
+
+	// Loose files take precedence over GLOBAL.BSA, same as open().
+	const auto iter = std::find_if(gRootPaths.rbegin(), gRootPaths.rend(),
+		[name, dst](const std::string &rootPath)
+	{
+		return TryReadLooseFile(rootPath + name, dst);
+	});
+
+	if (iter != gRootPaths.rend())
+	{
+		*inGlobalBSA = false;
+		return true;
+	}
+
+	*inGlobalBSA = true;
+	return TryReadBsaEntry(name, dst);
+}
+
+bool Manager::readView(const char *name, FileView *dst, bool *inGlobalBSA)
+{
+	if (!this->tryReadView(name, dst, inGlobalBSA))
+	{
+		DebugLogError("Could not open \"" + std::string(name) + "\".");
+		return false;
+	}
+
+	return true;
+}
+
+bool Manager::readView(const char *name, FileView *dst)
+{
+	bool dummy;
+	return this->readView(name, dst, &dummy);
+}
+
+bool Manager::readViewCaseInsensitive(const char *name, FileView *dst, bool *inGlobalBSA)
+{
+	assert(name != nullptr);
+	assert(dst != nullptr);
+	assert(inGlobalBSA != nullptr);
+
+	const IndexEntry *entry = FindIndexEntry(name);
+	if (entry == nullptr)
+	{
+		return this->readView(name, dst, inGlobalBSA);
+	}
+
+	AddIndexedLookupStats(*entry);
+
+	bool success;
+	if (entry->rootPathIndex != GLOBAL_BSA_INDEX)
+	{
+		*inGlobalBSA = false;
+		success = TryReadLooseFile(gRootPaths[entry->rootPathIndex] + entry->name, dst);
+	}
+	else
+	{
+		*inGlobalBSA = true;
+		success = TryReadBsaEntry(entry->name.c_str(), dst);
+	}
+
+	if (!success)
+	{
+		DebugLogError("Could not open \"" + std::string(name) + "\".");
+	}
+
+	return success;
+}
+
+bool Manager::readViewCaseInsensitive(const char *name, FileView *dst)
+{
+	bool dummy;
+	return this->readViewCaseInsensitive(name, dst, &dummy);
+}
+
+void Manager::getCaseInsensitiveIndexStats(int *outEntryCount, int *outLookupCount,
+	int *outAvoidedOpenCount) const
+{
+	*outEntryCount = static_cast<int>(gCaseInsensitiveIndex.size());
+	*outLookupCount = gIndexedLookupCount;
+	*outAvoidedOpenCount = gAvoidedOpenCount;
+}
+
+void Manager::getReadStats(int *outFileCount, int *outMappedFileCount, size_t *outByteCount) const
+{
+	*outFileCount = gReadFileCount;
+	*outMappedFileCount = gReadMappedFileCount;
+	*outByteCount = gReadByteCount;
+}
+
 bool Manager::exists(const char *name)
 {
 	std::ifstream file;
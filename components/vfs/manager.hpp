@@ -15,6 +15,28 @@ namespace VFS
 
 typedef std::shared_ptr<std::istream> IStreamPtr;
 
+// Read-only bytes of a file. Points straight into the memory-mapped GLOBAL.BSA when the file is in
+// there, otherwise owns a copy of the loose file's contents. Decoders can read it like a buffer.
+class FileView
+{
+private:
+	Buffer<std::byte> storage; // Only used when the bytes can't be referenced in place.
+	const std::byte *data;
+	int count;
+public:
+	FileView();
+
+	void init(const std::byte *data, int count);
+	void init(Buffer<std::byte> &&storage);
+
+	// Whether the bytes are referenced in place rather than copied.
+	bool isMapped() const;
+
+	const std::byte *get() const;
+	const std::byte *end() const;
+	int getCount() const;
+};
+
 class Manager {
 	Manager(const Manager&) = delete;
 	Manager& operator=(const Manager&) = delete;
@@ -24,6 +46,11 @@ class Manager {
 
 	Manager();
 
+	// Adds a data path's files to the case-insensitive lookup index.
+	static void indexRootPath(int rootPathIndex);
+
+	bool tryReadView(const char *name, FileView *dst, bool *inGlobalBSA);
+
 public:
 	void initialize(std::string&& rootPath = std::string());
 	void addDataPath(std::string&& path);
@@ -32,9 +59,9 @@ public:
 	IStreamPtr open(const char *name);
 
 	// Special open method intended for Unix systems since the Arena floppy and CD versions don't
-	// have consistent casing for some files (like SPELLSG.65). This method is specific to Arena's
-	// files and is not a general solution for case-insensitive file loading.
-	// - To do: replace with something using std::filesystem::equivalent() (C++17)?
+	// have consistent casing for some files (like SPELLSG.65). Uses an index of every file in the
+	// data paths and GLOBAL.BSA made when they're added, so files added afterwards fall back to a
+	// case-sensitive open.
 	IStreamPtr openCaseInsensitive(const char *name, bool *inGlobalBSA);
 	IStreamPtr openCaseInsensitive(const char *name);
 
@@ -44,6 +71,21 @@ public:
 	bool readCaseInsensitive(const char *name, Buffer<std::byte> *dst, bool *inGlobalBSA);
 	bool readCaseInsensitive(const char *name, Buffer<std::byte> *dst);
 
+	// Zero-copy alternatives to read(). Files in GLOBAL.BSA are referenced in place, loose files are
+	// read into the view's own storage. Prefer these for decoders that only read their source bytes.
+	bool readView(const char *name, FileView *dst, bool *inGlobalBSA);
+	bool readView(const char *name, FileView *dst);
+	bool readViewCaseInsensitive(const char *name, FileView *dst, bool *inGlobalBSA);
+	bool readViewCaseInsensitive(const char *name, FileView *dst);
+
+	// Totals for file reads so far, for measuring asset loading throughput. Mapped files are ones that
+	// were read without copying.
+	void getReadStats(int *outFileCount, int *outMappedFileCount, size_t *outByteCount) const;
+
+	// Size of the case-insensitive index, how many lookups it has answered, and how many filesystem
+	// opens those lookups avoided compared to trying each casing against each data path.
+	void getCaseInsensitiveIndexStats(int *outEntryCount, int *outLookupCount, int *outAvoidedOpenCount) const;
+
 	bool exists(const char *name);
 	std::vector<std::string> list(const char *pattern = nullptr) const;
 